@@ -57,9 +57,11 @@
 #include <stl2/detail/algorithm/mismatch.hpp>
 #include <stl2/detail/algorithm/move.hpp>
 #include <stl2/detail/algorithm/move_backward.hpp>
+#include <stl2/detail/algorithm/multiway_merge.hpp>
 #include <stl2/detail/algorithm/next_permutation.hpp>
 #include <stl2/detail/algorithm/none_of.hpp>
 #include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
 #include <stl2/detail/algorithm/partial_sort.hpp>
 #include <stl2/detail/algorithm/partial_sort_copy.hpp>
 #include <stl2/detail/algorithm/partition.hpp>
@@ -68,6 +70,7 @@
 #include <stl2/detail/algorithm/pop_heap.hpp>
 #include <stl2/detail/algorithm/prev_permutation.hpp>
 #include <stl2/detail/algorithm/push_heap.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/remove.hpp>
 #include <stl2/detail/algorithm/remove_copy.hpp>
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
@@ -14,6 +14,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -32,6 +33,51 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+	requires
+		IndirectlyCopyable<I, O> &&
+		SizedSentinel<S, I> &&
+		detail::MemCopyable<I, O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy(I first, S last, O result)
+	{
+		auto n = difference_type_t<I>(last - first);
+		detail::mem::copy(first, n, result);
+		return {first + n, result + n};
+	}
+
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+	requires
+		IndirectlyCopyable<I, O> &&
+		SizedSentinel<S, I> &&
+		detail::mem::ContiguousStorage<I> &&
+		detail::StreambufOutput<O> &&
+		Same<value_type_t<I>, typename O::char_type>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy(I first, S last, O result)
+	{
+		auto n = difference_type_t<I>(last - first);
+		if (n > 0) {
+			result.__sputn(detail::addressof(*first), n);
+		}
+		return {first + n, std::move(result)};
+	}
+
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+	requires
+		IndirectlyCopyable<I, O> &&
+		detail::StreambufRange<I, S>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy(I first, S last, O result)
+	{
+		first = __istreambuf_iterator::for_each_block(std::move(first), last,
+			[&result](const auto* p, std::ptrdiff_t n) {
+				result = __stl2::copy(p, p + n, std::move(result)).out();
+				return n;
+			});
+		return {std::move(first), std::move(result)};
+	}
+
 	template <InputRange Rng, class O>
 	requires
 		WeaklyIncrementable<__f<O>> &&
@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
@@ -37,6 +38,19 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(last), std::move(out)};
 	}
 
+	template <BidirectionalIterator I1, Sentinel<I1> S1, BidirectionalIterator I2>
+	requires
+		IndirectlyCopyable<I1, I2> &&
+		detail::MemCopyable<I1, I2>
+	tagged_pair<tag::in(I1), tag::out(I2)>
+	copy_backward(I1 first, S1 sent, I2 out)
+	{
+		auto last = __stl2::next(first, std::move(sent));
+		auto n = difference_type_t<I1>(last - first);
+		detail::mem::copy_backward(last, n, out);
+		return {std::move(last), out - n};
+	}
+
 	template <BidirectionalRange Rng, class I>
 	requires
 		BidirectionalIterator<__f<I>> &&
@@ -17,6 +17,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -44,6 +45,29 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O,
+		class Pred, class Proj = identity>
+	requires
+		IndirectlyCopyable<I, O> &&
+		IndirectUnaryPredicate<
+			Pred, projected<I, Proj>> &&
+		detail::simd::CompressibleRange<I, S, Pred, Proj> &&
+		detail::simd::LaneOutput<O, I>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy_if(I first, S last, O result, Pred pred, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return {std::move(first), std::move(result)};
+		}
+		using P = detail::simd::value_predicate<Pred>;
+		auto const p = detail::addressof(*first);
+		auto const out = detail::addressof(*result);
+		auto const k = detail::simd::select<false, P::op>(p, p + n, out,
+			detail::simd::predicate_value(pred), true) - out;
+		return {first + n, result + k};
+	}
+
 	template <InputRange Rng, class O, class Pred, class Proj = identity>
 	requires
 		WeaklyIncrementable<__f<O>> &&
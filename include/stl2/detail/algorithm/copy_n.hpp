@@ -15,6 +15,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -37,6 +38,16 @@ STL2_OPEN_NAMESPACE {
 			std::move(result)
 		};
 	}
+
+	template <InputIterator I, WeaklyIncrementable O>
+	requires IndirectlyCopyable<I, O> && detail::MemCopyable<I, O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy_n(I first, difference_type_t<I> n, O result)
+	{
+		STL2_EXPECT(n >= 0);
+		detail::mem::copy(first, n, result);
+		return {first + n, result + n};
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -37,6 +38,63 @@ STL2_OPEN_NAMESPACE {
 		return n;
 	}
 
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::simd::KernelRange<I, S, Proj> &&
+		Integral<T>
+	difference_type_t<I>
+	count(I first, S last, const T& value, Proj = Proj{})
+	{
+		auto n = difference_type_t<I>(last - first);
+		value_type_t<I> v;
+		if (n == 0 || !detail::simd::to_element(value, v)) {
+			return 0;
+		}
+		auto const p = detail::addressof(*first);
+		return detail::simd::count(p, p + n, v);
+	}
+
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::StreambufRange<I, S>
+	difference_type_t<I>
+	count(I first, S last, const T& value, Proj proj = Proj{})
+	{
+		difference_type_t<I> c = 0;
+		__istreambuf_iterator::for_each_block(std::move(first), last,
+			[&](const auto* p, std::ptrdiff_t n) {
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					if (equal_to<>{}(__stl2::invoke(proj, value_type_t<I>(p[i])), value)) {
+						++c;
+					}
+				}
+				return n;
+			});
+		return c;
+	}
+
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::StreambufRange<I, S> &&
+		__bool<detail::simd::is_identity<Proj>>
+	difference_type_t<I>
+	count(I first, S last, const T& value, Proj = Proj{})
+	{
+		difference_type_t<I> c = 0;
+		__istreambuf_iterator::for_each_block(std::move(first), last,
+			[&](const auto* p, std::ptrdiff_t n) {
+				c += __stl2::count(p, p + n, value);
+				return n;
+			});
+		return c;
+	}
+
 	template <InputRange Rng, class T, class Proj = identity>
 	requires
 		IndirectRelation<
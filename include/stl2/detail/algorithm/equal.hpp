@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -36,6 +37,18 @@ STL2_OPEN_NAMESPACE {
 		return true;
 	}
 
+	template <InputIterator I1, Sentinel<I1> S1, InputIterator I2,
+		class Pred, class Proj1, class Proj2>
+	requires
+		IndirectlyComparable<I1, I2, Pred, Proj1, Proj2> &&
+		detail::simd::EqualRanges<I1, S1, I2, I2, Pred, Proj1, Proj2>
+	bool __equal_3(I1 first1, S1 last1, I2 first2, Pred&, Proj1&, Proj2&)
+	{
+		auto n = difference_type_t<I1>(last1 - first1);
+		return n == 0 || detail::simd::equal(detail::addressof(*first1),
+			detail::addressof(*first2), n);
+	}
+
 	template <InputIterator I1, Sentinel<I1> S1,
 		InputIterator I2, Sentinel<I2> S2,
 		class Pred, class Proj1, class Proj2>
@@ -26,6 +26,25 @@ STL2_OPEN_NAMESPACE {
 		}
 		return first;
 	}
+
+	template <class T, OutputIterator<const T&> O>
+	requires
+		detail::StreambufOutput<O>
+	O fill_n(O first, difference_type_t<O> n, const T& value) {
+		if (n > 0) {
+			using charT = typename O::char_type;
+			constexpr difference_type_t<O> size = 512 / sizeof(charT);
+			charT buf[size];
+			auto const m = n < size ? n : size;
+			for (difference_type_t<O> i = 0; i < m; ++i) {
+				buf[i] = value;
+			}
+			for (; n > 0; n -= m) {
+				first.__sputn(buf, n < m ? n : m);
+			}
+		}
+		return first;
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -35,6 +36,56 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::simd::KernelRange<I, S, Proj> &&
+		Integral<T>
+	I find(I first, S last, const T& value, Proj = Proj{})
+	{
+		auto n = difference_type_t<I>(last - first);
+		value_type_t<I> v;
+		if (n == 0 || !detail::simd::to_element(value, v)) {
+			return first + n;
+		}
+		auto const p = detail::addressof(*first);
+		return first + (detail::simd::find(p, p + n, v) - p);
+	}
+
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::StreambufRange<I, S>
+	I find(I first, S last, const T& value, Proj proj = Proj{})
+	{
+		return __istreambuf_iterator::for_each_block(std::move(first), last,
+			[&](const auto* p, std::ptrdiff_t n) {
+				std::ptrdiff_t i = 0;
+				for (; i < n; ++i) {
+					if (equal_to<>{}(__stl2::invoke(proj, value_type_t<I>(p[i])), value)) {
+						break;
+					}
+				}
+				return i;
+			});
+	}
+
+	template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::StreambufRange<I, S> &&
+		__bool<detail::simd::is_identity<Proj>>
+	I find(I first, S last, const T& value, Proj = Proj{})
+	{
+		return __istreambuf_iterator::for_each_block(std::move(first), last,
+			[&](const auto* p, std::ptrdiff_t n) -> std::ptrdiff_t {
+				return __stl2::find(p, p + n, value) - p;
+			});
+	}
+
 	template <InputRange Rng, class T, class Proj = identity>
 	requires
 		IndirectRelation<
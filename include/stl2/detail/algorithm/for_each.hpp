@@ -34,6 +34,24 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(fun)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, class F, class Proj = identity>
+	requires
+		IndirectUnaryInvocable<F, projected<I, Proj>> &&
+		detail::StreambufRange<I, S>
+	tagged_pair<tag::in(I), tag::fun(F)>
+	for_each(I first, S last, F fun, Proj proj = Proj{})
+	{
+		first = __istreambuf_iterator::for_each_block(std::move(first), last,
+			[&](const auto* p, std::ptrdiff_t n) {
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					static_cast<void>(__stl2::invoke(fun,
+						__stl2::invoke(proj, value_type_t<I>(p[i]))));
+				}
+				return n;
+			});
+		return {std::move(first), std::move(fun)};
+	}
+
 	template <InputRange Rng, class F, class Proj = identity>
 	requires
 		IndirectUnaryInvocable<F, projected<iterator_t<Rng>, Proj>>
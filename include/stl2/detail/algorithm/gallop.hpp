@@ -0,0 +1,92 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_GALLOP_HPP
+#define STL2_DETAIL_ALGORITHM_GALLOP_HPP
+
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/utility.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Galloping for merge, includes and the set algorithms [Extension]
+//
+// On random access inputs with sized sentinels, once one input has supplied
+// the next element threshold times in a row, the rest of its run is found
+// by exponential search and then ext::lower_bound_n / ext::upper_bound_n,
+// as in TimSort. Merging m elements into n then takes O(m log(n/m))
+// comparisons instead of O(m + n); evenly interleaved inputs never gallop.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace gallop {
+			constexpr int threshold = 7;
+
+			// Each input can be searched for the projection of an element of
+			// the other.
+			template <class I1, class S1, class I2, class S2,
+				class Comp, class Proj1, class Proj2>
+			concept bool Gallopable =
+				RandomAccessIterator<I1> && SizedSentinel<S1, I1> &&
+				RandomAccessIterator<I2> && SizedSentinel<S2, I2> &&
+				IndirectStrictWeakOrder<Comp,
+					const value_type_t<projected<I2, Proj2>>*, projected<I1, Proj1>> &&
+				IndirectStrictWeakOrder<Comp,
+					const value_type_t<projected<I1, Proj1>>*, projected<I2, Proj2>>;
+
+			// Probes first[1], first[3], first[7], ... for the first element
+			// that fails pred, and returns the half-open index interval that
+			// holds the partition point of [first, first + n).
+			template <RandomAccessIterator I, class Pred>
+			pair<difference_type_t<I>, difference_type_t<I>>
+			bracket(I first, difference_type_t<I> n, Pred pred)
+			{
+				difference_type_t<I> lo = 0, hi = 1;
+				while (hi < n && pred(first[hi])) {
+					lo = hi;
+					hi = 2 * hi + 1;
+				}
+				return {lo, __stl2::min(hi, n)};
+			}
+
+			// ext::lower_bound_n(first, n, value, comp, proj), in time
+			// logarithmic in the distance to the result.
+			template <RandomAccessIterator I, class T, class Comp, class Proj>
+			I lower_bound(I first, difference_type_t<I> n, const T& value,
+				Comp& comp, Proj& proj)
+			{
+				auto b = gallop::bracket(first, n, [&](auto&& e) {
+					return __stl2::invoke(comp, __stl2::invoke(proj, e), value);
+				});
+				return ext::lower_bound_n(first + b.first, b.second - b.first,
+					value, std::ref(comp), std::ref(proj));
+			}
+
+			// ext::upper_bound_n(first, n, value, comp, proj), in time
+			// logarithmic in the distance to the result.
+			template <RandomAccessIterator I, class T, class Comp, class Proj>
+			I upper_bound(I first, difference_type_t<I> n, const T& value,
+				Comp& comp, Proj& proj)
+			{
+				auto b = gallop::bracket(first, n, [&](auto&& e) {
+					return !__stl2::invoke(comp, value, __stl2::invoke(proj, e));
+				});
+				return ext::upper_bound_n(first + b.first, b.second - b.first,
+					value, std::ref(comp), std::ref(proj));
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
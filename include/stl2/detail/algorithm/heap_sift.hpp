@@ -22,18 +22,55 @@
 #ifndef STL2_DETAIL_ALGORITHM_HEAP_SIFT_HPP
 #define STL2_DETAIL_ALGORITHM_HEAP_SIFT_HPP
 
+#include <cstddef>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/min.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
-// detail::sift_up_n and detail::sift_down_n
+// detail::sift_up_n, detail::sift_down_n and detail::sift_hole_down_n
 // (heap implementation details)
 //
+// The heaps are D-ary: the children of the node at index i are at indices
+// D * i + 1 through D * i + D. D = 2 is the standard binary heap; wider
+// heaps are shallower and keep the siblings compared at each level in the
+// same cache line, which pays off once the heap no longer fits in cache.
+//
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		template <RandomAccessIterator I, class Comp, class Proj>
+		constexpr std::size_t sift_bottom_up_limit = std::size_t{1} << 19;
+
+		template <RandomAccessIterator I>
+		constexpr bool sift_bottom_up(difference_type_t<I> n) noexcept
+		{
+			return static_cast<std::size_t>(n) <=
+				sift_bottom_up_limit / sizeof(value_type_t<I>);
+		}
+
+		// Iterator to the largest of the count >= 1 siblings starting at child.
+		template <int D, RandomAccessIterator I, class Comp, class Proj>
+		requires
+			IndirectStrictWeakOrder<Comp,
+				projected<I, Proj>, projected<I, Proj>>
+		I heap_max_child(I child, difference_type_t<I> count, Comp& comp, Proj& proj)
+		{
+			I best = child;
+			if (D == 2) {
+				if (count > 1 && __stl2::invoke(comp, __stl2::invoke(proj, *child), __stl2::invoke(proj, *(child + 1)))) {
+					++best;
+				}
+				return best;
+			}
+			for (difference_type_t<I> k = 1; k < count; ++k) {
+				best = __stl2::invoke(comp, __stl2::invoke(proj, *best),
+					__stl2::invoke(proj, *(child + k))) ? child + k : best;
+			}
+			return best;
+		}
+
+		template <int D = 2, RandomAccessIterator I, class Comp, class Proj>
 		requires
 			IndirectStrictWeakOrder<Comp,
 				projected<I, Proj>, projected<I, Proj>>
@@ -41,7 +78,7 @@ STL2_OPEN_NAMESPACE {
 		{
 			if (n > 1) {
 				I last = first + n;
-				n = (n - 2) / 2;
+				n = (n - 2) / D;
 				I i = first + n;
 				if (__stl2::invoke(comp, __stl2::invoke(proj, *i), __stl2::invoke(proj, *--last))) {
 					value_type_t<I> v = __stl2::iter_move(last);
@@ -51,7 +88,7 @@ STL2_OPEN_NAMESPACE {
 						if (n == 0) {
 							break;
 						}
-						n = (n - 1) / 2;
+						n = (n - 1) / D;
 						i = first + n;
 					} while(__stl2::invoke(comp, __stl2::invoke(proj, *i), __stl2::invoke(proj, v)));
 					*last = std::move(v);
@@ -59,29 +96,23 @@ STL2_OPEN_NAMESPACE {
 			}
 		}
 
-		template <RandomAccessIterator I, class Comp, class Proj>
+		template <int D = 2, RandomAccessIterator I, class Comp, class Proj>
 		requires
 			IndirectStrictWeakOrder<Comp,
 				projected<I, Proj>, projected<I, Proj>>
 		void sift_down_n(I first, difference_type_t<I> n, I start,
 			Comp comp, Proj proj)
 		{
-			// left-child of start is at 2 * start + 1
-			// right-child of start is at 2 * start + 2
+			// the children of start are at D * start + 1 through D * start + D
 			auto child = start - first;
 
-			if (n < 2 || (n - 2) / 2 < child) {
+			if (n < 2 || (n - 2) / D < child) {
 				return;
 			}
 
-			child = 2 * child + 1;
-			I child_i = first + child;
-
-			if ((child + 1) < n && __stl2::invoke(comp, __stl2::invoke(proj, *child_i), __stl2::invoke(proj, *(child_i + 1)))) {
-				// right-child exists and is greater than left-child
-				++child_i;
-				++child;
-			}
+			child = D * child + 1;
+			I child_i = detail::heap_max_child<D>(first + child,
+				__stl2::min(difference_type_t<I>(D), n - child), comp, proj);
 
 			// check if we are in heap-order
 			if (__stl2::invoke(comp, __stl2::invoke(proj, *child_i), __stl2::invoke(proj, *start))) {
@@ -94,25 +125,62 @@ STL2_OPEN_NAMESPACE {
 				// we are not in heap-order, swap the parent with it's largest child
 				*start = __stl2::iter_move(child_i);
 				start = child_i;
+				child = child_i - first;
 
-				if ((n - 2) / 2 < child) {
+				if ((n - 2) / D < child) {
 					break;
 				}
 
 				// recompute the child based off of the updated parent
-				child = 2 * child + 1;
-				child_i = first + child;
-
-				if ((child + 1) < n && __stl2::invoke(comp, __stl2::invoke(proj, *child_i), __stl2::invoke(proj, *(child_i + 1)))) {
-					// right-child exists and is greater than left-child
-					++child_i;
-					++child;
-				}
+				child = D * child + 1;
+				child_i = detail::heap_max_child<D>(first + child,
+					__stl2::min(difference_type_t<I>(D), n - child), comp, proj);
 
 				// check if we are in heap-order
 			} while (!__stl2::invoke(comp, __stl2::invoke(proj, *child_i), __stl2::invoke(proj, top)));
 			*start = std::move(top);
 		}
+
+		// Fills the vacated root of the heap [first, first + n) with v.
+		// Rather than sifting v down, which costs D comparisons per level,
+		// the hole is moved down the path of largest children to a leaf in
+		// D - 1 comparisons per level and v is then sifted up from there
+		// (Floyd's bottom-up heapsort). v usually comes from the bottom of
+		// the heap, so it rarely rises more than a level or two.
+		//
+		// The hole always reaches the bottom level, which a top-down sift
+		// usually stops short of. Once the heap outgrows the cache those
+		// extra misses cost more than the comparisons saved, so callers
+		// sift top-down when !sift_bottom_up<I>(n).
+		template <int D = 2, RandomAccessIterator I, class Comp, class Proj>
+		requires
+			IndirectStrictWeakOrder<Comp,
+				projected<I, Proj>, projected<I, Proj>>
+		void sift_hole_down_n(I first, difference_type_t<I> n, value_type_t<I>&& v,
+			Comp comp, Proj proj)
+		{
+			difference_type_t<I> hole = 0;
+			if (n > 1) {
+				auto const last_parent = (n - 2) / D;
+				do {
+					auto const child = D * hole + 1;
+					I child_i = detail::heap_max_child<D>(first + child,
+						__stl2::min(difference_type_t<I>(D), n - child), comp, proj);
+					*(first + hole) = __stl2::iter_move(child_i);
+					hole = child_i - first;
+				} while (hole <= last_parent);
+
+				while (hole > 0) {
+					auto const parent = (hole - 1) / D;
+					if (!__stl2::invoke(comp, __stl2::invoke(proj, *(first + parent)), __stl2::invoke(proj, v))) {
+						break;
+					}
+					*(first + hole) = __stl2::iter_move(first + parent);
+					hole = parent;
+				}
+			}
+			*(first + hole) = std::move(v);
+		}
 	}
 } STL2_CLOSE_NAMESPACE
 
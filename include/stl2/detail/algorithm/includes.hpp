@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -47,6 +48,45 @@ STL2_OPEN_NAMESPACE {
 		}
 	}
 
+	// Extension: gallops on random access inputs with sized sentinels.
+	template <InputIterator I1, Sentinel<I1> S1,
+		InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		IndirectStrictWeakOrder<
+			Comp, projected<I1, Proj1>, projected<I2, Proj2>> &&
+		detail::gallop::Gallopable<I1, S1, I2, S2, Comp, Proj1, Proj2>
+	bool includes(I1 first1, S1 last1_, I2 first2, S2 last2_, Comp comp = Comp{},
+		Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+	{
+		auto const last1 = __stl2::next(first1, std::move(last1_));
+		auto const last2 = __stl2::next(first2, std::move(last2_));
+		int run1 = 0;
+		while (first2 != last2) {
+			if (first1 == last1) {
+				return false;
+			}
+			auto&& p1 = __stl2::invoke(proj1, *first1);
+			auto&& p2 = __stl2::invoke(proj2, *first2);
+			if (__stl2::invoke(comp, p2, p1)) {
+				return false;
+			}
+			if (__stl2::invoke(comp, p1, p2)) {
+				if (++run1 < detail::gallop::threshold) {
+					++first1;
+				} else {
+					run1 = 0;
+					first1 = detail::gallop::lower_bound(first1, last1 - first1, p2, comp, proj1);
+				}
+			} else {
+				run1 = 0;
+				++first1;
+				++first2;
+			}
+		}
+		return true;
+	}
+
 	template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
 		class Proj1 = identity, class Proj2 = identity>
 	requires
@@ -52,6 +52,34 @@ STL2_OPEN_NAMESPACE {
 		return __stl2::end(rng) ==
 			__stl2::is_heap_until(rng, std::ref(comp), std::ref(proj));
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// is_heap<D> [Extension]
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I, Proj>>
+		bool is_heap(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return last == ext::is_heap_until<D>(std::move(first), last,
+				std::ref(comp), std::ref(proj));
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			IndirectStrictWeakOrder<
+				Comp, projected<iterator_t<Rng>, Proj>>
+		bool is_heap(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return __stl2::end(rng) ==
+				ext::is_heap_until<D>(rng, std::ref(comp), std::ref(proj));
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
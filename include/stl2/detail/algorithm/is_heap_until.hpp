@@ -32,7 +32,7 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		template <RandomAccessIterator I, class Comp = less<>, class Proj = identity>
+		template <int D = 2, RandomAccessIterator I, class Comp = less<>, class Proj = identity>
 		requires
 			IndirectStrictWeakOrder<
 				Comp, projected<I, Proj>>
@@ -40,21 +40,15 @@ STL2_OPEN_NAMESPACE {
 			Comp comp = Comp{}, Proj proj = Proj{})
 		{
 			STL2_EXPECT(0 <= n);
-			difference_type_t<I> p = 0, c = 1;
-			I pp = first;
-			while (c < n) {
+			// The children of *pp are [first + c, first + c + D).
+			difference_type_t<I> c = 1;
+			for (I pp = first; c < n; ++pp) {
 				I cp = first + c;
-				if (__stl2::invoke(comp, __stl2::invoke(proj, *pp), __stl2::invoke(proj, *cp))) {
-					return cp;
+				for (auto const end = n - c < D ? n : c + D; c < end; ++c, ++cp) {
+					if (__stl2::invoke(comp, __stl2::invoke(proj, *pp), __stl2::invoke(proj, *cp))) {
+						return cp;
+					}
 				}
-				++c;
-				++cp;
-				if (c == n || __stl2::invoke(comp, __stl2::invoke(proj, *pp), __stl2::invoke(proj, *cp))) {
-					return cp;
-				}
-				++p;
-				++pp;
-				c = 2 * p + 1;
 			}
 			return first + n;
 		}
@@ -82,6 +76,36 @@ STL2_OPEN_NAMESPACE {
 		return detail::is_heap_until_n(__stl2::begin(rng), __stl2::distance(rng),
 			std::ref(comp), std::ref(proj));
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// is_heap_until<D> [Extension]
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I, Proj>>
+		I is_heap_until(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(first, std::move(last));
+			return detail::is_heap_until_n<D>(std::move(first), n,
+				std::ref(comp), std::ref(proj));
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			IndirectStrictWeakOrder<
+				Comp, projected<iterator_t<Rng>, Proj>>
+		safe_iterator_t<Rng>
+		is_heap_until(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return detail::is_heap_until_n<D>(__stl2::begin(rng), __stl2::distance(rng),
+				std::ref(comp), std::ref(proj));
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
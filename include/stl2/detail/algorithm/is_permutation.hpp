@@ -13,57 +13,243 @@
 #ifndef STL2_DETAIL_ALGORITHM_IS_PERMUTATION_HPP
 #define STL2_DETAIL_ALGORITHM_IS_PERMUTATION_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/hash.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // is_permutation [alg.is_permutation]
 //
+// Once the common prefix is skipped, the remaining elements are counted in
+// O(N^2) comparisons - unless the predicate is equal_to<> and both sides
+// project to the same value type. Hashable values are then counted in an
+// open-addressing table in O(N), and other StrictTotallyOrdered values are
+// copied, sorted and compared in O(N log N). Both draw on the scratch
+// resource and fall back to counting if it comes up short.
+//
 STL2_OPEN_NAMESPACE {
-	template <ForwardIterator I1, Sentinel<I1> S1,
-		ForwardIterator I2, Sentinel<I2> S2,
-		class Pred, class Proj1, class Proj2>
-	requires
-		IndirectlyComparable<I1, I2, __f<Pred&>, __f<Proj1&>, __f<Proj2&>>
-	bool __is_permutation_tail(I1 first1, S1 last1, I2 first2, S2 last2,
-		Pred& pred, Proj1& proj1, Proj2& proj2)
-	{
-		// For each element in [f1, l1), see if there are the same number of
-		// equal elements in [f2, l2)
-		for (I1 i = first1; i != last1; ++i) {
-			// Have we already counted the number of *i in [f1, l1)?
-			for (I1 j = first1; j != i; ++j) {
-				if (__stl2::invoke(pred, __stl2::invoke(proj1, *j), __stl2::invoke(proj1, *i))) {
-						goto next_iter;
-				}
+	namespace detail {
+		namespace permutation {
+			template <class I1, class I2, class Pred, class Proj1, class Proj2>
+			concept bool EqualTo =
+				__bool<simd::is_equal_to<Pred>> &&
+				Same<value_type_t<projected<I1, Proj1>>,
+					value_type_t<projected<I2, Proj2>>>;
+
+			template <class I1, class I2, class Pred, class Proj1, class Proj2>
+			concept bool Hashed =
+				EqualTo<I1, I2, Pred, Proj1, Proj2> &&
+				ext::Hashable<value_type_t<projected<I1, Proj1>>>;
+
+			template <class I1, class I2, class Pred, class Proj1, class Proj2,
+				class T = value_type_t<projected<I1, Proj1>>>
+			concept bool Ordered =
+				EqualTo<I1, I2, Pred, Proj1, Proj2> &&
+				StrictTotallyOrdered<T> &&
+				Constructible<T, reference_t<projected<I1, Proj1>>> &&
+				Constructible<T, reference_t<projected<I2, Proj2>>> &&
+				Sortable<T*>;
+
+			// Fibonacci hashing: std::hash is the identity on integers, so
+			// take the table index from the high bits of the product.
+			inline std::ptrdiff_t slot(std::size_t hash, int shift) noexcept {
+				return static_cast<std::ptrdiff_t>(
+					(static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> shift);
 			}
+
+			// O(N^2) comparisons, with any predicate.
+			template <ForwardIterator I1, Sentinel<I1> S1,
+				ForwardIterator I2, Sentinel<I2> S2,
+				class Pred, class Proj1, class Proj2>
+			bool count_each(I1 first1, S1 last1, I2 first2, S2 last2,
+				Pred& pred, Proj1& proj1, Proj2& proj2)
 			{
-				// Count number of *i in [f2, l2)
-				difference_type_t<I2> c2 = 0;
-				for (I2 j = first2; j != last2; ++j) {
-					if (__stl2::invoke(pred, __stl2::invoke(proj1, *i), __stl2::invoke(proj2, *j))) {
-						++c2;
+				// For each element in [f1, l1), see if there are the same number of
+				// equal elements in [f2, l2)
+				for (I1 i = first1; i != last1; ++i) {
+					// Have we already counted the number of *i in [f1, l1)?
+					for (I1 j = first1; j != i; ++j) {
+						if (__stl2::invoke(pred, __stl2::invoke(proj1, *j), __stl2::invoke(proj1, *i))) {
+								goto next_iter;
+						}
 					}
+					{
+						// Count number of *i in [f2, l2)
+						difference_type_t<I2> c2 = 0;
+						for (I2 j = first2; j != last2; ++j) {
+							if (__stl2::invoke(pred, __stl2::invoke(proj1, *i), __stl2::invoke(proj2, *j))) {
+								++c2;
+							}
+						}
+						if (c2 == 0) {
+							return false;
+						}
+						// Count number of *i in [i, l1) (we can start with 1)
+						difference_type_t<I1> c1 = 1;
+						for (I1 j = __stl2::next(i); j != last1; ++j) {
+							if (__stl2::invoke(pred, __stl2::invoke(proj1, *i), __stl2::invoke(proj1, *j))) {
+								++c1;
+							}
+						}
+						if (c1 != c2) {
+							return false;
+						}
+					}
+				next_iter:;
+				}
+				return true;
+			}
+
+			// [first1, last1) and [first2, last2) have the same, nonzero, length.
+			template <ForwardIterator I1, Sentinel<I1> S1,
+				ForwardIterator I2, Sentinel<I2> S2,
+				class Pred, class Proj1, class Proj2>
+			bool count_hashed(I1 first1, S1 last1, I2 first2, S2 last2,
+				Pred& pred, Proj1& proj1, Proj2& proj2)
+			{
+				using T = value_type_t<projected<I1, Proj1>>;
+				struct entry {
+					I1 pos;
+					std::size_t hash;
+					difference_type_t<I1> count;
+				};
+
+				auto const n = __stl2::distance(first1, last1);
+				// At most half full, with one index per slot and one entry per
+				// distinct element.
+				std::ptrdiff_t size = 2;
+				int shift = 63;
+				while (size < 2 * n) {
+					size *= 2;
+					--shift;
 				}
-				if (c2 == 0) {
-					return false;
+				auto table_buf = temporary_buffer<std::ptrdiff_t>{size};
+				auto entry_buf = temporary_buffer<entry>{n};
+				if (table_buf.size() < size || entry_buf.size() < n) {
+					return permutation::count_each(std::move(first1), std::move(last1),
+						std::move(first2), std::move(last2), pred, proj1, proj2);
+				}
+				auto const table = table_buf.data();
+				for (std::ptrdiff_t i = 0; i < size; ++i) {
+					table[i] = -1;
+				}
+				auto entries = make_temporary_vector(entry_buf);
+
+				// The slot that holds value's entry, or the empty slot where it
+				// belongs.
+				auto find = [&](auto&& value, std::size_t hash) -> std::ptrdiff_t& {
+					auto i = permutation::slot(hash, shift);
+					while (table[i] >= 0) {
+						auto& e = entries[table[i]];
+						if (e.hash == hash &&
+							__stl2::invoke(pred, __stl2::invoke(proj1, *e.pos), value)) {
+							break;
+						}
+						i = (i + 1) & (size - 1);
+					}
+					return table[i];
+				};
+
+				std::hash<T> hasher;
+				for (; first1 != last1; ++first1) {
+					auto&& value = __stl2::invoke(proj1, *first1);
+					auto const hash = hasher(value);
+					auto& index = find(value, hash);
+					if (index < 0) {
+						index = entries.size();
+						entries.emplace_back(entry{first1, hash, 1});
+					} else {
+						++entries[index].count;
+					}
 				}
-				// Count number of *i in [i, l1) (we can start with 1)
-				difference_type_t<I1> c1 = 1;
-				for (I1 j = __stl2::next(i); j != last1; ++j) {
-					if (__stl2::invoke(pred, __stl2::invoke(proj1, *i), __stl2::invoke(proj1, *j))) {
-						++c1;
+				for (; first2 != last2; ++first2) {
+					auto&& value = __stl2::invoke(proj2, *first2);
+					auto const index = find(value, hasher(value));
+					if (index < 0 || --entries[index].count < 0) {
+						return false;
 					}
 				}
-				if (c1 != c2) {
-					return false;
+				// Equal lengths and no count went negative: all are zero.
+				return true;
+			}
+
+			// [first1, last1) and [first2, last2) have the same, nonzero, length.
+			template <ForwardIterator I1, Sentinel<I1> S1,
+				ForwardIterator I2, Sentinel<I2> S2,
+				class Pred, class Proj1, class Proj2>
+			bool count_sorted(I1 first1, S1 last1, I2 first2, S2 last2,
+				Pred& pred, Proj1& proj1, Proj2& proj2)
+			{
+				using T = value_type_t<projected<I1, Proj1>>;
+				auto const n = __stl2::distance(first1, last1);
+				auto buf1 = temporary_buffer<T>{n};
+				auto buf2 = temporary_buffer<T>{n};
+				if (buf1.size() < n || buf2.size() < n) {
+					return permutation::count_each(std::move(first1), std::move(last1),
+						std::move(first2), std::move(last2), pred, proj1, proj2);
+				}
+				auto values1 = make_temporary_vector(buf1);
+				auto values2 = make_temporary_vector(buf2);
+				for (; first1 != last1; ++first1) {
+					values1.emplace_back(__stl2::invoke(proj1, *first1));
 				}
+				for (; first2 != last2; ++first2) {
+					values2.emplace_back(__stl2::invoke(proj2, *first2));
+				}
+				__stl2::sort(values1.begin(), values1.end());
+				__stl2::sort(values2.begin(), values2.end());
+				return __stl2::equal(values1.begin(), values1.end(),
+					values2.begin(), values2.end());
 			}
-		next_iter:;
 		}
-		return true;
+	}
+
+	template <ForwardIterator I1, Sentinel<I1> S1,
+		ForwardIterator I2, Sentinel<I2> S2,
+		class Pred, class Proj1, class Proj2>
+	requires
+		IndirectlyComparable<I1, I2, __f<Pred&>, __f<Proj1&>, __f<Proj2&>>
+	bool __is_permutation_tail(I1 first1, S1 last1, I2 first2, S2 last2,
+		Pred& pred, Proj1& proj1, Proj2& proj2)
+	{
+		return detail::permutation::count_each(std::move(first1), std::move(last1),
+			std::move(first2), std::move(last2), pred, proj1, proj2);
+	}
+
+	template <ForwardIterator I1, Sentinel<I1> S1,
+		ForwardIterator I2, Sentinel<I2> S2,
+		class Pred, class Proj1, class Proj2>
+	requires
+		IndirectlyComparable<I1, I2, __f<Pred&>, __f<Proj1&>, __f<Proj2&>> &&
+		detail::permutation::Hashed<I1, I2, Pred, Proj1, Proj2>
+	bool __is_permutation_tail(I1 first1, S1 last1, I2 first2, S2 last2,
+		Pred& pred, Proj1& proj1, Proj2& proj2)
+	{
+		return detail::permutation::count_hashed(std::move(first1), std::move(last1),
+			std::move(first2), std::move(last2), pred, proj1, proj2);
+	}
+
+	template <ForwardIterator I1, Sentinel<I1> S1,
+		ForwardIterator I2, Sentinel<I2> S2,
+		class Pred, class Proj1, class Proj2>
+	requires
+		IndirectlyComparable<I1, I2, __f<Pred&>, __f<Proj1&>, __f<Proj2&>> &&
+		detail::permutation::Ordered<I1, I2, Pred, Proj1, Proj2> &&
+		!models::Hashable<value_type_t<projected<I1, Proj1>>>
+	bool __is_permutation_tail(I1 first1, S1 last1, I2 first2, S2 last2,
+		Pred& pred, Proj1& proj1, Proj2& proj2)
+	{
+		return detail::permutation::count_sorted(std::move(first1), std::move(last1),
+			std::move(first2), std::move(last2), pred, proj1, proj2);
 	}
 
 	template <ForwardIterator I1, Sentinel<I1> S1, class I2,
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -40,6 +41,24 @@ STL2_OPEN_NAMESPACE {
 		return first1 == last1 && first2 != last2;
 	}
 
+	template <InputIterator I1, Sentinel<I1> S1, InputIterator I2, Sentinel<I2> S2,
+		class Comp = less<>, class Proj1 = identity, class Proj2 = identity>
+	requires
+		IndirectStrictWeakOrder<Comp,
+			projected<I1, Proj1>, projected<I2, Proj2>> &&
+		detail::simd::OrderedRanges<I1, S1, I2, S2, Comp, Proj1, Proj2>
+	bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+		Comp = Comp{}, Proj1 = Proj1{}, Proj2 = Proj2{})
+	{
+		auto const n1 = difference_type_t<I1>(last1 - first1);
+		auto const n2 = difference_type_t<I2>(last2 - first2);
+		if (n1 == 0 || n2 == 0) {
+			return n1 < n2;
+		}
+		return detail::simd::lexicographical_less(detail::addressof(*first1), n1,
+			detail::addressof(*first2), n2);
+	}
+
 	template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
 		class Proj1 = identity, class Proj2 = identity>
 	requires
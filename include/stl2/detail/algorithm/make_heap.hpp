@@ -33,15 +33,15 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		template <RandomAccessIterator I, class Comp, class Proj>
+		template <int D = 2, RandomAccessIterator I, class Comp, class Proj>
 		requires
 			Sortable<I, Comp, Proj>
 		void make_heap_n(I first, difference_type_t<I> n, Comp comp, Proj proj)
 		{
 			if (n > 1) {
 				// start from the first parent, there is no need to consider children
-				for (auto start = (n - 2) / 2; start >= 0; --start) {
-					detail::sift_down_n(first, n, first + start,
+				for (auto start = (n - 2) / D; start >= 0; --start) {
+					detail::sift_down_n<D>(first, n, first + start,
 						std::ref(comp), std::ref(proj));
 				}
 			}
@@ -69,6 +69,39 @@ STL2_OPEN_NAMESPACE {
 		detail::make_heap_n(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
 		return __stl2::begin(rng) + n;
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// make_heap<D> [Extension]
+		//
+		// make_heap for a D-ary heap; see detail::sift_down_n. The heaps of
+		// ext::push_heap<D>, pop_heap<D>, sort_heap<D> and is_heap<D> have the
+		// same layout.
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<I, Comp, Proj>
+		I make_heap(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(first, std::move(last));
+			detail::make_heap_n<D>(first, n, std::ref(comp), std::ref(proj));
+			return first + n;
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		make_heap(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(rng);
+			detail::make_heap_n<D>(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
+			return __stl2::begin(rng) + n;
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd_minmax.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -37,6 +38,21 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <ForwardIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
+	requires
+		IndirectStrictWeakOrder<
+			Comp, projected<I, Proj>> &&
+		detail::simd::ReducibleRange<I, S, Comp, Proj>
+	I max_element(I first, S last, Comp = Comp{}, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return first;
+		}
+		auto const p = detail::addressof(*first);
+		return first + detail::simd::extremes<false, true>(p, n).second;
+	}
+
 	template <ForwardRange Rng, class Comp = less<>, class Proj = identity>
 	requires
 		IndirectStrictWeakOrder<
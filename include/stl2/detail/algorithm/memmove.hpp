@@ -0,0 +1,195 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_MEMMOVE_HPP
+#define STL2_DETAIL_ALGORITHM_MEMMOVE_HPP
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
+#include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/memory/addressof.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// memmove lowering for copy and move [Extension]
+//
+// copy, move and friends assign through std::memmove when both sides are
+// contiguous storage of the same trivially copyable type, and assigning
+// an element is trivial. move_iterator and counted_iterator are looked
+// through. The uninitialized algorithms likewise construct with memmove,
+// and fill with memset, when constructing an element is trivial.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace mem {
+			template <class I>
+			constexpr I base(const I& i) {
+				return i;
+			}
+			template <class I>
+			constexpr auto base(const move_iterator<I>& i) {
+				return mem::base(i.base());
+			}
+			template <class I>
+			constexpr auto base(const counted_iterator<I>& i) {
+				return mem::base(i.base());
+			}
+
+			template <class I>
+			using base_t = decltype(mem::base(std::declval<const I&>()));
+
+			// Standard library iterators that denote contiguous storage, but
+			// don't say so: those of vector and basic_string, recognized by
+			// their own types, since naming vector<V>::iterator would
+			// instantiate vector<V> for any V.
+			template <class>
+			constexpr bool is_std_contiguous = false;
+#if defined(__GLIBCXX__)
+			template <class P, class T, class A>
+			constexpr bool is_std_contiguous<
+				__gnu_cxx::__normal_iterator<P, std::vector<T, A>>> = true;
+			template <class P, class C, class T, class A>
+			constexpr bool is_std_contiguous<
+				__gnu_cxx::__normal_iterator<P, std::basic_string<C, T, A>>> = true;
+#elif defined(_LIBCPP_VERSION)
+			template <class P>
+			constexpr bool is_std_contiguous<std::__wrap_iter<P>> = true;
+#endif
+
+			template <class I>
+			concept bool StdContiguousIterator = __bool<is_std_contiguous<I>>;
+
+			// [i, i + n) is contiguous storage of value_type_t<I>.
+			template <class I>
+			concept bool ContiguousStorage =
+				RandomAccessIterator<I> &&
+				(Same<reference_t<I>, value_type_t<I>&> ||
+					Same<reference_t<I>, const value_type_t<I>&>) &&
+				(ext::ContiguousIterator<I> || StdContiguousIterator<I>);
+
+			template <class I>
+			concept bool MemoryIterator =
+				ContiguousStorage<I> &&
+				_Is<value_type_t<I>, std::is_trivially_copyable>;
+
+			// Assigning R to *o for o in [out, out + n) can be done with
+			// memmove from the storage of [in, in + n).
+			template <class In, class Out, class R>
+			concept bool Memmovable =
+				MemoryIterator<base_t<In>> &&
+				MemoryIterator<base_t<Out>> &&
+				Same<value_type_t<base_t<In>>, value_type_t<base_t<Out>>> &&
+				Same<reference_t<base_t<Out>>, value_type_t<base_t<Out>>&> &&
+				_Is<value_type_t<base_t<Out>>&, std::is_trivially_assignable, R>;
+
+			// Constructing *o from R for o in [out, out + n) can be done
+			// with memmove from the storage of [in, in + n).
+			template <class In, class Out, class R>
+			concept bool MemConstructible =
+				MemoryIterator<base_t<In>> &&
+				MemoryIterator<base_t<Out>> &&
+				Same<value_type_t<base_t<In>>, value_type_t<base_t<Out>>> &&
+				_Is<value_type_t<base_t<Out>>, std::is_trivially_constructible, R>;
+
+			// Constructing *o from a const T& for o in [out, out + n) is a
+			// copy of the bytes of the T, which can be done with memset when
+			// they are all the same.
+			template <class Out, class T>
+			concept bool MemFillable =
+				MemoryIterator<base_t<Out>> &&
+				Same<value_type_t<base_t<Out>>, T> &&
+				_Is<T, std::is_trivially_constructible, const T&>;
+
+			template <class T>
+			void* storage(T* p) noexcept
+			{
+				return const_cast<void*>(static_cast<const volatile void*>(p));
+			}
+
+			// Copies [first, first + n) to [result, result + n).
+			template <class I, class O>
+			void copy(const I& first, difference_type_t<I> n, const O& result) noexcept
+			{
+				if (n > 0) {
+					std::memmove(detail::addressof(*mem::base(result)),
+						detail::addressof(*mem::base(first)),
+						static_cast<std::size_t>(n) * sizeof(value_type_t<base_t<I>>));
+				}
+			}
+
+			// Constructs the objects of the uninitialized, possibly const,
+			// [result, result + n) from the bytes of [first, first + n).
+			template <class I, class O>
+			void construct(const I& first, difference_type_t<I> n, const O& result) noexcept
+			{
+				if (n > 0) {
+					std::memmove(mem::storage(detail::addressof(*mem::base(result))),
+						detail::addressof(*mem::base(first)),
+						static_cast<std::size_t>(n) * sizeof(value_type_t<base_t<I>>));
+				}
+			}
+
+			// Constructs the objects of the uninitialized, possibly const,
+			// [first, first + n) as copies of x.
+			template <class O, class T>
+			void fill(const O& first, difference_type_t<O> n, const T& x) noexcept
+			{
+				if (n <= 0) {
+					return;
+				}
+				auto const p = static_cast<unsigned char*>(
+					mem::storage(detail::addressof(*mem::base(first))));
+				unsigned char bytes[sizeof(T)];
+				std::memcpy(bytes, detail::addressof(x), sizeof(T));
+				std::size_t i = 1;
+				for (; i < sizeof(T) && bytes[i] == bytes[0]; ++i) {}
+				if (i == sizeof(T)) {
+					std::memset(p, bytes[0], static_cast<std::size_t>(n) * sizeof(T));
+					return;
+				}
+				for (difference_type_t<O> j = 0; j < n; ++j) {
+					std::memcpy(p + j * sizeof(T), bytes, sizeof(T));
+				}
+			}
+
+			// Copies [last - n, last) to [result - n, result).
+			template <class I, class O>
+			void copy_backward(const I& last, difference_type_t<I> n, const O& result) noexcept
+			{
+				if (n > 0) {
+					mem::copy(mem::base(last) - n, n, mem::base(result) - n);
+				}
+			}
+		}
+
+		template <class I, class O>
+		concept bool MemCopyable =
+			mem::Memmovable<I, O, reference_t<I>>;
+
+		template <class I, class O>
+		concept bool MemMovable =
+			mem::Memmovable<I, O, rvalue_reference_t<I>>;
+
+		template <class I, class O>
+		concept bool MemCopyConstructible =
+			mem::MemConstructible<I, O, reference_t<I>>;
+
+		template <class I, class O>
+		concept bool MemMoveConstructible =
+			mem::MemConstructible<I, O, rvalue_reference_t<I>>;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -15,7 +15,9 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/tuple.hpp>
+#include <stl2/utility.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
@@ -47,18 +49,68 @@ STL2_OPEN_NAMESPACE {
 			}
 			reference_t<I1>&& v1 = *first1;
 			reference_t<I2>&& v2 = *first2;
-			if (__stl2::invoke(comp, __stl2::invoke(proj1, v1), __stl2::invoke(proj2, v2))) {
-				*result = std::forward<reference_t<I1>>(v1);
-				++first1;
-			} else {
+			if (__stl2::invoke(comp, __stl2::invoke(proj2, v2), __stl2::invoke(proj1, v1))) {
 				*result = std::forward<reference_t<I2>>(v2);
 				++first2;
+			} else {
+				*result = std::forward<reference_t<I1>>(v1);
+				++first1;
 			}
 			++result;
 		}
 		return {std::move(first1), std::move(first2), std::move(result)};
 	}
 
+	// Extension: gallops on random access inputs with sized sentinels.
+	template <InputIterator I1, Sentinel<I1> S1,
+		InputIterator I2, Sentinel<I2> S2,
+		class O, class Comp = less<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		Mergeable<I1, I2, O, Comp, Proj1, Proj2> &&
+		detail::gallop::Gallopable<I1, S1, I2, S2, Comp, Proj1, Proj2>
+	tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+	merge(I1 first1, S1 last1_, I2 first2, S2 last2_, O result,
+				Comp comp = Comp{}, Proj1 proj1 = Proj1{},
+				Proj2 proj2 = Proj2{})
+	{
+		auto const last1 = __stl2::next(first1, std::move(last1_));
+		auto const last2 = __stl2::next(first2, std::move(last2_));
+		int run1 = 0, run2 = 0;
+		while (first1 != last1 && first2 != last2) {
+			reference_t<I1>&& v1 = *first1;
+			reference_t<I2>&& v2 = *first2;
+			auto&& p1 = __stl2::invoke(proj1, v1);
+			auto&& p2 = __stl2::invoke(proj2, v2);
+			if (__stl2::invoke(comp, p2, p1)) {
+				run1 = 0;
+				if (++run2 < detail::gallop::threshold) {
+					*result = std::forward<reference_t<I2>>(v2);
+					++result;
+					++first2;
+				} else {
+					run2 = 0;
+					auto run_end = detail::gallop::lower_bound(first2, last2 - first2, p1, comp, proj2);
+					std::tie(first2, result) = __stl2::copy(first2, run_end, std::move(result));
+				}
+			} else {
+				run2 = 0;
+				if (++run1 < detail::gallop::threshold) {
+					*result = std::forward<reference_t<I1>>(v1);
+					++result;
+					++first1;
+				} else {
+					run1 = 0;
+					auto run_end = detail::gallop::upper_bound(first1, last1 - first1, p2, comp, proj1);
+					std::tie(first1, result) = __stl2::copy(first1, run_end, std::move(result));
+				}
+			}
+		}
+		std::tie(first1, result) = __stl2::copy(first1, last1, std::move(result));
+		std::tie(first2, result) = __stl2::copy(first2, last2, std::move(result));
+		return {std::move(first1), std::move(first2), std::move(result)};
+	}
+
 	template <InputRange Rng1, InputRange Rng2, class O, class Comp = less<>,
 		class Proj1 = identity, class Proj2 = identity>
 	requires
@@ -76,6 +128,67 @@ STL2_OPEN_NAMESPACE {
 			std::forward<O>(result), std::ref(comp),
 			std::ref(proj1), std::ref(proj2));
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// merge_path [Extension]
+		//
+		// Where merge(first1, last1, first2, last2, ...) is after writing d
+		// elements: the {i1, i2} with (i1 - first1) + (i2 - first2) == d such
+		// that merging [first1, i1) with [first2, i2) gives the first d
+		// elements of the output, and merging the rest gives the others.
+		// Cutting the output at evenly spaced d divides one merge into
+		// independent pieces of equal size (Odeh et al., "Merge Path").
+		// O(log(min(d, n1 + n2 - d))) comparisons.
+		//
+		template <RandomAccessIterator I1, SizedSentinel<I1> S1,
+			RandomAccessIterator I2, SizedSentinel<I2> S2,
+			class Comp = less<>, class Proj1 = identity, class Proj2 = identity>
+		requires
+			IndirectStrictWeakOrder<Comp,
+				projected<I1, Proj1>, projected<I2, Proj2>>
+		tagged_pair<tag::in1(I1), tag::in2(I2)>
+		merge_path(I1 first1, S1 last1, I2 first2, S2 last2,
+			difference_type_t<I1> d, Comp comp = Comp{},
+			Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+		{
+			auto const n1 = difference_type_t<I1>(last1 - first1);
+			auto const n2 = difference_type_t<I1>(last2 - first2);
+			STL2_EXPECT(0 <= d && d <= n1 + n2);
+			// Find the least i such that *(first1 + i) goes after
+			// *(first2 + (d - i - 1)); ties go to the first range.
+			auto lo = d > n2 ? d - n2 : difference_type_t<I1>(0);
+			auto hi = d < n1 ? d : n1;
+			while (lo < hi) {
+				auto const mid = lo + (hi - lo) / 2;
+				if (__stl2::invoke(comp,
+					__stl2::invoke(proj2, *(first2 + (d - mid - 1))),
+					__stl2::invoke(proj1, *(first1 + mid))))
+				{
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return {first1 + lo, first2 + (d - lo)};
+		}
+
+		template <RandomAccessRange Rng1, RandomAccessRange Rng2,
+			class Comp = less<>, class Proj1 = identity, class Proj2 = identity>
+		requires
+			SizedRange<Rng1> && SizedRange<Rng2> &&
+			IndirectStrictWeakOrder<Comp,
+				projected<iterator_t<Rng1>, Proj1>, projected<iterator_t<Rng2>, Proj2>>
+		tagged_pair<tag::in1(safe_iterator_t<Rng1>), tag::in2(safe_iterator_t<Rng2>)>
+		merge_path(Rng1&& rng1, Rng2&& rng2, difference_type_t<iterator_t<Rng1>> d,
+			Comp comp = Comp{}, Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+		{
+			return ext::merge_path(
+				__stl2::begin(rng1), __stl2::begin(rng1) + __stl2::distance(rng1),
+				__stl2::begin(rng2), __stl2::begin(rng2) + __stl2::distance(rng2),
+				d, std::ref(comp), std::ref(proj1), std::ref(proj2));
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
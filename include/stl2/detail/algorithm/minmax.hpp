@@ -16,6 +16,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/algorithm/simd_minmax.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/concepts/object.hpp>
@@ -25,18 +26,15 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace __minmax {
-		template <InputRange Rng, class Comp = less<>, class Proj = identity>
+		template <InputIterator I, Sentinel<I> S, class Comp, class Proj>
 		requires
-			Copyable<value_type_t<iterator_t<Rng>>> &&
+			Copyable<value_type_t<I>> &&
 			IndirectStrictWeakOrder<
-				Comp, projected<iterator_t<Rng>, Proj>>
-		constexpr tagged_pair<tag::min(value_type_t<iterator_t<Rng>>),
-			tag::max(value_type_t<iterator_t<Rng>>)>
-		impl(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+				Comp, projected<I, Proj>>
+		constexpr tagged_pair<tag::min(value_type_t<I>), tag::max(value_type_t<I>)>
+		impl(I first, S last, Comp comp, Proj proj)
 		{
-			using V = value_type_t<iterator_t<Rng>>;
-			auto first = __stl2::begin(rng);
-			auto last = __stl2::end(rng);
+			using V = value_type_t<I>;
 			STL2_EXPECT(first != last);
 			auto result = tagged_pair<tag::min(V), tag::max(V)>{
 				*first, *first
@@ -83,6 +81,37 @@ STL2_OPEN_NAMESPACE {
 		}
 	}
 
+	namespace ext {
+		// The first least and last greatest elements of the nonempty
+		// [first, last), by value.
+		template <InputIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
+		requires
+			Copyable<value_type_t<I>> &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I, Proj>>
+		STL2_CONSTEXPR_EXT tagged_pair<tag::min(value_type_t<I>), tag::max(value_type_t<I>)>
+		minmax(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return __minmax::impl(std::move(first), std::move(last),
+				std::ref(comp), std::ref(proj));
+		}
+
+		template <InputIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
+		requires
+			Copyable<value_type_t<I>> &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I, Proj>> &&
+			detail::simd::ReducibleRange<I, S, Comp, Proj>
+		tagged_pair<tag::min(value_type_t<I>), tag::max(value_type_t<I>)>
+		minmax(I first, S last, Comp = Comp{}, Proj = Proj{})
+		{
+			auto const n = difference_type_t<I>(last - first);
+			STL2_EXPECT(n > 0);
+			auto const r = detail::simd::minmax(detail::addressof(*first), n);
+			return {r.first, r.second};
+		}
+	}
+
 	template <class T, class Comp = less<>, class Proj = identity>
 	requires
 		IndirectStrictWeakOrder<
@@ -106,7 +135,8 @@ STL2_OPEN_NAMESPACE {
 		tag::max(value_type_t<iterator_t<Rng>>)>
 	minmax(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
 	{
-		return __minmax::impl(rng, std::ref(comp), std::ref(proj));
+		return ext::minmax(__stl2::begin(rng), __stl2::end(rng),
+			std::ref(comp), std::ref(proj));
 	}
 
 	template <Copyable T, class Comp = less<>, class Proj = identity>
@@ -116,7 +146,7 @@ STL2_OPEN_NAMESPACE {
 	constexpr tagged_pair<tag::min(T), tag::max(T)>
 	minmax(std::initializer_list<T>&& rng, Comp comp = Comp{}, Proj proj = Proj{})
 	{
-		return __minmax::impl(rng, std::ref(comp), std::ref(proj));
+		return __minmax::impl(rng.begin(), rng.end(), std::ref(comp), std::ref(proj));
 	}
 } STL2_CLOSE_NAMESPACE
 
@@ -19,6 +19,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/algorithm/simd_minmax.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/concepts/object.hpp>
@@ -73,6 +74,23 @@ STL2_OPEN_NAMESPACE {
 		return result;
 	}
 
+	template <ForwardIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
+	requires
+		IndirectStrictWeakOrder<
+			Comp, projected<I, Proj>> &&
+		detail::simd::ReducibleRange<I, S, Comp, Proj>
+	tagged_pair<tag::min(I), tag::max(I)>
+	minmax_element(I first, S last, Comp = Comp{}, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return {first, first};
+		}
+		auto const p = detail::addressof(*first);
+		auto const r = detail::simd::extremes<true, true>(p, n);
+		return {first + r.first, first + r.second};
+	}
+
 	template <ForwardRange Rng, class Comp = less<>, class Proj = identity>
 	requires
 		IndirectStrictWeakOrder<
@@ -15,6 +15,8 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -59,6 +61,26 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first1), std::move(first2)};
 	}
 
+	template <InputIterator I1, Sentinel<I1> S1,
+		InputIterator I2, Sentinel<I2> S2, class Pred = equal_to<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		IndirectRelation<
+			Pred, projected<I1, Proj1>, projected<I2, Proj2>> &&
+		detail::simd::ComparableRanges<I1, S1, I2, S2, Pred, Proj1, Proj2>
+	tagged_pair<tag::in1(I1), tag::in2(I2)>
+	mismatch(I1 first1, S1 last1, I2 first2, S2 last2, Pred = Pred{},
+		Proj1 = Proj1{}, Proj2 = Proj2{})
+	{
+		auto n = __stl2::min(difference_type_t<I1>(last1 - first1),
+			difference_type_t<I1>(last2 - first2));
+		if (n > 0) {
+			n = detail::simd::mismatch(detail::addressof(*first1),
+				detail::addressof(*first2), n);
+		}
+		return {first1 + n, first2 + n};
+	}
+
 	template <InputRange Rng1, class I2, class Pred = equal_to<>,
 		class Proj1 = identity, class Proj2 = identity>
 	[[deprecated]]
@@ -15,6 +15,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -32,6 +33,18 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+	requires
+		IndirectlyMovable<I, O> &&
+		SizedSentinel<S, I> &&
+		detail::MemMovable<I, O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	move(I first, S last, O result) {
+		auto n = difference_type_t<I>(last - first);
+		detail::mem::copy(first, n, result);
+		return {first + n, result + n};
+	}
+
 	template <InputRange Rng, class O>
 	requires
 		WeaklyIncrementable<__f<O>> &&
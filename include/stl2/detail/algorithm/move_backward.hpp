@@ -14,6 +14,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -33,6 +34,18 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(last), std::move(result)};
 	}
 
+	template <BidirectionalIterator I1, BidirectionalIterator I2>
+	requires
+		IndirectlyMovable<I1, I2> &&
+		detail::MemMovable<I1, I2>
+	tagged_pair<tag::in(I1), tag::out(I2)>
+	move_backward(I1 first, I1 last, I2 result)
+	{
+		auto n = difference_type_t<I1>(last - first);
+		detail::mem::copy_backward(last, n, result);
+		return {std::move(last), result - n};
+	}
+
 	template <BidirectionalIterator I1, Sentinel<I1> S1, class I2>
 	requires
 		BidirectionalIterator<__f<I2>> &&
@@ -0,0 +1,142 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_MULTIWAY_MERGE_HPP
+#define STL2_DETAIL_ALGORITHM_MULTIWAY_MERGE_HPP
+
+#include <vector>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/utility.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/tagspec.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// multiway_merge [Extension]
+//
+// Merges the sorted ranges of a range of ranges into result. Equivalent
+// elements keep the order of the runs they come from. Each output element
+// is chosen by a loser tree (Knuth, TAOCP 5.4.1) in about log2(k)
+// comparisons for k runs, instead of the k - 1 of a linear scan or the
+// 2 log2(k) of a heap. The iterators of the runs must remain valid after
+// the references to them obtained from runs are gone.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace multiway {
+			template <class Rng>
+			using run_t = reference_t<iterator_t<Rng>>;
+
+			template <class I, class S>
+			struct cursor {
+				I first;
+				S last;
+			};
+		}
+	}
+
+	namespace ext {
+		template <InputRange Rng, WeaklyIncrementable O,
+			class Comp = less<>, class Proj = identity>
+		requires
+			InputRange<detail::multiway::run_t<Rng>> &&
+			IndirectlyCopyable<iterator_t<detail::multiway::run_t<Rng>>, O> &&
+			IndirectStrictWeakOrder<Comp,
+				projected<iterator_t<detail::multiway::run_t<Rng>>, Proj>>
+		tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+		multiway_merge(Rng&& runs, O result, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			using R = detail::multiway::run_t<Rng>;
+			using C = detail::multiway::cursor<iterator_t<R>, sentinel_t<R>>;
+
+			std::vector<C> cursors;
+			auto it = __stl2::begin(runs);
+			auto const end = __stl2::end(runs);
+			for (; it != end; ++it) {
+				auto&& run = *it;
+				auto first = __stl2::begin(run);
+				auto last = __stl2::end(run);
+				if (first != last) {
+					cursors.push_back(C{std::move(first), std::move(last)});
+				}
+			}
+
+			auto const k = static_cast<std::ptrdiff_t>(cursors.size());
+			if (k == 0) {
+				return {std::move(it), std::move(result)};
+			}
+			if (k == 2) {
+				result = __stl2::merge(
+					std::move(cursors[0].first), std::move(cursors[0].last),
+					std::move(cursors[1].first), std::move(cursors[1].last),
+					std::move(result), std::ref(comp), std::ref(proj), std::ref(proj)).out();
+				return {std::move(it), std::move(result)};
+			}
+
+			// Whether the head of run a goes out before the head of run b, in
+			// one comparison that the compiler can make branch-free.
+			auto beats = [&](std::ptrdiff_t a, std::ptrdiff_t b) {
+				bool const earlier = a < b;
+				auto const x = earlier ? b : a;
+				auto const y = earlier ? a : b;
+				return earlier != bool(__stl2::invoke(comp,
+					__stl2::invoke(proj, *cursors[x].first),
+					__stl2::invoke(proj, *cursors[y].first)));
+			};
+
+			// Run r plays from leaf k + r. tree[node] is the loser of the match
+			// at internal node 0 < node < k, and tree[0] the overall winner.
+			std::vector<std::ptrdiff_t> tree(k);
+			{
+				std::vector<std::ptrdiff_t> winner(2 * k);
+				for (std::ptrdiff_t r = 0; r < k; ++r) {
+					winner[k + r] = r;
+				}
+				for (std::ptrdiff_t node = k - 1; node > 0; --node) {
+					auto a = winner[2 * node];
+					auto b = winner[2 * node + 1];
+					if (beats(b, a)) {
+						std::swap(a, b);
+					}
+					winner[node] = a;
+					tree[node] = b;
+				}
+				tree[0] = k > 1 ? winner[1] : 0;
+			}
+
+			// An exhausted run loses to every other.
+			std::vector<char> done(k);
+			auto w = tree[0];
+			for (auto active = k; active > 1;) {
+				C& c = cursors[w];
+				*result = *c.first;
+				++result;
+				if (++c.first == c.last) {
+					done[w] = true;
+					--active;
+				}
+				for (auto node = (k + w) / 2; node > 0; node /= 2) {
+					auto const l = tree[node];
+					bool const up = !done[l] && (done[w] || beats(l, w));
+					tree[node] = up ? w : l;
+					w = up ? l : w;
+				}
+			}
+			// The last run standing is the winner.
+			result = __stl2::copy(std::move(cursors[w].first),
+				std::move(cursors[w].last), std::move(result)).out();
+			return {std::move(it), std::move(result)};
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -22,10 +22,18 @@
 #ifndef STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <cmath>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/max_element.hpp>
+#include <stl2/detail/algorithm/min.hpp>
 #include <stl2/detail/algorithm/min_element.hpp>
+#include <stl2/detail/algorithm/partial_sort.hpp>
+#include <stl2/detail/algorithm/partition_point.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -33,229 +41,189 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		// stable, 2-3 compares, 0-2 swaps
-		template <class I, class C, class P>
-		requires
-			Sortable<I, C, P>
-		unsigned sort3(I x, I y, I z, C& comp, P& proj)
-		{
-			if (!__stl2::invoke(comp, __stl2::invoke(proj, *y), __stl2::invoke(proj, *x))) {      // if x <= y
-				if (!__stl2::invoke(comp, __stl2::invoke(proj, *z), __stl2::invoke(proj, *y))) {  // if y <= z
-					return 0;                     // x <= y && y <= z
-				}
-				                                  // x <= y && y > z
-				__stl2::iter_swap(y, z);          // x <= z && y < z
-				if (__stl2::invoke(comp, __stl2::invoke(proj, *y), __stl2::invoke(proj, *x))) {   // if x > y
-					__stl2::iter_swap(x, y);      // x < y && y <= z
-					return 2;
-				}
-				return 1;                         // x <= y && y < z
-			}
-			if (__stl2::invoke(comp, __stl2::invoke(proj, *z), __stl2::invoke(proj, *y))) {       // x > y, if y > z
-				__stl2::iter_swap(x, z);          // x < y && y < z
-				return 1;
-			}
-			__stl2::iter_swap(x, y);              // x > y && y <= z
-			                                      // x < y && x <= z
-			if (__stl2::invoke(comp, __stl2::invoke(proj, *z), __stl2::invoke(proj, *y))) {       // if y > z
-				__stl2::iter_swap(y, z);          // x <= y && y < z
-				return 2;
-			}
-			return 1;
-		}
+		// Introselect on pdqsort's partitioning: elements equivalent to a
+		// lower bound of the range are split off in one pass, ranges longer
+		// than floyd_rivest_threshold take their pivot from a Floyd-Rivest
+		// sample around nth, and after log2(n) badly unbalanced partitions
+		// the rest is done by heap selection (partial_sort), so the worst
+		// case is O(n log n).
+		namespace select {
+			constexpr std::ptrdiff_t floyd_rivest_threshold = 600;
 
-		template <BidirectionalIterator I, class C, class P>
-		requires
-			Sortable<I, C, P>
-		void selection_sort(I begin, I end, C &comp, P &proj)
-		{
-			STL2_EXPECT(begin != end);
-			for (I lm1 = __stl2::prev(end); begin != lm1; ++begin) {
-				I i = __stl2::min_element(begin, end, std::ref(comp), std::ref(proj));
-				if (i != begin) {
-					__stl2::iter_swap(begin, i);
-				}
-			}
-		}
-	}
+			template <RandomAccessIterator I, class C, class P>
+			requires
+				Sortable<I, C, P>
+			void introselect(I first, I nth, I last, difference_type_t<I> bad_allowed,
+				C& comp, P& proj, bool leftmost = true);
 
-	// TODO: refactor this monstrosity.
-	template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
-	requires
-		Sortable<I, Comp, Proj>
-	I nth_element(I first, I nth, S last, Comp comp = Comp{}, Proj proj = Proj{})
-	{
-		I end = __stl2::next(nth, last), end_orig = end;
-		static constexpr difference_type_t<I> limit = 7;
-		while (true) {
-		restart:
-			if (nth == end) {
-				return end_orig;
-			}
-			difference_type_t<I> len = end - first;
-			switch (len) {
-			case 0:
-			case 1:
-				return end_orig;
-			case 2:
-				if (__stl2::invoke(comp, __stl2::invoke(proj, *--end), __stl2::invoke(proj, *first))) {
-					__stl2::iter_swap(first, end);
-				}
-				return end_orig;
-			case 3:
-				{
-					I m = first;
-					detail::sort3(first, ++m, --end, comp, proj);
-					return end_orig;
-				}
-			}
-			if (len <= limit) {
-				detail::selection_sort(first, end, comp, proj);
-				return end_orig;
+			// Moves to *first the element of rank nth - first within a window
+			// of about n^(2/3) elements around nth, placed as Floyd and Rivest
+			// (1975) do so that it has, for randomly ordered input, very
+			// nearly the rank of nth in the whole range. Leaves an element not
+			// less than the pivot in [first + 1, last).
+			// Pre: first < nth < last - 1
+			template <RandomAccessIterator I, class C, class P>
+			requires
+				Sortable<I, C, P>
+			void sample_pivot(I first, I nth, I last, C& comp, P& proj)
+			{
+				using D = difference_type_t<I>;
+				auto const n = D(last - first);
+				auto const i = D(nth - first);
+				double const z = std::log(double(n));
+				double const s = 0.5 * std::exp(2 * z / 3);
+				double const sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (2 * i < n ? -1 : 1);
+				auto lo = D(i - i * s / n + sd);
+				auto hi = D(i + (n - i) * s / n + sd);
+				lo = __stl2::max(D(0), __stl2::min(lo, i));
+				hi = __stl2::min(n, __stl2::max(hi, D(i + 2)));
+				select::introselect(first + lo, nth, first + hi,
+					rsort::log2(hi - lo), comp, proj);
+				__stl2::iter_swap(first, nth);
 			}
-			static_assert(limit >= 3);
-			// len > limit >= 3
-			I m = first + len/2;
-			I lm1 = end;
-			unsigned n_swaps = detail::sort3(first, m, --lm1, comp, proj);
-			// *m is median
-			// partition [first, m) < *m and *m <= [m, end)
-			//(this inhibits tossing elements equivalent to m around unnecessarily)
-			I i = first;
-			I j = lm1;
-			// j points beyond range to be tested, *lm1 is known to be <= *m
-			// The search going up is known to be guarded but the search coming down isn't.
-			// Prime the downward search with a guard.
-			if (!__stl2::invoke(comp, __stl2::invoke(proj, *i), __stl2::invoke(proj, *m))) {  // if *first == *m
-				// *first == *m, *first doesn't go in first part
-				// manually guard downward moving j against i
+
+			// leftmost is false iff *(first - 1) is a lower bound for
+			// [first, last).
+			template <RandomAccessIterator I, class C, class P>
+			requires
+				Sortable<I, C, P>
+			void introselect(I first, I nth, I last, difference_type_t<I> bad_allowed,
+				C& comp, P& proj, bool leftmost)
+			{
 				while (true) {
-					if (i == --j) {
-						// *first == *m, *m <= all other elements
-						// Parition instead into [first, i) == *first and *first < [i, end)
-						++i;  // first + 1
-						j = end;
-						if (!__stl2::invoke(comp, __stl2::invoke(proj, *first), __stl2::invoke(proj, *--j))) {  // we need a guard if *first == *(end-1)
-							while (true) {
-								if (i == j) {
-									return end_orig;  // [first, end) all equivalent elements
-								}
-								if (__stl2::invoke(comp, __stl2::invoke(proj, *first), __stl2::invoke(proj, *i))) {
-									__stl2::iter_swap(i, j);
-									++n_swaps;
-									++i;
-									break;
-								}
-								++i;
-							}
+					auto const size = difference_type_t<I>(last - first);
+					if (size < rsort::insertion_sort_threshold) {
+						if (leftmost) {
+							rsort::insertion_sort(first, last, comp, proj);
+						} else {
+							rsort::unguarded_insertion_sort(first, last, comp, proj);
 						}
-						// [first, i) == *first and *first < [j, end) and j == end - 1
-						if (i == j) {
-							return end_orig;
-						}
-						while (true) {
-							while (!__stl2::invoke(comp, __stl2::invoke(proj, *first), __stl2::invoke(proj, *i)))
-								++i;
-							while (__stl2::invoke(comp, __stl2::invoke(proj, *first), __stl2::invoke(proj, *--j)))
-								;
-							if (i >= j)
-								break;
-							__stl2::iter_swap(i, j);
-							++n_swaps;
-							++i;
-						}
-						// [first, i) == *first and *first < [i, end)
-						// The first part is sorted,
-						if (nth < i) {
-							return end_orig;
-						}
-						// nth_element the second part
-						// nth_element<C>(i, nth, end, comp);
-						first = i;
-						goto restart;
+						return;
 					}
-					if (__stl2::invoke(comp, __stl2::invoke(proj, *j), __stl2::invoke(proj, *m))) {
-						__stl2::iter_swap(i, j);
-						++n_swaps;
-						break;  // found guard for downward moving j, now use unguarded partition
+					if (nth == first) {
+						__stl2::iter_swap(first, __stl2::min_element(first, last,
+							std::ref(comp), std::ref(proj)));
+						return;
 					}
-				}
-			}
-			++i;
-			// j points beyond range to be tested, *lm1 is known to be <= *m
-			// if not yet partitioned...
-			if (i < j) {
-				// known that *(i - 1) < *m
-				while (true) {
-					// m still guards upward moving i
-					while (__stl2::invoke(comp, __stl2::invoke(proj, *i), __stl2::invoke(proj, *m))) {
-						++i;
+					if (nth == last - 1) {
+						__stl2::iter_swap(nth, __stl2::max_element(first, last,
+							std::ref(comp), std::ref(proj)));
+						return;
 					}
-					// It is now known that a guard exists for downward moving j
-					while (!__stl2::invoke(comp, __stl2::invoke(proj, *--j), __stl2::invoke(proj, *m))) {
-						;
+
+					if (size > floyd_rivest_threshold) {
+						select::sample_pivot(first, nth, last, comp, proj);
+					} else {
+						rsort::choose_pivot(first, last, comp, proj);
 					}
-					if (i >= j) {
-						break;
+
+					if (!leftmost &&
+						!__stl2::invoke(comp, __stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+						I const pivot_pos = rsort::partition_left(first, last, comp, proj);
+						if (nth <= pivot_pos) {
+							return;
+						}
+						first = pivot_pos + 1;
+						continue;
+					}
+
+					I const pivot_pos = rsort::partition_right(first, last, comp, proj).first;
+					if (nth == pivot_pos) {
+						return;
+					}
+					auto const l_size = difference_type_t<I>(pivot_pos - first);
+					auto const r_size = difference_type_t<I>(last - (pivot_pos + 1));
+					if (l_size < size / 8 || r_size < size / 8) {
+						if (--bad_allowed == 0) {
+							__stl2::partial_sort(first, nth + 1, last,
+								std::ref(comp), std::ref(proj));
+							return;
+						}
+						rsort::break_patterns(first, pivot_pos, last);
 					}
-					__stl2::iter_swap(i, j);
-					++n_swaps;
-					// It is known that m != j
-					// If m just moved, follow it
-					if (m == i) {
-						m = j;
+					if (nth < pivot_pos) {
+						last = pivot_pos;
+					} else {
+						first = pivot_pos + 1;
+						leftmost = false;
 					}
-					++i;
 				}
 			}
-			// [first, i) < *m and *m <= [i, end)
-			if (i != m && __stl2::invoke(comp, __stl2::invoke(proj, *m), __stl2::invoke(proj, *i))) {
-				__stl2::iter_swap(i, m);
-				++n_swaps;
-			}
-			// [first, i) < *i and *i <= [i+1, end)
-			if (nth == i) {
-				return end_orig;
-			}
-			if (n_swaps == 0) {
-				// We were given a perfectly partitioned sequence.  Coincidence?
-				if (nth < i) {
-					// Check for [first, i) already sorted
-					j = m = first;
-					while (++j != i) {
-						if (__stl2::invoke(comp, __stl2::invoke(proj, *j), __stl2::invoke(proj, *m))) {
-							// not yet sorted, so sort
-							goto not_sorted;
+
+			// Places every element of the sorted range of positions
+			// [nfirst, nlast) in one recursive partitioning of [first, last).
+			template <RandomAccessIterator I, RandomAccessIterator N, class C, class P>
+			requires
+				Sortable<I, C, P>
+			void multiselect(I first, I last, N nfirst, N nlast,
+				difference_type_t<I> bad_allowed, C& comp, P& proj, bool leftmost = true)
+			{
+				while (nfirst != nlast) {
+					if (nlast - nfirst == 1) {
+						select::introselect(first, I(*nfirst), last, bad_allowed,
+							comp, proj, leftmost);
+						return;
+					}
+					auto const size = difference_type_t<I>(last - first);
+					if (size < rsort::insertion_sort_threshold) {
+						if (leftmost) {
+							rsort::insertion_sort(first, last, comp, proj);
+						} else {
+							rsort::unguarded_insertion_sort(first, last, comp, proj);
 						}
-						m = j;
+						return;
+					}
+
+					I const nth = *(nfirst + (nlast - nfirst) / 2);
+					if (size > floyd_rivest_threshold && first < nth && nth < last - 1) {
+						select::sample_pivot(first, nth, last, comp, proj);
+					} else {
+						rsort::choose_pivot(first, last, comp, proj);
 					}
-					// [first, i) sorted
-					return end_orig;
-				} else {
-					// Check for [i, end) already sorted
-					j = m = i;
-					while (++j != end) {
-						if (__stl2::invoke(comp, __stl2::invoke(proj, *j), __stl2::invoke(proj, *m))) {
-							// not yet sorted, so sort
-							goto not_sorted;
+
+					I pivot_pos;
+					if (!leftmost &&
+						!__stl2::invoke(comp, __stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+						// [first, pivot_pos] are all in their final positions.
+						pivot_pos = rsort::partition_left(first, last, comp, proj);
+					} else {
+						pivot_pos = rsort::partition_right(first, last, comp, proj).first;
+						auto const l_size = difference_type_t<I>(pivot_pos - first);
+						auto const r_size = difference_type_t<I>(last - (pivot_pos + 1));
+						if (l_size < size / 8 || r_size < size / 8) {
+							if (--bad_allowed == 0) {
+								__stl2::partial_sort(first, *(nlast - 1) + 1, last,
+									std::ref(comp), std::ref(proj));
+								return;
+							}
+							rsort::break_patterns(first, pivot_pos, last);
 						}
-						m = j;
+						auto const nleft = __stl2::partition_point(nfirst, nlast,
+							[&](const I& i) { return i < pivot_pos; });
+						select::multiselect(first, pivot_pos, nfirst, nleft,
+							bad_allowed, comp, proj, leftmost);
+						nfirst = nleft;
 					}
-					// [i, end) sorted
-					return end_orig;
+					nfirst = __stl2::partition_point(nfirst, nlast,
+						[&](const I& i) { return i <= pivot_pos; });
+					first = pivot_pos + 1;
+					leftmost = false;
 				}
 			}
-		not_sorted:
-			// nth_element on range containing nth
-			if (nth < i) {
-				// nth_element<C>(first, nth, i, comp);
-				end = i;
-			} else {
-				// nth_element<C>(i+1, nth, end, comp);
-				first = ++i;
-			}
 		}
-		return end_orig;
+	}
+
+	template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>, class Proj = identity>
+	requires
+		Sortable<I, Comp, Proj>
+	I nth_element(I first, I nth, S last, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		I const end = __stl2::next(nth, std::move(last));
+		if (nth != end) {
+			detail::select::introselect(first, nth, end,
+				detail::rsort::log2(end - first), comp, proj);
+		}
+		return end;
 	}
 
 	template <RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
@@ -268,6 +236,49 @@ STL2_OPEN_NAMESPACE {
 			__stl2::begin(rng), std::move(nth), __stl2::end(rng),
 			std::ref(comp), std::ref(proj));
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// nth_elements [Extension]
+		//
+		// nth_element for each of the ascending positions in nths at once:
+		// afterwards every *n is the element that would be there if
+		// [first, last) were sorted, and the elements between consecutive
+		// positions are partitioned accordingly. One partitioning pass
+		// serves all of them, e.g. for several percentiles of the same data.
+		//
+		template <RandomAccessIterator I, Sentinel<I> S, RandomAccessRange Nths,
+			class Comp = less<>, class Proj = identity>
+		requires
+			Same<value_type_t<iterator_t<Nths>>, I> &&
+			Sortable<I, Comp, Proj>
+		I nth_elements(I first, S last, Nths&& nths, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			I const end = __stl2::next(first, std::move(last));
+			auto nfirst = __stl2::begin(nths);
+			// Positions at end select nothing.
+			auto nlast = __stl2::partition_point(nfirst, __stl2::end(nths),
+				[&](const I& i) { return i != end; });
+			STL2_EXPENSIVE_ASSERT(__stl2::is_sorted(nfirst, nlast));
+			if (nfirst != nlast) {
+				detail::select::multiselect(first, end, nfirst, nlast,
+					detail::rsort::log2(end - first), comp, proj);
+			}
+			return end;
+		}
+
+		template <RandomAccessRange Rng, RandomAccessRange Nths,
+			class Comp = less<>, class Proj = identity>
+		requires
+			Same<value_type_t<iterator_t<Nths>>, iterator_t<Rng>> &&
+			Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		nth_elements(Rng&& rng, Nths&& nths, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return ext::nth_elements(__stl2::begin(rng), __stl2::end(rng), nths,
+				std::ref(comp), std::ref(proj));
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
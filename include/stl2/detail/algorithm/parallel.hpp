@@ -0,0 +1,749 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_PARALLEL_HPP
+#define STL2_DETAIL_ALGORITHM_PARALLEL_HPP
+
+#include <atomic>
+#include <type_traits>
+#include <vector>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/tuple.hpp>
+#include <stl2/detail/execution.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/thread_pool.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/fill.hpp>
+#include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/inplace_merge.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/partition.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/algorithm/tagspec.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/memory/uninitialized_move.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Parallel algorithms [Extension]
+//
+// Overloads taking an execution policy as their first argument. They
+// require random access iterators with sized sentinels so the input can be
+// split up front, and run on detail::thread_pool. Element access functions
+// may be invoked concurrently from several threads; an exception thrown by
+// one of them is propagated to the caller once all tasks have finished.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace par {
+			// Inputs are never split into pieces shorter than this.
+			constexpr std::ptrdiff_t grain_size = 1 << 12;
+
+			// Number of chunks to split n elements into: per_thread for each
+			// thread of the pool, but no more than grain_size allows.
+			inline std::ptrdiff_t chunk_count(std::ptrdiff_t n, std::ptrdiff_t per_thread)
+			{
+				auto const threads = static_cast<std::ptrdiff_t>(
+					thread_pool::instance().concurrency());
+				return __stl2::min(threads * per_thread, n / grain_size);
+			}
+
+			// Start of chunk c of k chunks of [0, n).
+			inline std::ptrdiff_t chunk_bound(std::ptrdiff_t n, std::ptrdiff_t k, std::ptrdiff_t c)
+			{
+				return c * (n / k) + __stl2::min(c, n % k);
+			}
+
+			// Calls f(c, lo, hi) for each chunk [lo, hi) of k chunks of [0, n),
+			// running the first chunk on the calling thread.
+			template <class F>
+			void for_each_chunk(std::ptrdiff_t n, std::ptrdiff_t k, F&& f)
+			{
+				if (k <= 1) {
+					f(std::ptrdiff_t{0}, std::ptrdiff_t{0}, n);
+					return;
+				}
+				task_group group;
+				for (std::ptrdiff_t c = 1; c < k; ++c) {
+					group.run([&f, c, lo = par::chunk_bound(n, k, c),
+						hi = par::chunk_bound(n, k, c + 1)] { f(c, lo, hi); });
+				}
+				f(std::ptrdiff_t{0}, std::ptrdiff_t{0}, par::chunk_bound(n, k, 1));
+				group.wait();
+			}
+
+			template <class F>
+			void parallel_for(std::ptrdiff_t n, F&& f)
+			{
+				par::for_each_chunk(n, par::chunk_count(n, 4), std::forward<F>(f));
+			}
+
+			// Index of the first element of [first, first + n) satisfying
+			// pred, or n. Chunks give up once a match is found before them.
+			template <RandomAccessIterator I, class Pred>
+			difference_type_t<I> find_if(I first, difference_type_t<I> n, Pred pred)
+			{
+				using D = difference_type_t<I>;
+				std::atomic<D> found{n};
+				par::parallel_for(n, [&](std::ptrdiff_t, D lo, D hi) {
+					while (lo < hi) {
+						if (found.load(std::memory_order_relaxed) < lo) {
+							return;
+						}
+						D const stop = __stl2::min(hi, D(lo + grain_size));
+						for (; lo < stop; ++lo) {
+							if (pred(*(first + lo))) {
+								D prev = found.load(std::memory_order_relaxed);
+								while (lo < prev &&
+									!found.compare_exchange_weak(prev, lo, std::memory_order_relaxed))
+								{}
+								return;
+							}
+						}
+					}
+				});
+				return found.load();
+			}
+
+			// Stable merge of [f1, l1) and [f2, l2) into out. ext::merge_path
+			// cuts the output into one piece per thread, all of the same
+			// length, and leaf merges each piece. Every cut is found before
+			// any piece is merged, since leaf may move from the inputs.
+			template <RandomAccessIterator I1, RandomAccessIterator I2,
+				RandomAccessIterator O, class Comp, class Proj1, class Proj2, class Leaf>
+			void merge(I1 f1, I1 l1, I2 f2, I2 l2, O out,
+				Comp& comp, Proj1& proj1, Proj2& proj2, Leaf& leaf)
+			{
+				std::ptrdiff_t const n = (l1 - f1) + (l2 - f2);
+				std::ptrdiff_t const k = par::chunk_count(n, 1);
+				if (k <= 1) {
+					leaf(f1, l1, f2, l2, out);
+					return;
+				}
+				std::vector<tagged_pair<tag::in1(I1), tag::in2(I2)>> cuts;
+				cuts.reserve(k + 1);
+				cuts.push_back({f1, f2});
+				for (std::ptrdiff_t c = 1; c < k; ++c) {
+					cuts.push_back(ext::merge_path(f1, l1, f2, l2, par::chunk_bound(n, k, c),
+						std::ref(comp), std::ref(proj1), std::ref(proj2)));
+				}
+				cuts.push_back({l1, l2});
+				par::for_each_chunk(n, k,
+					[&](std::ptrdiff_t c, std::ptrdiff_t lo, std::ptrdiff_t) {
+						auto const& a = cuts[c];
+						auto const& b = cuts[c + 1];
+						leaf(a.in1(), b.in1(), a.in2(), b.in2(), out + lo);
+					});
+			}
+
+			// Moves [first, first + n) into the buffer at tmp, parallel-merges
+			// the runs [tmp + bounds[r], tmp + bounds[r + 1]) pairwise back and
+			// forth until one remains, and leaves the result in [first, first + n).
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			void merge_runs(I first, value_type_t<I>* tmp,
+				std::vector<difference_type_t<I>>& bounds, Comp& comp, Proj& proj)
+			{
+				using D = difference_type_t<I>;
+				using V = value_type_t<I>;
+				D const runs = static_cast<D>(bounds.size()) - 1;
+				D const n = bounds.back();
+				V* constructed = tmp;
+				detail::destroy_guard<V*> guard{constructed};
+				par::parallel_for(n, [&](std::ptrdiff_t, D lo, D hi) {
+					__stl2::uninitialized_move(first + lo, first + hi, tmp + lo);
+				});
+				constructed = tmp + n;
+
+				auto leaf = [&comp, &proj](auto f1, auto l1, auto f2, auto l2, auto out) {
+					__stl2::merge(
+						__stl2::make_move_iterator(f1), __stl2::make_move_iterator(l1),
+						__stl2::make_move_iterator(f2), __stl2::make_move_iterator(l2),
+						out, std::ref(comp), std::ref(proj), std::ref(proj));
+				};
+				bool in_buffer = true;
+				for (D width = 1; width < runs; width *= 2) {
+					task_group group;
+					for (D r = 0; r < runs; r += 2 * width) {
+						D const lo = bounds[r];
+						D const mid = bounds[__stl2::min(r + width, runs)];
+						D const hi = bounds[__stl2::min(r + 2 * width, runs)];
+						group.run([=, &comp, &proj, &leaf] {
+							if (in_buffer) {
+								par::merge(tmp + lo, tmp + mid, tmp + mid, tmp + hi,
+									first + lo, comp, proj, proj, leaf);
+							} else {
+								par::merge(first + lo, first + mid, first + mid, first + hi,
+									tmp + lo, comp, proj, proj, leaf);
+							}
+						});
+					}
+					group.wait();
+					in_buffer = !in_buffer;
+				}
+				if (in_buffer) {
+					par::parallel_for(n, [&](std::ptrdiff_t, D lo, D hi) {
+						__stl2::move(tmp + lo, tmp + hi, first + lo);
+					});
+				}
+			}
+
+			// Sorts one run per thread with sort_run, then merges the runs.
+			template <RandomAccessIterator I, class Comp, class Proj, class SortRun>
+			requires
+				Sortable<I, Comp, Proj>
+			void merge_sort(I first, I last, Comp& comp, Proj& proj, SortRun sort_run)
+			{
+				using D = difference_type_t<I>;
+				using V = value_type_t<I>;
+				D const n = last - first;
+				D const runs = par::chunk_count(n, 1);
+				if (runs <= 1) {
+					sort_run(first, last);
+					return;
+				}
+				par::for_each_chunk(n, runs, [&](std::ptrdiff_t, D lo, D hi) {
+					sort_run(first + lo, first + hi);
+				});
+
+				std::vector<D> bounds(runs + 1);
+				for (D r = 0; r <= runs; ++r) {
+					bounds[r] = par::chunk_bound(n, runs, r);
+				}
+				auto buf = std::is_nothrow_move_constructible<V>::value ?
+					temporary_buffer<V>{n} : temporary_buffer<V>{};
+				if (buf.size() >= n) {
+					par::merge_runs(first, buf.data(), bounds, comp, proj);
+					return;
+				}
+				// No buffer: merge neighbouring runs in place.
+				for (D width = 1; width < runs; width *= 2) {
+					task_group group;
+					for (D r = 0; r + width < runs; r += 2 * width) {
+						I const lo = first + bounds[r];
+						I const mid = first + bounds[r + width];
+						I const hi = first + bounds[__stl2::min(r + 2 * width, runs)];
+						group.run([=, &comp, &proj] {
+							__stl2::inplace_merge(lo, mid, hi, std::ref(comp), std::ref(proj));
+						});
+					}
+					group.wait();
+				}
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// for_each
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class F, class Proj = identity>
+	requires
+		IndirectUnaryInvocable<F, projected<I, Proj>>
+	I for_each(E&&, I first, S last, F fun, Proj proj = Proj{})
+	{
+		auto const n = last - first;
+		detail::par::parallel_for(n, [&](std::ptrdiff_t, auto lo, auto hi) {
+			__stl2::for_each(first + lo, first + hi, std::ref(fun), std::ref(proj));
+		});
+		return first + n;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class F, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryInvocable<F, projected<iterator_t<Rng>, Proj>>
+	safe_iterator_t<Rng> for_each(E&& exec, Rng&& rng, F fun, Proj proj = Proj{})
+	{
+		return __stl2::for_each(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(fun), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// transform
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		RandomAccessIterator O, CopyConstructible F, class Proj = identity>
+	requires
+		Writable<O, indirect_result_of_t<F&(projected<I, Proj>)>>
+	tagged_pair<tag::in(I), tag::out(O)>
+	transform(E&&, I first, S last, O result, F op, Proj proj = Proj{})
+	{
+		auto const n = last - first;
+		detail::par::parallel_for(n, [&](std::ptrdiff_t, auto lo, auto hi) {
+			__stl2::transform(first + lo, first + hi, result + lo,
+				std::ref(op), std::ref(proj));
+		});
+		return {first + n, result + n};
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, RandomAccessIterator O,
+		CopyConstructible F, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		Writable<O, indirect_result_of_t<F&(projected<iterator_t<Rng>, Proj>)>>
+	tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+	transform(E&& exec, Rng&& rng, O result, F op, Proj proj = Proj{})
+	{
+		return __stl2::transform(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::move(result), std::ref(op), std::ref(proj));
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessIterator I1, SizedSentinel<I1> S1,
+		RandomAccessIterator I2, SizedSentinel<I2> S2, RandomAccessIterator O,
+		CopyConstructible F, class Proj1 = identity, class Proj2 = identity>
+	requires
+		Writable<O, indirect_result_of_t<F&(projected<I1, Proj1>,
+			projected<I2, Proj2>)>>
+	tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+	transform(E&&, I1 first1, S1 last1, I2 first2, S2 last2, O result,
+		F op, Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+	{
+		using D = difference_type_t<I1>;
+		D const n = __stl2::min(D(last1 - first1), D(last2 - first2));
+		detail::par::parallel_for(n, [&](std::ptrdiff_t, D lo, D hi) {
+			__stl2::transform(first1 + lo, first1 + hi, first2 + lo, first2 + hi,
+				result + lo, std::ref(op), std::ref(proj1), std::ref(proj2));
+		});
+		return {first1 + n, first2 + n, result + n};
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng1, RandomAccessRange Rng2,
+		RandomAccessIterator O, CopyConstructible F,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		SizedRange<Rng1> && SizedRange<Rng2> &&
+		Writable<O, indirect_result_of_t<F&(
+			projected<iterator_t<Rng1>, Proj1>, projected<iterator_t<Rng2>, Proj2>)>>
+	tagged_tuple<tag::in1(safe_iterator_t<Rng1>), tag::in2(safe_iterator_t<Rng2>), tag::out(O)>
+	transform(E&& exec, Rng1&& rng1, Rng2&& rng2, O result, F op,
+		Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+	{
+		return __stl2::transform(std::forward<E>(exec),
+			__stl2::begin(rng1), __stl2::begin(rng1) + __stl2::distance(rng1),
+			__stl2::begin(rng2), __stl2::begin(rng2) + __stl2::distance(rng2),
+			std::move(result), std::ref(op), std::ref(proj1), std::ref(proj2));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// copy
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		RandomAccessIterator O>
+	requires
+		IndirectlyCopyable<I, O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	copy(E&&, I first, S last, O result)
+	{
+		auto const n = last - first;
+		detail::par::parallel_for(n, [&](std::ptrdiff_t, auto lo, auto hi) {
+			__stl2::copy(first + lo, first + hi, result + lo);
+		});
+		return {first + n, result + n};
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, RandomAccessIterator O>
+	requires
+		SizedRange<Rng> &&
+		IndirectlyCopyable<iterator_t<Rng>, O>
+	tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+	copy(E&& exec, Rng&& rng, O result)
+	{
+		return __stl2::copy(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::move(result));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// fill
+	//
+	template <ext::ExecutionPolicy E, class T, RandomAccessIterator O, SizedSentinel<O> S>
+	requires
+		Writable<O, const T&>
+	O fill(E&&, O first, S last, const T& value)
+	{
+		auto const n = last - first;
+		detail::par::parallel_for(n, [&](std::ptrdiff_t, auto lo, auto hi) {
+			__stl2::fill(first + lo, first + hi, value);
+		});
+		return first + n;
+	}
+
+	template <ext::ExecutionPolicy E, class T, RandomAccessRange Rng>
+	requires
+		SizedRange<Rng> &&
+		Writable<iterator_t<Rng>, const T&>
+	safe_iterator_t<Rng> fill(E&& exec, Rng&& rng, const T& value)
+	{
+		return __stl2::fill(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng), value);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// count_if
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	difference_type_t<I> count_if(E&&, I first, S last, Pred pred, Proj proj = Proj{})
+	{
+		using D = difference_type_t<I>;
+		std::atomic<D> count{0};
+		detail::par::parallel_for(last - first, [&](std::ptrdiff_t, D lo, D hi) {
+			count.fetch_add(__stl2::count_if(first + lo, first + hi,
+				std::ref(pred), std::ref(proj)), std::memory_order_relaxed);
+		});
+		return count.load();
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	difference_type_t<iterator_t<Rng>>
+	count_if(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return __stl2::count_if(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(pred), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// find_if
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	I find_if(E&&, I first, S last, Pred pred, Proj proj = Proj{})
+	{
+		return first + detail::par::find_if(first, last - first,
+			[&](reference_t<I>&& x) {
+				return static_cast<bool>(__stl2::invoke(pred, __stl2::invoke(proj,
+					std::forward<reference_t<I>>(x))));
+			});
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	safe_iterator_t<Rng> find_if(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return __stl2::find_if(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(pred), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// all_of, any_of, none_of
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	bool all_of(E&&, I first, S last, Pred pred, Proj proj = Proj{})
+	{
+		auto const n = last - first;
+		return detail::par::find_if(first, n, [&](reference_t<I>&& x) {
+			return !__stl2::invoke(pred, __stl2::invoke(proj,
+				std::forward<reference_t<I>>(x)));
+		}) == n;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	bool all_of(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return __stl2::all_of(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(pred), std::ref(proj));
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	bool any_of(E&& exec, I first, S last, Pred pred, Proj proj = Proj{})
+	{
+		auto const n = last - first;
+		return __stl2::find_if(std::forward<E>(exec), first, first + n,
+			std::ref(pred), std::ref(proj)) != first + n;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	bool any_of(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return __stl2::any_of(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(pred), std::ref(proj));
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	bool none_of(E&& exec, I first, S last, Pred pred, Proj proj = Proj{})
+	{
+		return !__stl2::any_of(std::forward<E>(exec), std::move(first), std::move(last),
+			std::ref(pred), std::ref(proj));
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	bool none_of(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return !__stl2::any_of(std::forward<E>(exec), rng,
+			std::ref(pred), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// sort
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Comp = less<>, class Proj = identity>
+	requires
+		Sortable<I, Comp, Proj>
+	I sort(E&&, I first, S last_, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		I const last = first + (last_ - first);
+		detail::par::merge_sort(first, last, comp, proj, [&](I lo, I hi) {
+			__stl2::sort(lo, hi, std::ref(comp), std::ref(proj));
+		});
+		return last;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng,
+		class Comp = less<>, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		Sortable<iterator_t<Rng>, Comp, Proj>
+	safe_iterator_t<Rng> sort(E&& exec, Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		return __stl2::sort(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(comp), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// stable_sort
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Comp = less<>, class Proj = identity>
+	requires
+		Sortable<I, Comp, Proj>
+	I stable_sort(E&&, I first, S last_, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		I const last = first + (last_ - first);
+		detail::par::merge_sort(first, last, comp, proj, [&](I lo, I hi) {
+			__stl2::stable_sort(lo, hi, std::ref(comp), std::ref(proj));
+		});
+		return last;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng,
+		class Comp = less<>, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		Sortable<iterator_t<Rng>, Comp, Proj>
+	safe_iterator_t<Rng> stable_sort(E&& exec, Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		return __stl2::stable_sort(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(comp), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// merge
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I1, SizedSentinel<I1> S1,
+		RandomAccessIterator I2, SizedSentinel<I2> S2, RandomAccessIterator O,
+		class Comp = less<>, class Proj1 = identity, class Proj2 = identity>
+	requires
+		Mergeable<I1, I2, O, Comp, Proj1, Proj2>
+	tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+	merge(E&&, I1 first1, S1 last1_, I2 first2, S2 last2_, O result,
+		Comp comp = Comp{}, Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+	{
+		I1 const last1 = first1 + (last1_ - first1);
+		I2 const last2 = first2 + (last2_ - first2);
+		auto leaf = [&](I1 f1, I1 l1, I2 f2, I2 l2, O out) {
+			__stl2::merge(f1, l1, f2, l2, out,
+				std::ref(comp), std::ref(proj1), std::ref(proj2));
+		};
+		detail::par::merge(first1, last1, first2, last2, result,
+			comp, proj1, proj2, leaf);
+		return {last1, last2, result + (last1 - first1) + (last2 - first2)};
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng1, RandomAccessRange Rng2,
+		RandomAccessIterator O, class Comp = less<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		SizedRange<Rng1> && SizedRange<Rng2> &&
+		Mergeable<iterator_t<Rng1>, iterator_t<Rng2>, O, Comp, Proj1, Proj2>
+	tagged_tuple<tag::in1(safe_iterator_t<Rng1>), tag::in2(safe_iterator_t<Rng2>), tag::out(O)>
+	merge(E&& exec, Rng1&& rng1, Rng2&& rng2, O result, Comp comp = Comp{},
+		Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+	{
+		return __stl2::merge(std::forward<E>(exec),
+			__stl2::begin(rng1), __stl2::begin(rng1) + __stl2::distance(rng1),
+			__stl2::begin(rng2), __stl2::begin(rng2) + __stl2::distance(rng2),
+			std::move(result), std::ref(comp), std::ref(proj1), std::ref(proj2));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// inplace_merge
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Comp = less<>, class Proj = identity>
+	requires
+		Sortable<I, Comp, Proj>
+	I inplace_merge(E&&, I first, I middle, S last_, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		using D = difference_type_t<I>;
+		using V = value_type_t<I>;
+		I const last = first + (last_ - first);
+		D const n = last - first;
+		if (n > 4 * detail::par::grain_size &&
+			std::is_nothrow_move_constructible<V>::value) {
+			detail::temporary_buffer<V> buf{n};
+			if (buf.size() >= n) {
+				std::vector<D> bounds{0, D(middle - first), n};
+				detail::par::merge_runs(first, buf.data(), bounds, comp, proj);
+				return last;
+			}
+		}
+		return __stl2::inplace_merge(first, middle, last,
+			std::ref(comp), std::ref(proj));
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng,
+		class Comp = less<>, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		Sortable<iterator_t<Rng>, Comp, Proj>
+	safe_iterator_t<Rng>
+	inplace_merge(E&& exec, Rng&& rng, iterator_t<Rng> middle,
+		Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		return __stl2::inplace_merge(std::forward<E>(exec),
+			__stl2::begin(rng), std::move(middle),
+			__stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(comp), std::ref(proj));
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// partition
+	//
+	// Each thread partitions a chunk; the falses that ended up left of the
+	// final partition point are then swapped with the trues right of it.
+	//
+	template <ext::ExecutionPolicy E, RandomAccessIterator I, SizedSentinel<I> S,
+		class Pred, class Proj = identity>
+	requires
+		Permutable<I> &&
+		IndirectUnaryPredicate<Pred, projected<I, Proj>>
+	I partition(E&&, I first, S last_, Pred pred, Proj proj = Proj{})
+	{
+		using D = difference_type_t<I>;
+		I const last = first + (last_ - first);
+		D const n = last - first;
+		D const k = detail::par::chunk_count(n, 1);
+		if (k <= 1) {
+			return __stl2::partition(first, last, std::ref(pred), std::ref(proj));
+		}
+		std::vector<D> mid(k);
+		detail::par::for_each_chunk(n, k, [&](std::ptrdiff_t c, D lo, D hi) {
+			mid[c] = __stl2::partition(first + lo, first + hi,
+				std::ref(pred), std::ref(proj)) - first;
+		});
+		D split = 0;
+		for (D c = 0; c < k; ++c) {
+			split += mid[c] - detail::par::chunk_bound(n, k, c);
+		}
+
+		// Misplaced elements as nonempty runs [begin, end), with the number
+		// of misplaced elements in the runs before each.
+		struct span {
+			D begin, end, offset;
+		};
+		std::vector<span> falses, trues;
+		D misplaced = 0, count = 0;
+		for (D c = 0; c < k; ++c) {
+			D const lo = detail::par::chunk_bound(n, k, c);
+			D const hi = detail::par::chunk_bound(n, k, c + 1);
+			D const end = __stl2::min(hi, split);
+			if (mid[c] < end) {
+				falses.push_back({mid[c], end, misplaced});
+				misplaced += end - mid[c];
+			}
+			D const begin = __stl2::max(lo, split);
+			if (begin < mid[c]) {
+				trues.push_back({begin, mid[c], count});
+				count += mid[c] - begin;
+			}
+		}
+		STL2_EXPECT(misplaced == count);
+		if (misplaced == 0) {
+			return first + split;
+		}
+		detail::par::parallel_for(misplaced, [&](std::ptrdiff_t, D lo, D hi) {
+			auto f = __stl2::upper_bound(falses, lo, less<>{}, &span::offset) - 1;
+			auto t = __stl2::upper_bound(trues, lo, less<>{}, &span::offset) - 1;
+			D i = f->begin + (lo - f->offset);
+			D j = t->begin + (lo - t->offset);
+			for (; lo < hi; ++lo) {
+				if (i == f->end) {
+					i = (++f)->begin;
+				}
+				if (j == t->end) {
+					j = (++t)->begin;
+				}
+				__stl2::iter_swap(first + i++, first + j++);
+			}
+		});
+		return first + split;
+	}
+
+	template <ext::ExecutionPolicy E, RandomAccessRange Rng, class Pred, class Proj = identity>
+	requires
+		SizedRange<Rng> &&
+		Permutable<iterator_t<Rng>> &&
+		IndirectUnaryPredicate<Pred, projected<iterator_t<Rng>, Proj>>
+	safe_iterator_t<Rng> partition(E&& exec, Rng&& rng, Pred pred, Proj proj = Proj{})
+	{
+		return __stl2::partition(std::forward<E>(exec),
+			__stl2::begin(rng), __stl2::begin(rng) + __stl2::distance(rng),
+			std::ref(pred), std::ref(proj));
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -33,11 +33,19 @@ STL2_OPEN_NAMESPACE {
 	{
 		__stl2::make_heap(first, middle, std::ref(comp), std::ref(proj));
 		const auto len = __stl2::distance(first, middle);
+		const bool bottom_up = detail::sift_bottom_up<I>(len);
 		I i = middle;
 		for(; i != last; ++i) {
 			if(__stl2::invoke(comp, __stl2::invoke(proj, *i), __stl2::invoke(proj, *first))) {
-				__stl2::iter_swap(i, first);
-				detail::sift_down_n(first, len, first, std::ref(comp), std::ref(proj));
+				if (bottom_up) {
+					value_type_t<I> v = __stl2::iter_move(i);
+					*i = __stl2::iter_move(first);
+					detail::sift_hole_down_n(first, len, std::move(v),
+						std::ref(comp), std::ref(proj));
+				} else {
+					__stl2::iter_swap(i, first);
+					detail::sift_down_n(first, len, first, std::ref(comp), std::ref(proj));
+				}
 			}
 		}
 		__stl2::sort_heap(first, middle, std::ref(comp), std::ref(proj));
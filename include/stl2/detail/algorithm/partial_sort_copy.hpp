@@ -13,13 +13,20 @@
 #ifndef STL2_DETAIL_ALGORITHM_PARTIAL_SORT_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_PARTIAL_SORT_COPY_HPP
 
+#include <cstdint>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/tuple.hpp>
+#include <stl2/detail/cheap_storage.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/heap_sift.hpp>
 #include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -28,6 +35,143 @@
 // partial_sort_copy [partial.sort.copy]
 //
 STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// [result_first, r) is a heap of the least elements seen so far;
+		// each further element that beats its top replaces it.
+		template <InputIterator I1, Sentinel<I1> S1,
+			RandomAccessIterator I2, Sentinel<I2> S2,
+			class Comp, class Proj1, class Proj2>
+		requires
+			IndirectlyCopyable<I1, I2> &&
+			Sortable<I2, Comp, Proj2> &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I1, Proj1>, projected<I2, Proj2>>
+		I2 heap_select_copy(I1 first, S1 last, I2 result_first, S2 result_last,
+			Comp& comp, Proj1& proj1, Proj2& proj2)
+		{
+			auto r = result_first;
+			if(r != result_last) {
+				std::tie(first, r) =
+					ext::copy(std::move(first), last, std::move(r), result_last);
+
+				__stl2::make_heap(result_first, r, std::ref(comp), std::ref(proj2));
+				const auto len = __stl2::distance(result_first, r);
+				for(; first != last; ++first) {
+					reference_t<I1>&& x = *first;
+					if(__stl2::invoke(comp, __stl2::invoke(proj1, x), __stl2::invoke(proj2, *result_first))) {
+						*result_first = std::forward<reference_t<I1>>(x);
+						detail::sift_down_n(result_first, len, result_first,
+							std::ref(comp), std::ref(proj2));
+					}
+				}
+				__stl2::sort_heap(result_first, r, std::ref(comp), std::ref(proj2));
+			}
+			return r;
+		}
+
+		// The input elements can be gathered in a buffer of value_type_t<I2>
+		// and sorted there.
+		template <class I1, class I2, class Comp, class Proj1, class Proj2>
+		concept bool BufferedTopK =
+			Constructible<value_type_t<I2>, reference_t<I1>> &&
+			Sortable<value_type_t<I2>*, Comp, Proj2> &&
+			IndirectStrictWeakOrder<Comp,
+				projected<I1, Proj1>, projected<value_type_t<I2>*, Proj2>> &&
+			IndirectlyMovable<value_type_t<I2>*, I2>;
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// top_k [Extension]
+		//
+		// partial_sort_copy for long input streams. With K the size of the
+		// output, the least elements seen so far are kept in a scratch buffer
+		// of 2K. Once the buffer has filled, its K-th least element is a
+		// threshold that rejects most later elements with one comparison. The
+		// elements that pass are appended, and each time the buffer fills it
+		// is cut back to K with nth_element. Accepting an element then costs
+		// amortized O(1) rather than the O(log K) sift of a heap, which
+		// matters when the input trends downward. Falls back to heap
+		// selection if the scratch resource can't provide more than K.
+		// partial_sort_copy itself keeps to heap selection, which allocates
+		// nothing and is as fast on random input.
+		//
+		template <InputIterator I1, Sentinel<I1> S1,
+			RandomAccessIterator I2, Sentinel<I2> S2,
+			class Comp = less<>, class Proj1 = identity, class Proj2 = identity>
+		requires
+			IndirectlyCopyable<I1, I2> &&
+			Sortable<I2, Comp, Proj2> &&
+			IndirectStrictWeakOrder<
+				Comp, projected<I1, Proj1>, projected<I2, Proj2>> &&
+			detail::BufferedTopK<I1, I2, Comp, Proj1, Proj2>
+		I2 top_k(I1 first, S1 last, I2 result_first, S2 result_last,
+			Comp comp = Comp{}, Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+		{
+			using T = value_type_t<I2>;
+			auto const k = __stl2::distance(result_first, std::move(result_last));
+			if (k == 0 || first == last) {
+				return result_first;
+			}
+
+			auto buf = detail::temporary_buffer<T>{k + __stl2::min(k, PTRDIFF_MAX - k)};
+			if (buf.size() <= k) {
+				return detail::heap_select_copy(std::move(first), std::move(last),
+					result_first, result_first + k, comp, proj1, proj2);
+			}
+			auto vec = detail::make_temporary_vector(buf);
+			auto const capacity = vec.capacity();
+
+			for (; first != last && vec.size() < capacity; ++first) {
+				vec.emplace_back(*first);
+			}
+			while (first != last) {
+				__stl2::nth_element(vec.begin(), vec.begin() + (k - 1), vec.end(),
+					std::ref(comp), std::ref(proj2));
+				vec.erase(vec.begin() + k);
+				// A copy, if cheap, which the appends can't alias.
+				const detail::cheap_reference_box_t<const T> threshold{vec[k - 1]};
+				for (; first != last; ++first) {
+					reference_t<I1>&& x = *first;
+					if (__stl2::invoke(comp, __stl2::invoke(proj1, x), __stl2::invoke(proj2, threshold.get()))) {
+						vec.emplace_back(std::forward<reference_t<I1>>(x));
+						if (vec.size() == capacity) {
+							++first;
+							break;
+						}
+					}
+				}
+			}
+
+			auto const m = __stl2::min(vec.size(), k);
+			if (vec.size() > k) {
+				__stl2::nth_element(vec.begin(), vec.begin() + k, vec.end(),
+					std::ref(comp), std::ref(proj2));
+			}
+			__stl2::sort(vec.begin(), vec.begin() + m, std::ref(comp), std::ref(proj2));
+			return __stl2::move(vec.begin(), vec.begin() + m, result_first).out();
+		}
+
+		template <InputRange Rng1, RandomAccessRange Rng2, class Comp = less<>,
+			class Proj1 = identity, class Proj2 = identity>
+		requires
+			IndirectlyCopyable<iterator_t<Rng1>, iterator_t<Rng2>> &&
+			Sortable<iterator_t<Rng2>, Comp, Proj2> &&
+			IndirectStrictWeakOrder<Comp,
+				projected<iterator_t<Rng1>, Proj1>,
+				projected<iterator_t<Rng2>, Proj2>> &&
+			detail::BufferedTopK<iterator_t<Rng1>, iterator_t<Rng2>, Comp, Proj1, Proj2>
+		safe_iterator_t<Rng2>
+		top_k(Rng1&& rng, Rng2&& result_rng, Comp comp = Comp{},
+			Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
+		{
+			return ext::top_k(
+				__stl2::begin(rng), __stl2::end(rng),
+				__stl2::begin(result_rng), __stl2::end(result_rng),
+				std::ref(comp), std::ref(proj1), std::ref(proj2));
+		}
+	}
+
 	template <InputIterator I1, Sentinel<I1> S1,
 		RandomAccessIterator I2, Sentinel<I2> S2,
 		class Comp = less<>,
@@ -40,24 +184,8 @@ STL2_OPEN_NAMESPACE {
 	I2 partial_sort_copy(I1 first, S1 last, I2 result_first, S2 result_last,
 		Comp comp = Comp{}, Proj1 proj1 = Proj1{}, Proj2 proj2 = Proj2{})
 	{
-		auto r = result_first;
-		if(r != result_last) {
-			std::tie(first, r) =
-				ext::copy(std::move(first), last, std::move(r), result_last);
-
-			__stl2::make_heap(result_first, r, std::ref(comp), std::ref(proj2));
-			const auto len = __stl2::distance(result_first, r);
-			for(; first != last; ++first) {
-				reference_t<I1>&& x = *first;
-				if(__stl2::invoke(comp, __stl2::invoke(proj1, x), __stl2::invoke(proj2, *result_first))) {
-					*result_first = std::forward<reference_t<I1>>(x);
-					detail::sift_down_n(result_first, len, result_first,
-						std::ref(comp), std::ref(proj2));
-				}
-			}
-			__stl2::sort_heap(result_first, r, std::ref(comp), std::ref(proj2));
-		}
-		return r;
+		return detail::heap_select_copy(std::move(first), std::move(last),
+			std::move(result_first), std::move(result_last), comp, proj1, proj2);
 	}
 
 	template <InputRange Rng1, RandomAccessRange Rng2, class Comp = less<>,
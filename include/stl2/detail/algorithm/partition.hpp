@@ -26,6 +26,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/find_if_not.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -77,6 +78,20 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	// Arithmetic keys make for cheap, hard to predict predicates: use the
+	// branchless block partition.
+	template <Permutable I, Sentinel<I> S, class Pred, class Proj = identity>
+	requires
+		RandomAccessIterator<I> &&
+		IndirectUnaryPredicate<
+			Pred, projected<I, Proj>> &&
+		detail::ArithmeticProjection<I, Proj>
+	I partition(I first, S last_, Pred pred, Proj proj = Proj{})
+	{
+		auto last = __stl2::next(first, std::move(last_));
+		return detail::block_partition(std::move(first), std::move(last), pred, proj);
+	}
+
 	template <ForwardRange Rng, class Pred, class Proj = identity>
 	requires
 		Permutable<iterator_t<Rng>> &&
@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/tuple.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -49,6 +50,35 @@ STL2_OPEN_NAMESPACE {
 			std::move(out_true), std::move(out_false)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O1,
+		WeaklyIncrementable O2, class Pred, class Proj = identity>
+	requires
+		IndirectlyCopyable<I, O1> &&
+		IndirectlyCopyable<I, O2> &&
+		IndirectUnaryPredicate<
+			Pred, projected<I, Proj>> &&
+		detail::simd::CompressibleRange<I, S, Pred, Proj> &&
+		detail::simd::LaneOutput<O1, I> &&
+		detail::simd::LaneOutput<O2, I>
+	tagged_tuple<tag::in(I), tag::out1(O1), tag::out2(O2)>
+	partition_copy(I first, S last, O1 out_true, O2 out_false, Pred pred,
+		Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return {std::move(first),
+				std::move(out_true), std::move(out_false)};
+		}
+		using P = detail::simd::value_predicate<Pred>;
+		auto const p = detail::addressof(*first);
+		auto const t = detail::addressof(*out_true);
+		auto const f = detail::addressof(*out_false);
+		auto const ends = detail::simd::partition<P::op>(p, p + n, t, f,
+			detail::simd::predicate_value(pred));
+		return {first + n,
+			out_true + (ends.first - t), out_false + (ends.second - f)};
+	}
+
 	template <InputRange Rng, class O1, class O2, class Pred, class Proj = identity>
 	requires
 		WeaklyIncrementable<__f<O1>> &&
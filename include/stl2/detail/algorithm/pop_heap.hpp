@@ -33,15 +33,23 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		template <RandomAccessIterator I, class Proj, class Comp>
+		template <int D = 2, RandomAccessIterator I, class Proj, class Comp>
 		requires
 			Sortable<I, Comp, Proj>
 		void pop_heap_n(I first, difference_type_t<I> n, Comp comp, Proj proj)
 		{
 			if (n > 1) {
-				__stl2::iter_swap(first, first + (n - 1));
-				detail::sift_down_n(first, n - 1, first, std::ref(comp),
-					std::ref(proj));
+				I last = first + (n - 1);
+				if (detail::sift_bottom_up<I>(n - 1)) {
+					value_type_t<I> v = __stl2::iter_move(last);
+					*last = __stl2::iter_move(first);
+					detail::sift_hole_down_n<D>(first, n - 1, std::move(v),
+						std::ref(comp), std::ref(proj));
+				} else {
+					__stl2::iter_swap(first, last);
+					detail::sift_down_n<D>(first, n - 1, first, std::ref(comp),
+						std::ref(proj));
+				}
 			}
 		}
 	}
@@ -67,6 +75,35 @@ STL2_OPEN_NAMESPACE {
 		detail::pop_heap_n(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
 		return __stl2::begin(rng) + n;
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// pop_heap<D> [Extension]
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<I, Comp, Proj>
+		I pop_heap(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(first, std::move(last));
+			detail::pop_heap_n<D>(first, n, std::ref(comp), std::ref(proj));
+			return first + n;
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		pop_heap(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(rng);
+			detail::pop_heap_n<D>(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
+			return __stl2::begin(rng) + n;
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -53,6 +53,35 @@ STL2_OPEN_NAMESPACE {
 		detail::sift_up_n(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
 		return __stl2::begin(rng) + n;
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// push_heap<D> [Extension]
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<I, Comp, Proj>
+		I push_heap(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(first, std::move(last));
+			detail::sift_up_n<D>(first, n, std::ref(comp), std::ref(proj));
+			return first + n;
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		push_heap(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(rng);
+			detail::sift_up_n<D>(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
+			return __stl2::begin(rng) + n;
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -0,0 +1,465 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/forward_sort.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// radix_sort [Extension]
+//
+// A stable radix sort for ranges ordered by less (or greater) on a key that
+// is integral, floating-point, std::byte, or a random-access sequence of
+// std::byte. Scalar keys are sorted least-significant byte first; byte
+// sequences most-significant byte first. Keys are extracted once into a
+// temporary buffer alongside each element's original position, and the
+// elements are moved into their final positions at the end.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace radix {
+			// key_traits<T>::encode maps T onto an unsigned integer type such
+			// that unsigned comparison of the images agrees with less<T>.
+			template <class T>
+			struct key_traits {};
+
+			template <UnsignedIntegral T>
+			struct key_traits<T> {
+				using type = T;
+				static constexpr type encode(T t) noexcept { return t; }
+				static constexpr T decode(type u) noexcept { return u; }
+			};
+
+			template <SignedIntegral T>
+			struct key_traits<T> {
+				using type = make_unsigned_t<T>;
+				static constexpr type sign = type(1) << (std::numeric_limits<type>::digits - 1);
+				static constexpr type encode(T t) noexcept { return type(t) ^ sign; }
+				static constexpr T decode(type u) noexcept { return T(u ^ sign); }
+			};
+
+			template <>
+			struct key_traits<bool> {
+				using type = unsigned char;
+				static constexpr type encode(bool b) noexcept { return b; }
+				static constexpr bool decode(type u) noexcept { return u != 0; }
+			};
+
+#ifdef __cpp_lib_byte
+			template <>
+			struct key_traits<std::byte> {
+				using type = unsigned char;
+				static constexpr type encode(std::byte b) noexcept {
+					return std::to_integer<type>(b);
+				}
+				static constexpr std::byte decode(type u) noexcept {
+					return std::byte{u};
+				}
+			};
+#endif
+
+			// IEEE 754 keys: flip all bits of negatives and the sign bit of
+			// positives. Negative zero is folded onto positive zero since the
+			// two are equivalent; there is no decode, as that would not
+			// round-trip.
+			template <ext::FloatingPoint T>
+			requires
+				std::numeric_limits<T>::is_iec559 &&
+				(sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t))
+			struct key_traits<T> {
+				using type = meta::if_c<sizeof(T) == sizeof(std::uint32_t),
+					std::uint32_t, std::uint64_t>;
+				static constexpr type sign = type(1) << (std::numeric_limits<type>::digits - 1);
+				static type encode(T t) noexcept {
+					type u = 0;
+					if (t != T(0)) {
+						std::memcpy(&u, &t, sizeof(u));
+					}
+					return (u & sign) ? type(~u) : type(u | sign);
+				}
+			};
+
+			template <class T>
+			concept bool ScalarKey =
+				requires { typename key_traits<T>::type; };
+
+			template <class T>
+			concept bool DecodableKey =
+				ScalarKey<T> &&
+				requires(typename key_traits<T>::type u) {
+					{ key_traits<T>::decode(u) } -> Same<T>;
+				};
+
+#ifdef __cpp_lib_byte
+			template <class K>
+			concept bool ByteSequence =
+				!ScalarKey<K> &&
+				RandomAccessRange<const K> &&
+				SizedRange<const K> &&
+				Same<value_type_t<iterator_t<const K>>, std::byte>;
+#else
+			template <class>
+			concept bool ByteSequence = false;
+#endif
+
+			template <class I, class Proj>
+			using key_t = value_type_t<projected<I, Proj>>;
+
+			template <class I, class Comp, class Proj>
+			concept bool ScalarSortable =
+				Sortable<I, Comp, Proj> &&
+				ScalarKey<key_t<I, Proj>> &&
+				__bool<simd::is_less<Comp> || simd::is_greater<Comp>>;
+
+			// The key is the element itself, so there is nothing to carry
+			// along but the key.
+			template <class I, class Comp, class Proj>
+			concept bool DirectSortable =
+				ScalarSortable<I, Comp, Proj> &&
+				DecodableKey<value_type_t<I>> &&
+				Same<key_t<I, Proj>, value_type_t<I>> &&
+				__bool<simd::is_identity<Proj>>;
+
+			// Byte sequences are compared in place, so the projection must
+			// yield a reference into the element.
+			template <class I, class Comp, class Proj>
+			concept bool SequenceSortable =
+				Sortable<I, Comp, Proj> &&
+				ByteSequence<key_t<I, Proj>> &&
+				__bool<simd::is_less<Comp>> &&
+				_Is<reference_t<projected<I, Proj>>, is_lvalue_reference>;
+
+			// Below this size sort and stable_sort stay with comparisons.
+			constexpr std::ptrdiff_t sort_threshold = 256;
+
+			// Byte-sequence buckets below this size are insertion sorted.
+			constexpr std::ptrdiff_t msd_insertion_threshold = 32;
+
+			template <class U, class X>
+			struct item {
+				U key;
+				X index;
+			};
+
+			template <class X>
+			X& index_of(X& x) noexcept { return x; }
+			template <class U, class X>
+			X& index_of(item<U, X>& t) noexcept { return t.index; }
+
+			template <class U>
+			U key_of(U u) noexcept { return u; }
+			template <class U, class X>
+			U key_of(const item<U, X>& t) noexcept { return t.key; }
+
+			template <class K, bool Descending>
+			auto image(const K& k) noexcept {
+				using U = typename key_traits<K>::type;
+				U u = key_traits<K>::encode(k);
+				return Descending ? U(~u) : u;
+			}
+
+			// Least-significant digit first counting sort on 8-bit digits,
+			// ping-ponging between src and dst. Digits on which every key
+			// agrees are skipped. Returns whichever buffer holds the result.
+			template <class T>
+			T* lsd_sort(T* src, T* dst, std::ptrdiff_t n)
+			{
+				using U = decltype(radix::key_of(*src));
+				constexpr int digits = sizeof(U);
+				std::ptrdiff_t counts[digits][256] = {};
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					U const k = radix::key_of(src[i]);
+					for (int d = 0; d < digits; ++d) {
+						++counts[d][(k >> (8 * d)) & 0xff];
+					}
+				}
+				for (int d = 0; d < digits; ++d) {
+					auto& c = counts[d];
+					int const shift = 8 * d;
+					if (c[(radix::key_of(src[0]) >> shift) & 0xff] == n) {
+						continue;
+					}
+					std::ptrdiff_t sum = 0;
+					for (auto& count : c) {
+						auto const tmp = count;
+						count = sum;
+						sum += tmp;
+					}
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						dst[c[(radix::key_of(src[i]) >> shift) & 0xff]++] = src[i];
+					}
+					std::swap(src, dst);
+				}
+				return src;
+			}
+
+			template <class K>
+			unsigned byte_at(const K& k, std::ptrdiff_t depth)
+			{
+				return depth < __stl2::distance(k)
+					? 1 + static_cast<unsigned>(__stl2::begin(k)[depth])
+					: 0;
+			}
+
+			template <class K>
+			bool suffix_less(const K& x, const K& y, std::ptrdiff_t depth)
+			{
+				auto const nx = __stl2::distance(x);
+				auto const ny = __stl2::distance(y);
+				auto const bx = __stl2::begin(x);
+				auto const by = __stl2::begin(y);
+				for (; depth < nx && depth < ny; ++depth) {
+					if (bx[depth] != by[depth]) {
+						return bx[depth] < by[depth];
+					}
+				}
+				return nx < ny;
+			}
+
+			// Most-significant digit first sort of the positions a[0, n) by
+			// the byte sequences keys[a[i]], all of which share their first
+			// depth bytes. Bucket 0 collects the keys that end at depth.
+			// Recursion is limited to the smaller buckets; the largest is
+			// handled by the loop, bounding the stack depth by log2(n).
+			template <class K, class X>
+			void msd_sort(const K* const* keys, X* a, X* tmp,
+				std::ptrdiff_t n, std::ptrdiff_t depth)
+			{
+				while (n >= msd_insertion_threshold) {
+					std::ptrdiff_t counts[257] = {};
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						++counts[radix::byte_at(*keys[a[i]], depth)];
+					}
+					unsigned const first_bucket = radix::byte_at(*keys[a[0]], depth);
+					if (counts[first_bucket] == n) {
+						if (first_bucket == 0) {
+							return;
+						}
+						++depth;
+						continue;
+					}
+
+					std::ptrdiff_t starts[257];
+					std::ptrdiff_t sum = 0;
+					for (int b = 0; b < 257; ++b) {
+						starts[b] = sum;
+						sum += counts[b];
+					}
+					std::ptrdiff_t next[257];
+					std::memcpy(next, starts, sizeof(next));
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						tmp[next[radix::byte_at(*keys[a[i]], depth)]++] = a[i];
+					}
+					std::memcpy(a, tmp, n * sizeof(X));
+
+					int largest = 1;
+					for (int b = 2; b < 257; ++b) {
+						if (counts[b] > counts[largest]) {
+							largest = b;
+						}
+					}
+					for (int b = 1; b < 257; ++b) {
+						if (b != largest && counts[b] > 1) {
+							radix::msd_sort(keys, a + starts[b], tmp + starts[b],
+								counts[b], depth + 1);
+						}
+					}
+					a += starts[largest];
+					tmp += starts[largest];
+					n = counts[largest];
+					++depth;
+				}
+
+				for (std::ptrdiff_t i = 1; i < n; ++i) {
+					X const x = a[i];
+					std::ptrdiff_t j = i;
+					for (; j > 0 && radix::suffix_less(*keys[x], *keys[a[j - 1]], depth); --j) {
+						a[j] = a[j - 1];
+					}
+					a[j] = x;
+				}
+			}
+
+			// Rearranges [first, first + n) so that position i receives the
+			// element originally at position index_of(order[i]).
+			template <RandomAccessIterator I, class T>
+			requires
+				Permutable<I>
+			void apply_permutation(I first, std::ptrdiff_t n, T* order)
+			{
+				using V = value_type_t<I>;
+				auto buf = temporary_buffer<V>{n};
+				if (buf.size() >= n) {
+					auto vec = detail::make_temporary_vector(buf);
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						vec.emplace_back(__stl2::iter_move(first + radix::index_of(order[i])));
+					}
+					__stl2::move(vec.begin(), vec.end(), first);
+					return;
+				}
+
+				// Not enough memory to gather: follow the cycles in place,
+				// marking settled positions with index_of(order[i]) == i.
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					std::ptrdiff_t j = radix::index_of(order[i]);
+					if (j == i) {
+						continue;
+					}
+					V tmp = __stl2::iter_move(first + i);
+					std::ptrdiff_t k = i;
+					do {
+						*(first + k) = __stl2::iter_move(first + j);
+						radix::index_of(order[k]) = k;
+						k = j;
+						j = radix::index_of(order[k]);
+					} while (j != i);
+					*(first + k) = std::move(tmp);
+					radix::index_of(order[k]) = k;
+				}
+			}
+
+			template <class X, RandomAccessIterator I, class Comp, class Proj>
+			requires
+				ScalarSortable<I, Comp, Proj>
+			bool sort_indexed(I first, std::ptrdiff_t n, Proj& proj)
+			{
+				using K = key_t<I, Proj>;
+				using T = item<typename key_traits<K>::type, X>;
+				constexpr bool descending = simd::is_greater<Comp>;
+				auto buf = temporary_buffer<T>{2 * n};
+				if (buf.size() < 2 * n) {
+					return false;
+				}
+				T* a = buf.data();
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					a[i] = T{radix::image<K, descending>(
+						__stl2::invoke(proj, *(first + i))), X(i)};
+				}
+				a = radix::lsd_sort(a, buf.data() + n, n);
+				radix::apply_permutation(first, n, a);
+				return true;
+			}
+
+			template <class X, RandomAccessIterator I, class Comp, class Proj>
+			requires
+				SequenceSortable<I, Comp, Proj>
+			bool sort_indexed(I first, std::ptrdiff_t n, Proj& proj)
+			{
+				using K = key_t<I, Proj>;
+				auto keys = temporary_buffer<const K*>{n};
+				auto order = temporary_buffer<X>{2 * n};
+				if (keys.size() < n || order.size() < 2 * n) {
+					return false;
+				}
+				X* a = order.data();
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					keys.data()[i] = std::addressof(__stl2::invoke(proj, *(first + i)));
+					a[i] = X(i);
+				}
+				radix::msd_sort(keys.data(), a, a + n, n, 0);
+				radix::apply_permutation(first, n, a);
+				return true;
+			}
+
+			// Sorts [first, first + n) if scratch memory is available;
+			// returns false without modifying the range otherwise.
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				ScalarSortable<I, Comp, Proj> || SequenceSortable<I, Comp, Proj>
+			bool sort_n(I first, difference_type_t<I> n, Comp&, Proj& proj)
+			{
+				if (n < 2) {
+					return true;
+				}
+				// 32-bit positions keep the scratch footprint down.
+				if (static_cast<std::uintmax_t>(n) <= std::numeric_limits<std::uint32_t>::max()) {
+					return radix::sort_indexed<std::uint32_t, I, Comp>(first, n, proj);
+				}
+				return radix::sort_indexed<std::size_t, I, Comp>(first, n, proj);
+			}
+
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				DirectSortable<I, Comp, Proj>
+			bool sort_n(I first, difference_type_t<I> n, Comp&, Proj&)
+			{
+				if (n < 2) {
+					return true;
+				}
+				using K = value_type_t<I>;
+				using U = typename key_traits<K>::type;
+				constexpr bool descending = simd::is_greater<Comp>;
+				auto buf = temporary_buffer<U>{2 * n};
+				if (buf.size() < 2 * n) {
+					return false;
+				}
+				U* a = buf.data();
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					a[i] = radix::image<K, descending>(*(first + i));
+				}
+				a = radix::lsd_sort(a, buf.data() + n, n);
+				for (std::ptrdiff_t i = 0; i < n; ++i) {
+					*(first + i) = key_traits<K>::decode(descending ? U(~a[i]) : a[i]);
+				}
+				return true;
+			}
+		}
+	}
+
+	namespace ext {
+		template <class I, class Comp, class Proj>
+		concept bool RadixSortable =
+			RandomAccessIterator<I> &&
+			(detail::radix::ScalarSortable<I, Comp, Proj> ||
+				detail::radix::SequenceSortable<I, Comp, Proj>);
+
+		template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
+			class Proj = identity>
+		requires
+			RadixSortable<I, Comp, Proj>
+		I radix_sort(I first, S sent, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto last = __stl2::next(first, std::move(sent));
+			auto n = difference_type_t<I>(last - first);
+			if (!detail::radix::sort_n(first, n, comp, proj)) {
+				// Out of scratch memory; the forward merge sort is stable
+				// and copes without a buffer.
+				detail::fsort::sort_n(std::move(first), n,
+					std::ref(comp), std::ref(proj));
+			}
+			return last;
+		}
+
+		template <RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			RadixSortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		radix_sort(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			return ext::radix_sort(__stl2::begin(rng), __stl2::end(rng),
+				std::ref(comp), std::ref(proj));
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -10,6 +10,31 @@
 //
 // Project home: https://github.com/caseycarter/cmcstl2
 //
+//===----------------------------------------------------------------------===//
+//
+// The pattern-defeating quicksort engine is derived from pdqsort:
+//
+//  Copyright (c) 2015 Orson Peters
+//
+//  This software is provided 'as-is', without any express or implied
+//  warranty. In no event will the authors be held liable for any damages
+//  arising from the use of this software.
+//
+//  Permission is granted to anyone to use this software for any purpose,
+//  including commercial applications, and to alter it and redistribute it
+//  freely, subject to the following restrictions:
+//
+//  1. The origin of this software must not be misrepresented; you must not
+//     claim that you wrote the original software. If you use this software
+//     in a product, an acknowledgment in the product documentation would be
+//     appreciated but is not required.
+//  2. Altered source versions must be plainly marked as such, and must not
+//     be misrepresented as being the original software.
+//  3. This notice may not be removed or altered from any source
+//     distribution.
+//
+//===----------------------------------------------------------------------===//
+//
 #ifndef STL2_DETAIL_ALGORITHM_RANDOM_ACCESS_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_RANDOM_ACCESS_SORT_HPP
 
@@ -27,48 +52,148 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		namespace rsort {
-			template <RandomAccessIterator I, class Comp, class Proj>
-			requires
-				Sortable<I, Comp, Proj>
-			I choose_pivot(I first, I last, Comp& comp, Proj& proj)
-			{
-				STL2_EXPECT(first != last);
-				I mid = first + difference_type_t<I>(last - first) / 2;
-				--last;
-				// Find the median:
-				return [&](auto&& a, auto&& b, auto&& c) {
-					return __stl2::invoke(comp, a, b)
-						? (__stl2::invoke(comp, b, c) ? mid   : (__stl2::invoke(comp, a, c) ? last : first))
-						: (__stl2::invoke(comp, a, c) ? first : (__stl2::invoke(comp, b, c) ? last : mid  ));
-				}(__stl2::invoke(proj, *first), __stl2::invoke(proj, *mid), __stl2::invoke(proj, *last));
+		///////////////////////////////////////////////////////////////////////
+		// Branchless block partitioning, after "BlockQuicksort: How Branch
+		// Mispredictions don't affect Quicksort" (Edelkamp and Weiss, 2016).
+		// Rather than branching on each predicate result, the positions of
+		// misplaced elements are recorded into small offset buffers with
+		// branch-free code, and then swapped in bulk. It pays off when the
+		// predicate itself is cheap and unpredictable, e.g. comparing
+		// arithmetic keys.
+		//
+		template <class I, class Proj>
+		concept bool ArithmeticProjection =
+			ext::Arithmetic<value_type_t<projected<I, Proj>>>;
+
+		// Comparison function objects that compile to a single instruction
+		// when applied to arithmetic keys.
+		template <class>
+		constexpr bool is_cheap_ordering = false;
+		template <class T>
+		constexpr bool is_cheap_ordering<less<T>> = true;
+		template <class T>
+		constexpr bool is_cheap_ordering<greater<T>> = true;
+		template <class T>
+		constexpr bool is_cheap_ordering<std::less<T>> = true;
+		template <class T>
+		constexpr bool is_cheap_ordering<std::greater<T>> = true;
+		template <class C>
+		constexpr bool is_cheap_ordering<std::reference_wrapper<C>> =
+			is_cheap_ordering<std::remove_cv_t<C>>;
+
+		template <class I, class Comp, class Proj>
+		concept bool BranchlessSortable =
+			Sortable<I, Comp, Proj> &&
+			ArithmeticProjection<I, Proj> &&
+			__bool<is_cheap_ordering<Comp>>;
+
+		constexpr std::ptrdiff_t block_partition_size = 64;
+
+		// Exchanges the n elements at first + offsets_l[i] with those at
+		// last - offsets_r[i]. Uses a cyclic permutation (one move per
+		// element instead of three) unless the blocks were equally full,
+		// where swaps keep the reverse-sorted case linear.
+		template <RandomAccessIterator I>
+		requires
+			Permutable<I>
+		void block_partition_swap(I first, I last, unsigned char const* offsets_l,
+			unsigned char const* offsets_r, difference_type_t<I> n, bool use_swaps)
+		{
+			if (use_swaps) {
+				for (difference_type_t<I> i = 0; i < n; ++i) {
+					__stl2::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+				}
+			} else if (n > 0) {
+				I l = first + offsets_l[0];
+				I r = last - offsets_r[0];
+				value_type_t<I> tmp = __stl2::iter_move(l);
+				*l = __stl2::iter_move(r);
+				for (difference_type_t<I> i = 1; i < n; ++i) {
+					l = first + offsets_l[i];
+					*r = __stl2::iter_move(l);
+					r = last - offsets_r[i];
+					*l = __stl2::iter_move(r);
+				}
+				*r = std::move(tmp);
 			}
+		}
 
-			template <RandomAccessIterator I, class Comp, class Proj>
-			requires
-				Sortable<I, Comp, Proj>
-			I unguarded_partition(I first, I last, Comp& comp, Proj& proj)
-			{
-				I pivot_pnt = rsort::choose_pivot(first, last, comp, proj);
+		// Reorders [first, last) so that the elements satisfying pred precede
+		// those that do not, and returns the partition point. Applies pred
+		// exactly once per element.
+		template <RandomAccessIterator I, class Pred, class Proj>
+		requires
+			Permutable<I> &&
+			IndirectUnaryPredicate<Pred, projected<I, Proj>>
+		I block_partition(I first, I last, Pred& pred, Proj& proj)
+		{
+			using D = difference_type_t<I>;
+			unsigned char offsets_l[block_partition_size];
+			unsigned char offsets_r[block_partition_size];
+			I base_l = first;
+			I base_r = last;
+			D num_l = 0, num_r = 0, start_l = 0, start_r = 0;
 
-				// Do the partition:
-				while (true) {
-					auto &&v = *pivot_pnt;
-					auto &&pivot = __stl2::invoke(proj, (decltype(v) &&)v);
-					while (__stl2::invoke(comp, __stl2::invoke(proj, *first), pivot)) {
-						++first;
-					}
-					while (__stl2::invoke(comp, pivot, __stl2::invoke(proj, *--last))) {
-						;
-					}
-					if (!(first < last)) {
-						return first;
-					}
-					__stl2::iter_swap(first, last);
-					pivot_pnt = pivot_pnt == first ? last : (pivot_pnt == last ? first : pivot_pnt);
+			while (first < last) {
+				// Refill whichever offset blocks are empty, splitting the
+				// unexamined elements between them when both are.
+				D const unknown = last - first;
+				D left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+				D right_split = num_r == 0 ? unknown - left_split : 0;
+				if (left_split > block_partition_size) {
+					left_split = block_partition_size;
+				}
+				if (right_split > block_partition_size) {
+					right_split = block_partition_size;
+				}
+
+				for (D i = 0; i < left_split; ++i, ++first) {
+					offsets_l[num_l] = static_cast<unsigned char>(i);
+					num_l += !__stl2::invoke(pred, __stl2::invoke(proj, *first));
+				}
+				for (D i = 0; i < right_split;) {
+					offsets_r[num_r] = static_cast<unsigned char>(++i);
+					num_r += bool(__stl2::invoke(pred, __stl2::invoke(proj, *--last)));
+				}
+
+				D const n = num_l < num_r ? num_l : num_r;
+				detail::block_partition_swap(base_l, base_r,
+					offsets_l + start_l, offsets_r + start_r, n, num_l == num_r);
+				num_l -= n;
+				num_r -= n;
+				start_l += n;
+				start_r += n;
+				if (num_l == 0) {
+					start_l = 0;
+					base_l = first;
+				}
+				if (num_r == 0) {
+					start_r = 0;
+					base_r = last;
+				}
+			}
+
+			// At most one block still holds misplaced elements; move them to
+			// the boundary.
+			if (num_l != 0) {
+				while (num_l-- != 0) {
+					__stl2::iter_swap(base_l + offsets_l[start_l + num_l], --last);
+				}
+				first = last;
+			}
+			if (num_r != 0) {
+				while (num_r-- != 0) {
+					__stl2::iter_swap(base_r - offsets_r[start_r + num_r], first);
 					++first;
 				}
 			}
+			return first;
+		}
+
+		namespace rsort {
+			constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+			constexpr std::ptrdiff_t ninther_threshold = 128;
+			constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
 
 			template <BidirectionalIterator I, class Comp, class Proj>
 			requires
@@ -120,7 +245,235 @@ STL2_OPEN_NAMESPACE {
 				}
 			}
 
-			constexpr std::ptrdiff_t introsort_threshold = 16;
+			// Insertion sort [first, last), bailing out with false once more
+			// than partial_insertion_sort_limit elements have been moved.
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			bool partial_insertion_sort(I first, I last, Comp& comp, Proj& proj)
+			{
+				if (first == last) {
+					return true;
+				}
+				difference_type_t<I> moved = 0;
+				for (I cur = __stl2::next(first); cur != last; ++cur) {
+					I sift = cur;
+					I sift_1 = __stl2::prev(cur);
+					if (__stl2::invoke(comp, __stl2::invoke(proj, *sift), __stl2::invoke(proj, *sift_1))) {
+						value_type_t<I> tmp = __stl2::iter_move(sift);
+						do {
+							*sift = __stl2::iter_move(sift_1);
+							--sift;
+						} while (sift != first &&
+							__stl2::invoke(comp, __stl2::invoke(proj, tmp), __stl2::invoke(proj, *--sift_1)));
+						*sift = std::move(tmp);
+						moved += cur - sift;
+						if (moved > partial_insertion_sort_limit) {
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			void sort2(I a, I b, Comp& comp, Proj& proj)
+			{
+				if (__stl2::invoke(comp, __stl2::invoke(proj, *b), __stl2::invoke(proj, *a))) {
+					__stl2::iter_swap(a, b);
+				}
+			}
+
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			void sort3(I a, I b, I c, Comp& comp, Proj& proj)
+			{
+				rsort::sort2(a, b, comp, proj);
+				rsort::sort2(b, c, comp, proj);
+				rsort::sort2(a, b, comp, proj);
+			}
+
+			// Moves the median of three - or for large ranges, the pseudomedian
+			// of nine ("ninther") - elements of [first, last) to *first. The
+			// median-of-three choice leaves *(last - 1) not less than the pivot,
+			// which guards the upward scan in partition_right.
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			void choose_pivot(I first, I last, Comp& comp, Proj& proj)
+			{
+				auto const size = difference_type_t<I>(last - first);
+				auto const half = difference_type_t<I>(size / 2);
+				if (size > ninther_threshold) {
+					rsort::sort3(first, first + half, last - 1, comp, proj);
+					rsort::sort3(first + 1, first + (half - 1), last - 2, comp, proj);
+					rsort::sort3(first + 2, first + (half + 1), last - 3, comp, proj);
+					rsort::sort3(first + (half - 1), first + half, first + (half + 1), comp, proj);
+					__stl2::iter_swap(first, first + half);
+				} else {
+					rsort::sort3(first + half, first, last - 1, comp, proj);
+				}
+			}
+
+			// Completes partition_right given the first misplaced pair *lo and
+			// *hi, with lo < hi. Returns the start of the right-hand partition.
+			template <RandomAccessIterator I, class Comp, class Proj, class T>
+			requires
+				Sortable<I, Comp, Proj>
+			I partition_right_loop(I lo, I hi, Comp& comp, Proj& proj, T& p)
+			{
+				while (lo < hi) {
+					__stl2::iter_swap(lo, hi);
+					while (__stl2::invoke(comp, __stl2::invoke(proj, *++lo), p)) {
+						;
+					}
+					while (!__stl2::invoke(comp, __stl2::invoke(proj, *--hi), p)) {
+						;
+					}
+				}
+				return lo;
+			}
+
+			template <RandomAccessIterator I, class Comp, class Proj, class T>
+			requires
+				BranchlessSortable<I, Comp, Proj>
+			I partition_right_loop(I lo, I hi, Comp& comp, Proj& proj, T& p)
+			{
+				if (lo < hi) {
+					__stl2::iter_swap(lo, hi);
+					auto pred = [&](auto&& x) {
+						return __stl2::invoke(comp, std::forward<decltype(x)>(x), p);
+					};
+					lo = detail::block_partition(lo + 1, hi, pred, proj);
+				}
+				return lo;
+			}
+
+			// Partitions [first, last) around the pivot *first so that elements
+			// equivalent to the pivot end up in the right-hand partition.
+			// Requires an element not less than the pivot in [first + 1, last).
+			// Returns the final position of the pivot, and whether the range
+			// was already partitioned (no swaps were performed).
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			pair<I, bool> partition_right(I first, I last, Comp& comp, Proj& proj)
+			{
+				value_type_t<I> pivot = __stl2::iter_move(first);
+				auto&& p = __stl2::invoke(proj, pivot);
+				I lo = first;
+				I hi = last;
+
+				// Find the first element not less than the pivot (guarded by
+				// the choice of pivot)...
+				while (__stl2::invoke(comp, __stl2::invoke(proj, *++lo), p)) {
+					;
+				}
+				// ...and the last element less than the pivot. The downward
+				// scan needs a guard only if no element was skipped above.
+				if (lo - 1 == first) {
+					while (lo < hi && !__stl2::invoke(comp, __stl2::invoke(proj, *--hi), p)) {
+						;
+					}
+				} else {
+					while (!__stl2::invoke(comp, __stl2::invoke(proj, *--hi), p)) {
+						;
+					}
+				}
+
+				bool const already_partitioned = !(lo < hi);
+				lo = rsort::partition_right_loop(lo, hi, comp, proj, p);
+
+				I pivot_pos = lo - 1;
+				if (pivot_pos != first) {
+					*first = __stl2::iter_move(pivot_pos);
+				}
+				*pivot_pos = std::move(pivot);
+				return {pivot_pos, already_partitioned};
+			}
+
+			// Partitions [first, last) around the pivot *first so that elements
+			// equivalent to the pivot end up in the left-hand partition. Used
+			// when the pivot is known to be equivalent to the element preceding
+			// first; everything in [first, result] is then equivalent and needs
+			// no further sorting. Returns the final position of the pivot.
+			template <RandomAccessIterator I, class Comp, class Proj>
+			requires
+				Sortable<I, Comp, Proj>
+			I partition_left(I first, I last, Comp& comp, Proj& proj)
+			{
+				value_type_t<I> pivot = __stl2::iter_move(first);
+				auto&& p = __stl2::invoke(proj, pivot);
+				I lo = first;
+				I hi = last;
+
+				while (__stl2::invoke(comp, p, __stl2::invoke(proj, *--hi))) {
+					;
+				}
+				if (hi + 1 == last) {
+					while (lo < hi && !__stl2::invoke(comp, p, __stl2::invoke(proj, *++lo))) {
+						;
+					}
+				} else {
+					while (!__stl2::invoke(comp, p, __stl2::invoke(proj, *++lo))) {
+						;
+					}
+				}
+
+				while (lo < hi) {
+					__stl2::iter_swap(lo, hi);
+					while (__stl2::invoke(comp, p, __stl2::invoke(proj, *--hi))) {
+						;
+					}
+					while (!__stl2::invoke(comp, p, __stl2::invoke(proj, *++lo))) {
+						;
+					}
+				}
+
+				I pivot_pos = hi;
+				if (pivot_pos != first) {
+					*first = __stl2::iter_move(pivot_pos);
+				}
+				*pivot_pos = std::move(pivot);
+				return pivot_pos;
+			}
+
+			// Swaps a few elements of each side of a badly unbalanced partition
+			// into new positions to break up patterns that defeat the pivot
+			// selection.
+			template <RandomAccessIterator I>
+			requires
+				Permutable<I>
+			void break_patterns(I first, I pivot_pos, I last)
+			{
+				auto const l_size = difference_type_t<I>(pivot_pos - first);
+				auto const r_size = difference_type_t<I>(last - (pivot_pos + 1));
+				if (l_size >= insertion_sort_threshold) {
+					auto const q = difference_type_t<I>(l_size / 4);
+					__stl2::iter_swap(first, first + q);
+					__stl2::iter_swap(pivot_pos - 1, pivot_pos - q);
+					if (l_size > ninther_threshold) {
+						__stl2::iter_swap(first + 1, first + (q + 1));
+						__stl2::iter_swap(first + 2, first + (q + 2));
+						__stl2::iter_swap(pivot_pos - 2, pivot_pos - (q + 1));
+						__stl2::iter_swap(pivot_pos - 3, pivot_pos - (q + 2));
+					}
+				}
+				if (r_size >= insertion_sort_threshold) {
+					auto const q = difference_type_t<I>(r_size / 4);
+					__stl2::iter_swap(pivot_pos + 1, pivot_pos + (1 + q));
+					__stl2::iter_swap(last - 1, last - q);
+					if (r_size > ninther_threshold) {
+						__stl2::iter_swap(pivot_pos + 2, pivot_pos + (2 + q));
+						__stl2::iter_swap(pivot_pos + 3, pivot_pos + (3 + q));
+						__stl2::iter_swap(last - 2, last - (1 + q));
+						__stl2::iter_swap(last - 3, last - (2 + q));
+					}
+				}
+			}
 
 			Integral{I}
 			constexpr auto log2(I n) {
@@ -132,33 +485,72 @@ STL2_OPEN_NAMESPACE {
 				return k;
 			}
 
+			// Pattern-defeating quicksort (Orson Peters, 2016): introsort that
+			// detects already-partitioned and equal-element ranges, and
+			// shuffles to break adversarial patterns. After bad_allowed badly
+			// unbalanced partitions it falls back to heapsort. leftmost is
+			// false iff *(first - 1) is a lower bound for [first, last).
 			template <RandomAccessIterator I, class Comp, class Proj>
 			requires
 				Sortable<I, Comp, Proj>
-			void introsort_loop(I first, I last, difference_type_t<I> depth_limit,
-				Comp& comp, Proj& proj)
+			void pdqsort_loop(I first, I last, difference_type_t<I> bad_allowed,
+				Comp& comp, Proj& proj, bool leftmost = true)
 			{
-				while (__stl2::distance(first, last) > introsort_threshold) {
-					if (depth_limit == 0) {
-						__stl2::partial_sort(first, last, last, std::ref(comp), std::ref(proj));
+				while (true) {
+					auto const size = difference_type_t<I>(last - first);
+					if (size < insertion_sort_threshold) {
+						if (leftmost) {
+							rsort::insertion_sort(first, last, comp, proj);
+						} else {
+							rsort::unguarded_insertion_sort(first, last, comp, proj);
+						}
+						return;
+					}
+
+					rsort::choose_pivot(first, last, comp, proj);
+
+					// If the pivot is equivalent to the element before this range,
+					// it is the smallest value in the range: put everything
+					// equivalent to it on the left and skip over it.
+					if (!leftmost &&
+						!__stl2::invoke(comp, __stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+						first = rsort::partition_left(first, last, comp, proj);
+						++first;
+						continue;
+					}
+
+					auto const part = rsort::partition_right(first, last, comp, proj);
+					I pivot_pos = part.first;
+					auto const l_size = difference_type_t<I>(pivot_pos - first);
+					auto const r_size = difference_type_t<I>(last - (pivot_pos + 1));
+
+					if (l_size < size / 8 || r_size < size / 8) {
+						if (--bad_allowed == 0) {
+							__stl2::partial_sort(first, last, last, std::ref(comp), std::ref(proj));
+							return;
+						}
+						rsort::break_patterns(first, pivot_pos, last);
+					} else if (part.second &&
+						rsort::partial_insertion_sort(first, pivot_pos, comp, proj) &&
+						rsort::partial_insertion_sort(pivot_pos + 1, last, comp, proj)) {
+						// Likely an already (nearly) sorted input.
 						return;
 					}
-					I cut = rsort::unguarded_partition(first, last, comp, proj);
-					rsort::introsort_loop(cut, last, --depth_limit, comp, proj);
-					last = cut;
+
+					rsort::pdqsort_loop(first, pivot_pos, bad_allowed, comp, proj, leftmost);
+					first = pivot_pos + 1;
+					leftmost = false;
 				}
 			}
 
 			template <RandomAccessIterator I, class Comp, class Proj>
 			requires
 				Sortable<I, Comp, Proj>
-			void final_insertion_sort(I first, I last, Comp &comp, Proj &proj)
+			void pdqsort(I first, I last, Comp& comp, Proj& proj)
 			{
-				if (__stl2::distance(first, last) > introsort_threshold) {
-					rsort::insertion_sort(first, first + introsort_threshold, comp, proj);
-					rsort::unguarded_insertion_sort(first + introsort_threshold, last, comp, proj);
-				} else {
-					rsort::insertion_sort(first, last, comp, proj);
+				auto const n = difference_type_t<I>(last - first);
+				if (n > 1) {
+					rsort::pdqsort_loop(first, last, rsort::log2(n), comp, proj);
 				}
 			}
 		}
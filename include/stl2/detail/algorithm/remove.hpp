@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -42,6 +43,25 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <ForwardIterator I, Sentinel<I> S, class T, class Proj = identity>
+	requires
+		Permutable<I> &&
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::simd::LaneRange<I, S, Proj> &&
+		Integral<value_type_t<I>> && Integral<T>
+	I remove(I first, S last, const T& value, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		value_type_t<I> v;
+		if (n == 0 || !detail::simd::to_element(value, v)) {
+			return first + n;
+		}
+		auto const p = detail::addressof(*first);
+		return first + (detail::simd::select<true, detail::simd::cmp::eq>(
+			p, p + n, p, v, false) - p);
+	}
+
 	template <ForwardRange Rng, class T, class Proj = identity>
 	requires
 		Permutable<iterator_t<Rng>> &&
@@ -14,6 +14,7 @@
 
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -41,6 +42,34 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O,
+		class T, class Proj = identity>
+	requires
+		IndirectlyCopyable<I, O> &&
+		IndirectRelation<
+			equal_to<>, projected<I, Proj>, const T*> &&
+		detail::simd::LaneRange<I, S, Proj> &&
+		detail::simd::LaneOutput<O, I> &&
+		Integral<value_type_t<I>> && Integral<T>
+	tagged_pair<tag::in(I), tag::out(O)>
+	remove_copy(I first, S last, O result, const T& value, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return {std::move(first), std::move(result)};
+		}
+		value_type_t<I> v;
+		if (!detail::simd::to_element(value, v)) {
+			detail::mem::copy(first, n, result);
+			return {first + n, result + n};
+		}
+		auto const p = detail::addressof(*first);
+		auto const out = detail::addressof(*result);
+		auto const k = detail::simd::select<false, detail::simd::cmp::eq>(
+			p, p + n, out, v, false) - out;
+		return {first + n, result + k};
+	}
+
 	template <InputRange Rng, class O, class T, class Proj = identity>
 	requires
 		WeaklyIncrementable<__f<O>> &&
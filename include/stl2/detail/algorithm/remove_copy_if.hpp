@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -42,6 +43,29 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O, class Pred,
+		class Proj = identity>
+	requires
+		IndirectlyCopyable<I, O> &&
+		IndirectUnaryPredicate<
+			Pred, projected<I, Proj>> &&
+		detail::simd::CompressibleRange<I, S, Pred, Proj> &&
+		detail::simd::LaneOutput<O, I>
+	tagged_pair<tag::in(I), tag::out(O)>
+	remove_copy_if(I first, S last, O result, Pred pred, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return {std::move(first), std::move(result)};
+		}
+		using P = detail::simd::value_predicate<Pred>;
+		auto const p = detail::addressof(*first);
+		auto const out = detail::addressof(*result);
+		auto const k = detail::simd::select<false, P::op>(p, p + n, out,
+			detail::simd::predicate_value(pred), false) - out;
+		return {first + n, result + k};
+	}
+
 	template <InputRange Rng, class O, class Pred, class Proj = identity>
 	requires
 		WeaklyIncrementable<__f<O>> &&
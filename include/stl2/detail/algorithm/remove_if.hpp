@@ -15,6 +15,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -42,6 +43,24 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <ForwardIterator I, Sentinel<I> S, class Pred, class Proj = identity>
+	requires
+		Permutable<I> &&
+		IndirectUnaryPredicate<
+			Pred, projected<I, Proj>> &&
+		detail::simd::CompressibleRange<I, S, Pred, Proj>
+	I remove_if(I first, S last, Pred pred, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return first;
+		}
+		using P = detail::simd::value_predicate<Pred>;
+		auto const p = detail::addressof(*first);
+		return first + (detail::simd::select<true, P::op>(p, p + n, p,
+			detail::simd::predicate_value(pred), false) - p);
+	}
+
 	template <ForwardRange Rng, class Pred, class Proj = identity>
 	requires
 		Permutable<iterator_t<Rng>> &&
@@ -26,8 +26,10 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/searcher.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
+#include <stl2/detail/memory/addressof.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // search [alg.search]
@@ -98,6 +100,46 @@ STL2_OPEN_NAMESPACE {
 			}
 			return __stl2::next(ext::recounted(first1_, first1, d1_ - d1), last1);
 		}
+
+		template <ForwardIterator I1, Sentinel<I1> S1,
+			ForwardIterator I2, Sentinel<I2> S2,
+			class Pred, class Proj1, class Proj2>
+		requires
+			IndirectlyComparable<
+				I1, I2, Pred, Proj1, Proj2> &&
+			detail::search::ByteRanges<I1, S1, I2, S2, Pred, Proj1, Proj2>
+		I1 sized(
+			const I1 first1, S1, const difference_type_t<I1> d1,
+			I2 first2, S2, const difference_type_t<I2> d2,
+			Pred, Proj1, Proj2)
+		{
+			if (d2 == 0) {
+				return first1;
+			}
+			if (d1 < d2) {
+				return first1 + d1;
+			}
+			return first1 + detail::search::bytes(detail::addressof(*first1), d1,
+				detail::addressof(*first2), d2);
+		}
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// Searcher [Extension]
+		//
+		template <class Srch, class I, class S = I>
+		concept bool Searcher =
+			requires(const Srch& searcher, I first, S last) {
+				{ searcher(first, last).begin() } -> I;
+			};
+	}
+
+	namespace models {
+		template <class, class, class>
+		constexpr bool Searcher = false;
+		__stl2::ext::Searcher{Srch, I, S}
+		constexpr bool Searcher<Srch, I, S> = true;
 	}
 
 	template <ForwardIterator I1, Sentinel<I1> S1,
@@ -164,6 +206,24 @@ STL2_OPEN_NAMESPACE {
 			std::ref(pred), std::ref(proj1),
 			std::ref(proj2));
 	}
+
+	// Extension
+	template <ForwardIterator I, Sentinel<I> S, class Srch>
+	requires
+		ext::Searcher<Srch, I, S>
+	I search(I first, S last, const Srch& searcher)
+	{
+		return searcher(first, last).begin();
+	}
+
+	// Extension
+	template <ForwardRange Rng, class Srch>
+	requires
+		ext::Searcher<Srch, iterator_t<Rng>, sentinel_t<Rng>>
+	safe_iterator_t<Rng> search(Rng&& rng, const Srch& searcher)
+	{
+		return searcher(__stl2::begin(rng), __stl2::end(rng)).begin();
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -0,0 +1,456 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SEARCHER_HPP
+#define STL2_DETAIL_ALGORITHM_SEARCHER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/range.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Searchers [Extension]
+//
+// Preprocessed patterns for search(rng, searcher): Boyer-Moore,
+// Boyer-Moore-Horspool and two-way (Crochemore-Perrin). Like the standard
+// searchers they refer to the pattern, which must outlive them, and find
+// its first occurrence in a random access text with the same value type.
+//
+// search itself uses the byte kernel below for contiguous 1-byte integers
+// compared with equal_to<> and no projections.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace search {
+#ifdef __cpp_lib_byte
+			template <class V>
+			concept bool ByteKey =
+				(Integral<V> && sizeof(V) == 1) || Same<V, std::byte>;
+#else
+			template <class V>
+			concept bool ByteKey =
+				Integral<V> && sizeof(V) == 1;
+#endif
+
+			template <class, class>
+			constexpr bool is_std_hash = false;
+			template <class V>
+			constexpr bool is_std_hash<std::hash<V>, V> = true;
+
+			// Shift for each element value, with a default for values that
+			// aren't in the table.
+			template <class V, class Hash, class Pred>
+			class skip_table {
+				std::unordered_map<V, std::ptrdiff_t, Hash, Pred> map_;
+				std::ptrdiff_t default_;
+			public:
+				skip_table(std::ptrdiff_t size, std::ptrdiff_t dflt, Hash hash, Pred pred)
+				: map_(static_cast<std::size_t>(size), std::move(hash), std::move(pred))
+				, default_{dflt} {}
+
+				void set(const V& key, std::ptrdiff_t shift) {
+					map_[key] = shift;
+				}
+				std::ptrdiff_t operator[](const V& key) const {
+					auto i = map_.find(key);
+					return i == map_.end() ? default_ : i->second;
+				}
+			};
+
+			// Bytes compared with equal_to<> index a flat table instead.
+			template <ByteKey V, class Hash, class Pred>
+			requires
+				__bool<is_std_hash<Hash, V>> &&
+				__bool<simd::is_equal_to<Pred>>
+			class skip_table<V, Hash, Pred> {
+				std::ptrdiff_t table_[256];
+			public:
+				skip_table(std::ptrdiff_t, std::ptrdiff_t dflt, Hash, Pred) {
+					for (auto& shift : table_) {
+						shift = dflt;
+					}
+				}
+
+				void set(V key, std::ptrdiff_t shift) {
+					table_[static_cast<unsigned char>(key)] = shift;
+				}
+				std::ptrdiff_t operator[](V key) const {
+					return table_[static_cast<unsigned char>(key)];
+				}
+			};
+
+			// Distance from the last occurrence of each value in all but
+			// the last element of the m-element pattern to its end; m for
+			// values that don't occur.
+			template <class V, class Hash, class Pred, RandomAccessIterator I>
+			skip_table<V, Hash, Pred> bad_character_table(I pattern,
+				difference_type_t<I> m, Hash hash, Pred pred)
+			{
+				skip_table<V, Hash, Pred> table{m, m, std::move(hash), std::move(pred)};
+				for (difference_type_t<I> i = 0; i < m - 1; ++i) {
+					table.set(pattern[i], m - 1 - i);
+				}
+				return table;
+			}
+
+			// Index of the first occurrence of the m-element pattern in the
+			// n-element text, or n; m > 0.
+			template <RandomAccessIterator I1, RandomAccessIterator I2,
+				class Table, class Pred>
+			difference_type_t<I1> horspool(I1 text, difference_type_t<I1> n,
+				I2 pattern, difference_type_t<I1> m, const Table& skip, Pred& pred)
+			{
+				auto const last = m - 1;
+				for (difference_type_t<I1> j = 0; j <= n - m; j += skip[text[j + last]]) {
+					if (__stl2::invoke(pred, text[j + last], pattern[last])) {
+						auto i = last;
+						while (i > 0 && __stl2::invoke(pred, text[j + i - 1], pattern[i - 1])) {
+							--i;
+						}
+						if (i == 0) {
+							return j;
+						}
+					}
+				}
+				return n;
+			}
+
+			// search over contiguous bytes compared with equal_to<>.
+			template <class I1, class S1, class I2, class S2,
+				class Pred, class Proj1, class Proj2>
+			concept bool ByteRanges =
+				simd::ComparableRanges<I1, S1, I2, S2, Pred, Proj1, Proj2> &&
+				sizeof(value_type_t<I1>) == 1;
+
+			// Shorter patterns are found by scanning for their first byte;
+			// longer ones skip ahead with Horspool.
+			constexpr std::ptrdiff_t horspool_threshold = 16;
+
+			// Index of the first occurrence of the m-byte pattern in the
+			// n-byte text, or n; 0 < m <= n.
+			template <simd::Element T>
+			std::ptrdiff_t bytes(const T* text, std::ptrdiff_t n,
+				const T* pattern, std::ptrdiff_t m) noexcept
+			{
+				if (m < horspool_threshold) {
+					auto const last = text + (n - m + 1);
+					for (auto p = text; (p = simd::find(p, last, pattern[0])) != last; ++p) {
+						if (std::memcmp(p + 1, pattern + 1, static_cast<std::size_t>(m - 1)) == 0) {
+							return p - text;
+						}
+					}
+					return n;
+				}
+				auto pred = equal_to<>{};
+				auto const skip = search::bad_character_table<T>(
+					pattern, m, std::hash<T>{}, pred);
+				return search::horspool(text, n, pattern, m, skip, pred);
+			}
+		}
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// boyer_moore_horspool_searcher [Extension]
+		//
+		template <RandomAccessIterator I,
+			class Hash = std::hash<value_type_t<I>>, class Pred = equal_to<>>
+		requires
+			IndirectRelation<Pred, I>
+		class boyer_moore_horspool_searcher {
+			using table_t = detail::search::skip_table<value_type_t<I>, Hash, Pred>;
+
+			I pattern_;
+			difference_type_t<I> m_;
+			mutable Pred pred_;
+			table_t skip_;
+		public:
+			template <SizedSentinel<I> S>
+			boyer_moore_horspool_searcher(I first, S last,
+				Hash hf = Hash{}, Pred pred = Pred{})
+			: pattern_{first}, m_{last - first}, pred_{pred}
+			, skip_{detail::search::bad_character_table<value_type_t<I>>(
+				first, m_, std::move(hf), std::move(pred))}
+			{}
+
+			template <RandomAccessIterator I1, SizedSentinel<I1> S1>
+			requires
+				Same<value_type_t<I1>, value_type_t<I>> &&
+				IndirectRelation<Pred, I1, I>
+			ext::range<I1> operator()(I1 first, S1 last) const
+			{
+				auto const n = difference_type_t<I1>(last - first);
+				if (m_ == 0) {
+					return {first, first};
+				}
+				auto j = detail::search::horspool(first, n, pattern_, m_, skip_,
+					pred_);
+				return {first + j, first + __stl2::min(n, j + m_)};
+			}
+		};
+
+		template <RandomAccessRange Rng,
+			class Hash = std::hash<value_type_t<iterator_t<Rng>>>, class Pred = equal_to<>>
+		requires
+			SizedRange<Rng> &&
+			IndirectRelation<Pred, iterator_t<Rng>>
+		boyer_moore_horspool_searcher<iterator_t<Rng>, Hash, Pred>
+		make_boyer_moore_horspool_searcher(Rng& pattern, Hash hf = Hash{}, Pred pred = Pred{})
+		{
+			return {__stl2::begin(pattern), __stl2::begin(pattern) + __stl2::distance(pattern),
+				std::move(hf), std::move(pred)};
+		}
+
+		///////////////////////////////////////////////////////////////////////////
+		// boyer_moore_searcher [Extension]
+		//
+		template <RandomAccessIterator I,
+			class Hash = std::hash<value_type_t<I>>, class Pred = equal_to<>>
+		requires
+			IndirectRelation<Pred, I>
+		class boyer_moore_searcher {
+			using D = difference_type_t<I>;
+			using table_t = detail::search::skip_table<value_type_t<I>, Hash, Pred>;
+
+			I pattern_;
+			D m_;
+			mutable Pred pred_;
+			table_t bad_character_;
+			// Shift after a mismatch at pattern index i with the rest matched.
+			std::vector<D> good_suffix_;
+
+			void build_good_suffix()
+			{
+				// suffix[i]: length of the longest common suffix of the
+				// pattern and its prefix ending at i.
+				std::vector<D> suffix(m_);
+				auto eq = [this](D i, D j) {
+					return __stl2::invoke(pred_, pattern_[i], pattern_[j]);
+				};
+				suffix[m_ - 1] = m_;
+				D f = 0, g = m_ - 1;
+				for (D i = m_ - 2; i >= 0; --i) {
+					if (i > g && suffix[i + m_ - 1 - f] < i - g) {
+						suffix[i] = suffix[i + m_ - 1 - f];
+					} else {
+						if (i < g) {
+							g = i;
+						}
+						f = i;
+						while (g >= 0 && eq(g, g + m_ - 1 - f)) {
+							--g;
+						}
+						suffix[i] = f - g;
+					}
+				}
+
+				good_suffix_.assign(m_, m_);
+				D j = 0;
+				for (D i = m_ - 1; i >= 0; --i) {
+					if (suffix[i] == i + 1) {
+						for (; j < m_ - 1 - i; ++j) {
+							if (good_suffix_[j] == m_) {
+								good_suffix_[j] = m_ - 1 - i;
+							}
+						}
+					}
+				}
+				for (D i = 0; i <= m_ - 2; ++i) {
+					good_suffix_[m_ - 1 - suffix[i]] = m_ - 1 - i;
+				}
+			}
+
+		public:
+			template <SizedSentinel<I> S>
+			boyer_moore_searcher(I first, S last,
+				Hash hf = Hash{}, Pred pred = Pred{})
+			: pattern_{first}, m_{last - first}, pred_{pred}
+			, bad_character_{detail::search::bad_character_table<value_type_t<I>>(
+				first, m_, std::move(hf), std::move(pred))}
+			{
+				if (m_ > 0) {
+					build_good_suffix();
+				}
+			}
+
+			template <RandomAccessIterator I1, SizedSentinel<I1> S1>
+			requires
+				Same<value_type_t<I1>, value_type_t<I>> &&
+				IndirectRelation<Pred, I1, I>
+			ext::range<I1> operator()(I1 first, S1 last) const
+			{
+				auto const n = difference_type_t<I1>(last - first);
+				if (m_ == 0) {
+					return {first, first};
+				}
+				for (difference_type_t<I1> j = 0; j <= n - m_;) {
+					D i = m_ - 1;
+					while (i >= 0 && __stl2::invoke(pred_, first[j + i], pattern_[i])) {
+						--i;
+					}
+					if (i < 0) {
+						return {first + j, first + j + m_};
+					}
+					j += __stl2::max(good_suffix_[i],
+						D(bad_character_[first[j + i]] - m_ + 1 + i));
+				}
+				return {first + n, first + n};
+			}
+		};
+
+		template <RandomAccessRange Rng,
+			class Hash = std::hash<value_type_t<iterator_t<Rng>>>, class Pred = equal_to<>>
+		requires
+			SizedRange<Rng> &&
+			IndirectRelation<Pred, iterator_t<Rng>>
+		boyer_moore_searcher<iterator_t<Rng>, Hash, Pred>
+		make_boyer_moore_searcher(Rng& pattern, Hash hf = Hash{}, Pred pred = Pred{})
+		{
+			return {__stl2::begin(pattern), __stl2::begin(pattern) + __stl2::distance(pattern),
+				std::move(hf), std::move(pred)};
+		}
+
+		///////////////////////////////////////////////////////////////////////////
+		// two_way_searcher [Extension]
+		//
+		// Linear time and constant space for any pattern. Needs a total order
+		// on the elements; elements match when neither orders before the
+		// other.
+		//
+		template <RandomAccessIterator I, class Comp = less<>>
+		requires
+			IndirectStrictWeakOrder<Comp, I>
+		class two_way_searcher {
+			using D = difference_type_t<I>;
+
+			I pattern_;
+			D m_;
+			mutable Comp comp_;
+			D critical_ = -1; // Last index of the left half of the factorization
+			D period_ = 1;
+			bool periodic_ = false;
+
+			template <class X, class Y>
+			bool equivalent(X&& x, Y&& y) const {
+				return !__stl2::invoke(comp_, x, y) && !__stl2::invoke(comp_, y, x);
+			}
+
+			// Start (minus one) and period of the lexicographically maximal
+			// suffix of the pattern, under the order or its reverse.
+			std::pair<D, D> maximal_suffix(bool reversed) const
+			{
+				D ms = -1, j = 0, k = 1, p = 1;
+				while (j + k < m_) {
+					auto&& a = pattern_[j + k];
+					auto&& b = pattern_[ms + k];
+					if (reversed ? __stl2::invoke(comp_, b, a) : __stl2::invoke(comp_, a, b)) {
+						j += k;
+						k = 1;
+						p = j - ms;
+					} else if (equivalent(a, b)) {
+						if (k != p) {
+							++k;
+						} else {
+							j += p;
+							k = 1;
+						}
+					} else {
+						ms = j;
+						j = ms + 1;
+						k = p = 1;
+					}
+				}
+				return {ms, p};
+			}
+
+		public:
+			template <SizedSentinel<I> S>
+			two_way_searcher(I first, S last, Comp comp = Comp{})
+			: pattern_{first}, m_{last - first}, comp_{comp}
+			{
+				if (m_ == 0) {
+					return;
+				}
+				auto const s1 = maximal_suffix(false);
+				auto const s2 = maximal_suffix(true);
+				std::tie(critical_, period_) = s1.first > s2.first ? s1 : s2;
+				// The pattern is periodic if the left half occurs again one
+				// period later.
+				periodic_ = critical_ + 1 + period_ <= m_;
+				for (D i = 0; periodic_ && i <= critical_; ++i) {
+					periodic_ = equivalent(pattern_[i], pattern_[i + period_]);
+				}
+				if (!periodic_) {
+					period_ = __stl2::max(critical_ + 1, m_ - critical_ - 1) + 1;
+				}
+			}
+
+			template <RandomAccessIterator I1, SizedSentinel<I1> S1>
+			requires
+				Same<value_type_t<I1>, value_type_t<I>> &&
+				IndirectStrictWeakOrder<Comp, I1, I>
+			ext::range<I1> operator()(I1 first, S1 last) const
+			{
+				auto const n = difference_type_t<I1>(last - first);
+				if (m_ == 0) {
+					return {first, first};
+				}
+				// memory: length of the prefix known to match after a shift
+				// by the period in the periodic case.
+				D memory = -1;
+				for (difference_type_t<I1> j = 0; j <= n - m_;) {
+					D i = __stl2::max(critical_, memory) + 1;
+					while (i < m_ && equivalent(pattern_[i], first[j + i])) {
+						++i;
+					}
+					if (i < m_) {
+						j += i - critical_;
+						memory = -1;
+						continue;
+					}
+					i = critical_;
+					while (i > memory && equivalent(pattern_[i], first[j + i])) {
+						--i;
+					}
+					if (i <= memory) {
+						return {first + j, first + j + m_};
+					}
+					j += period_;
+					memory = periodic_ ? m_ - period_ - 1 : -1;
+				}
+				return {first + n, first + n};
+			}
+		};
+
+		template <RandomAccessRange Rng, class Comp = less<>>
+		requires
+			SizedRange<Rng> &&
+			IndirectStrictWeakOrder<Comp, iterator_t<Rng>>
+		two_way_searcher<iterator_t<Rng>, Comp>
+		make_two_way_searcher(Rng& pattern, Comp comp = Comp{})
+		{
+			return {__stl2::begin(pattern), __stl2::begin(pattern) + __stl2::distance(pattern),
+				std::move(comp)};
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -51,6 +52,53 @@ STL2_OPEN_NAMESPACE {
 		return result;
 	}
 
+	// Extension: gallops on random access inputs with sized sentinels.
+	template <InputIterator I1, Sentinel<I1> S1,
+		InputIterator I2, Sentinel<I2> S2,
+		WeaklyIncrementable O, class Comp = less<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		Mergeable<I1, I2, O, Comp, Proj1, Proj2> &&
+		detail::gallop::Gallopable<I1, S1, I2, S2, Comp, Proj1, Proj2>
+	O set_intersection(I1 first1, S1 last1_, I2 first2, S2 last2_, O result,
+		Comp comp = Comp{}, Proj1 proj1 = Proj1{},
+		Proj2 proj2 = Proj2{})
+	{
+		auto const last1 = __stl2::next(first1, std::move(last1_));
+		auto const last2 = __stl2::next(first2, std::move(last2_));
+		int run1 = 0, run2 = 0;
+		while (first1 != last1 && first2 != last2) {
+			reference_t<I1>&& v1 = *first1;
+			reference_t<I2>&& v2 = *first2;
+			auto&& p1 = __stl2::invoke(proj1, v1);
+			auto&& p2 = __stl2::invoke(proj2, v2);
+			if (__stl2::invoke(comp, p1, p2)) {
+				run2 = 0;
+				if (++run1 < detail::gallop::threshold) {
+					++first1;
+				} else {
+					run1 = 0;
+					first1 = detail::gallop::lower_bound(first1, last1 - first1, p2, comp, proj1);
+				}
+			} else if (__stl2::invoke(comp, p2, p1)) {
+				run1 = 0;
+				if (++run2 < detail::gallop::threshold) {
+					++first2;
+				} else {
+					run2 = 0;
+					first2 = detail::gallop::lower_bound(first2, last2 - first2, p1, comp, proj2);
+				}
+			} else {
+				run1 = run2 = 0;
+				*result = std::forward<reference_t<I1>>(v1);
+				++result;
+				++first1;
+				++first2;
+			}
+		}
+		return result;
+	}
+
 	template <InputRange Rng1, InputRange Rng2, class O, class Comp = less<>,
 		class Proj1 = identity, class Proj2 = identity>
 	requires
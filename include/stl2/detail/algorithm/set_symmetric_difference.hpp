@@ -17,6 +17,7 @@
 #include <stl2/tuple.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
@@ -69,6 +70,61 @@ STL2_OPEN_NAMESPACE {
 			std::move(first1), std::move(first2), std::move(result)};
 	}
 
+	// Extension: gallops on random access inputs with sized sentinels.
+	template <InputIterator I1, Sentinel<I1> S1,
+		InputIterator I2, Sentinel<I2> S2,
+		WeaklyIncrementable O, class Comp = less<>,
+		class Proj1 = identity, class Proj2 = identity>
+	requires
+		Mergeable<I1, I2, O, Comp, Proj1, Proj2> &&
+		detail::gallop::Gallopable<I1, S1, I2, S2, Comp, Proj1, Proj2>
+	tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+	set_symmetric_difference(
+		I1 first1, S1 last1_, I2 first2, S2 last2_, O result,
+		Comp comp = Comp{}, Proj1 proj1 = Proj1{},
+		Proj2 proj2 = Proj2{})
+	{
+		auto const last1 = __stl2::next(first1, std::move(last1_));
+		auto const last2 = __stl2::next(first2, std::move(last2_));
+		int run1 = 0, run2 = 0;
+		while (first1 != last1 && first2 != last2) {
+			reference_t<I1>&& v1 = *first1;
+			reference_t<I2>&& v2 = *first2;
+			auto&& p1 = __stl2::invoke(proj1, v1);
+			auto&& p2 = __stl2::invoke(proj2, v2);
+			if (__stl2::invoke(comp, p1, p2)) {
+				run2 = 0;
+				if (++run1 < detail::gallop::threshold) {
+					*result = std::forward<reference_t<I1>>(v1);
+					++result;
+					++first1;
+				} else {
+					run1 = 0;
+					auto run_end = detail::gallop::lower_bound(first1, last1 - first1, p2, comp, proj1);
+					std::tie(first1, result) = __stl2::copy(first1, run_end, std::move(result));
+				}
+			} else if (__stl2::invoke(comp, p2, p1)) {
+				run1 = 0;
+				if (++run2 < detail::gallop::threshold) {
+					*result = std::forward<reference_t<I2>>(v2);
+					++result;
+					++first2;
+				} else {
+					run2 = 0;
+					auto run_end = detail::gallop::lower_bound(first2, last2 - first2, p1, comp, proj2);
+					std::tie(first2, result) = __stl2::copy(first2, run_end, std::move(result));
+				}
+			} else {
+				run1 = run2 = 0;
+				++first1;
+				++first2;
+			}
+		}
+		std::tie(first1, result) = __stl2::copy(first1, last1, std::move(result));
+		std::tie(first2, result) = __stl2::copy(first2, last2, std::move(result));
+		return {std::move(first1), std::move(first2), std::move(result)};
+	}
+
 	template <InputRange Rng1, InputRange Rng2, class O, class Comp = less<>,
 		class Proj1 = identity, class Proj2 = identity>
 	requires
@@ -0,0 +1,454 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SIMD_HPP
+#define STL2_DETAIL_ALGORITHM_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+
+#ifndef STL2_SIMD_X86
+ #if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+  #define STL2_SIMD_X86 1
+ #else
+  #define STL2_SIMD_X86 0
+ #endif
+#endif
+
+#if STL2_SIMD_X86
+ #include <immintrin.h>
+ // Compiles a kernel for an instruction set that the rest of the program
+ // need not target; callers check cpuid first.
+ #define STL2_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+// Vectorized equality kernels [Extension]
+//
+// find, count, mismatch and equal over contiguous 1, 2, 4 or 8 byte
+// integers compared with equal_to<> and no projection. On x86 the kernels
+// use AVX2 when cpuid reports it and SSE2 otherwise; elsewhere they are
+// plain loops. equal and lexicographical_compare also take std::byte, and
+// go to memcmp where it gives the same answer.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace simd {
+			template <class T>
+			concept bool Element =
+				Integral<T> &&
+				(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+			template <class>
+			constexpr bool is_equal_to = false;
+			template <>
+			constexpr bool is_equal_to<equal_to<>> = true;
+			template <>
+			constexpr bool is_equal_to<std::equal_to<>> = true;
+			template <class P>
+			constexpr bool is_equal_to<std::reference_wrapper<P>> =
+				is_equal_to<std::remove_cv_t<P>>;
+
+			template <class>
+			constexpr bool is_less = false;
+			template <>
+			constexpr bool is_less<less<>> = true;
+			template <>
+			constexpr bool is_less<std::less<>> = true;
+			template <class C>
+			constexpr bool is_less<std::reference_wrapper<C>> =
+				is_less<std::remove_cv_t<C>>;
+
+			template <class>
+			constexpr bool is_greater = false;
+			template <>
+			constexpr bool is_greater<greater<>> = true;
+			template <>
+			constexpr bool is_greater<std::greater<>> = true;
+			template <class C>
+			constexpr bool is_greater<std::reference_wrapper<C>> =
+				is_greater<std::remove_cv_t<C>>;
+
+			template <class>
+			constexpr bool is_identity = false;
+			template <>
+			constexpr bool is_identity<identity> = true;
+			template <class P>
+			constexpr bool is_identity<std::reference_wrapper<P>> =
+				is_identity<std::remove_cv_t<P>>;
+
+			// [first, last) is contiguous storage of kernel elements, compared
+			// as they are.
+			template <class I, class S, class Proj>
+			concept bool KernelRange =
+				mem::MemoryIterator<I> &&
+				SizedSentinel<S, I> &&
+				Element<value_type_t<I>> &&
+				__bool<is_identity<Proj>>;
+
+			// The pair is compared element by element with equal_to<>.
+			template <class I1, class S1, class I2, class S2,
+				class Pred, class Proj1, class Proj2>
+			concept bool ComparableRanges =
+				KernelRange<I1, S1, Proj1> &&
+				KernelRange<I2, S2, Proj2> &&
+				Same<value_type_t<I1>, value_type_t<I2>> &&
+				__bool<is_equal_to<Pred>>;
+
+			// Stores value as a V in v, and returns whether that V equals
+			// value under the usual arithmetic conversions, as the scalar
+			// loops compare an element with value. Converting both sides to
+			// their common type spells out the conversion that a mixed-sign
+			// == would warn about.
+			template <Integral V, Integral T>
+			constexpr bool to_element(const T& value, V& v) noexcept {
+				using C = std::common_type_t<V, T>;
+				v = static_cast<V>(value);
+				return static_cast<C>(v) == static_cast<C>(value);
+			}
+
+			// Ordered as memcmp orders its bytes.
+#ifdef __cpp_lib_byte
+			template <class T>
+			concept bool Byte =
+				Same<T, std::byte> ||
+				(UnsignedIntegral<T> && sizeof(T) == 1);
+#else
+			template <class T>
+			concept bool Byte =
+				UnsignedIntegral<T> && sizeof(T) == 1;
+#endif
+
+			// [first, last) is contiguous storage of kernel elements or bytes,
+			// compared as they are.
+			template <class I, class S, class Proj>
+			concept bool BitwiseRange =
+				mem::MemoryIterator<I> &&
+				SizedSentinel<S, I> &&
+				(Element<value_type_t<I>> || Byte<value_type_t<I>>) &&
+				__bool<is_identity<Proj>>;
+
+			// The pair is compared element by element with equal_to<>, which
+			// memcmp can do.
+			template <class I1, class S1, class I2, class S2,
+				class Pred, class Proj1, class Proj2>
+			concept bool EqualRanges =
+				BitwiseRange<I1, S1, Proj1> &&
+				BitwiseRange<I2, S2, Proj2> &&
+				Same<value_type_t<I1>, value_type_t<I2>> &&
+				__bool<is_equal_to<Pred>>;
+
+			// The pair is compared lexicographically with less<>.
+			template <class I1, class S1, class I2, class S2,
+				class Comp, class Proj1, class Proj2>
+			concept bool OrderedRanges =
+				BitwiseRange<I1, S1, Proj1> &&
+				BitwiseRange<I2, S2, Proj2> &&
+				Same<value_type_t<I1>, value_type_t<I2>> &&
+				__bool<is_less<Comp>>;
+
+			template <std::size_t> struct uint_of_size;
+			template <> struct uint_of_size<1> { using type = std::uint8_t; };
+			template <> struct uint_of_size<2> { using type = std::uint16_t; };
+			template <> struct uint_of_size<4> { using type = std::uint32_t; };
+			template <> struct uint_of_size<8> { using type = std::uint64_t; };
+
+			template <class T>
+			meta::_t<uint_of_size<sizeof(T)>> bits(T x) noexcept
+			{
+				meta::_t<uint_of_size<sizeof(T)>> b;
+				std::memcpy(&b, &x, sizeof(T));
+				return b;
+			}
+
+			namespace scalar {
+				template <class T>
+				const T* find(const T* first, const T* last, T value) noexcept
+				{
+					for (; first != last; ++first) {
+						if (*first == value) {
+							break;
+						}
+					}
+					return first;
+				}
+
+				template <class T>
+				std::ptrdiff_t count(const T* first, const T* last, T value) noexcept
+				{
+					std::ptrdiff_t n = 0;
+					for (; first != last; ++first) {
+						n += *first == value;
+					}
+					return n;
+				}
+
+				template <class T>
+				std::ptrdiff_t mismatch(const T* a, const T* b, std::ptrdiff_t n) noexcept
+				{
+					std::ptrdiff_t i = 0;
+					for (; i < n && a[i] == b[i]; ++i) {}
+					return i;
+				}
+			}
+
+#if STL2_SIMD_X86
+			namespace sse2 {
+				constexpr std::ptrdiff_t width = 16;
+
+				inline __m128i load(const void* p) noexcept {
+					return _mm_loadu_si128(static_cast<const __m128i*>(p));
+				}
+
+				inline __m128i broadcast(std::uint8_t x) noexcept {
+					return _mm_set1_epi8(static_cast<char>(x));
+				}
+				inline __m128i broadcast(std::uint16_t x) noexcept {
+					return _mm_set1_epi16(static_cast<short>(x));
+				}
+				inline __m128i broadcast(std::uint32_t x) noexcept {
+					return _mm_set1_epi32(static_cast<int>(x));
+				}
+				inline __m128i broadcast(std::uint64_t x) noexcept {
+					return _mm_set1_epi64x(static_cast<long long>(x));
+				}
+
+				// Bit E * j of the result is set iff element j of a and b
+				// are equal, where E is the element size; no other bit is.
+				inline unsigned eq_mask(__m128i a, __m128i b, meta::size_t<1>) noexcept {
+					return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+				}
+				inline unsigned eq_mask(__m128i a, __m128i b, meta::size_t<2>) noexcept {
+					return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b))) & 0x5555u;
+				}
+				inline unsigned eq_mask(__m128i a, __m128i b, meta::size_t<4>) noexcept {
+					return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b))) & 0x1111u;
+				}
+				inline unsigned eq_mask(__m128i a, __m128i b, meta::size_t<8>) noexcept {
+					// No 64-bit compare before SSE4.1: both halves must match.
+					auto const m = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+					return m & (m >> 4) & 0x0101u;
+				}
+
+				template <class T>
+				const T* find(const T* first, const T* last, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					auto const v = sse2::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						unsigned const m = sse2::eq_mask(sse2::load(first), v, meta::size_t<sizeof(T)>{});
+						if (m) {
+							return first + __builtin_ctz(m) / sizeof(T);
+						}
+					}
+					return scalar::find(first, last, value);
+				}
+
+				template <class T>
+				std::ptrdiff_t count(const T* first, const T* last, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					auto const v = sse2::broadcast(simd::bits(value));
+					std::ptrdiff_t n = 0;
+					for (; last - first >= step; first += step) {
+						n += __builtin_popcount(
+							sse2::eq_mask(sse2::load(first), v, meta::size_t<sizeof(T)>{}));
+					}
+					return n + scalar::count(first, last, value);
+				}
+
+				template <class T>
+				std::ptrdiff_t mismatch(const T* a, const T* b, std::ptrdiff_t n) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					std::ptrdiff_t i = 0;
+					for (; n - i >= step; i += step) {
+						// The first differing byte lies in the first differing element.
+						unsigned const m = sse2::eq_mask(
+							sse2::load(a + i), sse2::load(b + i), meta::size_t<1>{});
+						if (m != 0xFFFFu) {
+							return i + __builtin_ctz(~m) / sizeof(T);
+						}
+					}
+					return i + scalar::mismatch(a + i, b + i, n - i);
+				}
+			}
+
+			namespace avx2 {
+				constexpr std::ptrdiff_t width = 32;
+
+				STL2_TARGET("avx2") inline __m256i load(const void* p) noexcept {
+					return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+				}
+
+				STL2_TARGET("avx2") inline __m256i broadcast(std::uint8_t x) noexcept {
+					return _mm256_set1_epi8(static_cast<char>(x));
+				}
+				STL2_TARGET("avx2") inline __m256i broadcast(std::uint16_t x) noexcept {
+					return _mm256_set1_epi16(static_cast<short>(x));
+				}
+				STL2_TARGET("avx2") inline __m256i broadcast(std::uint32_t x) noexcept {
+					return _mm256_set1_epi32(static_cast<int>(x));
+				}
+				STL2_TARGET("avx2") inline __m256i broadcast(std::uint64_t x) noexcept {
+					return _mm256_set1_epi64x(static_cast<long long>(x));
+				}
+
+				STL2_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, meta::size_t<1>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+				}
+				STL2_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, meta::size_t<2>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b))) & 0x55555555u;
+				}
+				STL2_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, meta::size_t<4>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b))) & 0x11111111u;
+				}
+				STL2_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, meta::size_t<8>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b))) & 0x01010101u;
+				}
+
+				template <class T>
+				STL2_TARGET("avx2") const T* find(const T* first, const T* last, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					auto const v = avx2::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						unsigned const m = avx2::eq_mask(avx2::load(first), v, meta::size_t<sizeof(T)>{});
+						if (m) {
+							return first + __builtin_ctz(m) / sizeof(T);
+						}
+					}
+					return scalar::find(first, last, value);
+				}
+
+				template <class T>
+				STL2_TARGET("avx2") std::ptrdiff_t count(const T* first, const T* last, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					auto const v = avx2::broadcast(simd::bits(value));
+					std::ptrdiff_t n = 0;
+					for (; last - first >= step; first += step) {
+						n += __builtin_popcount(
+							avx2::eq_mask(avx2::load(first), v, meta::size_t<sizeof(T)>{}));
+					}
+					return n + scalar::count(first, last, value);
+				}
+
+				template <class T>
+				STL2_TARGET("avx2") std::ptrdiff_t mismatch(const T* a, const T* b, std::ptrdiff_t n) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					std::ptrdiff_t i = 0;
+					for (; n - i >= step; i += step) {
+						unsigned const m = avx2::eq_mask(
+							avx2::load(a + i), avx2::load(b + i), meta::size_t<1>{});
+						if (m != 0xFFFFFFFFu) {
+							return i + __builtin_ctz(~m) / sizeof(T);
+						}
+					}
+					return i + scalar::mismatch(a + i, b + i, n - i);
+				}
+			}
+
+			inline bool has_avx2() noexcept
+			{
+				static bool const avx2 = __builtin_cpu_supports("avx2");
+				return avx2;
+			}
+#endif // STL2_SIMD_X86
+
+			// Position of the first element of [first, last) equal to value,
+			// or last.
+			template <Element T>
+			const T* find(const T* first, const T* last, T value) noexcept
+			{
+#if STL2_SIMD_X86
+				return simd::has_avx2() ? avx2::find(first, last, value)
+					: sse2::find(first, last, value);
+#else
+				return scalar::find(first, last, value);
+#endif
+			}
+
+			// Number of elements of [first, last) equal to value.
+			template <Element T>
+			std::ptrdiff_t count(const T* first, const T* last, T value) noexcept
+			{
+#if STL2_SIMD_X86
+				return simd::has_avx2() ? avx2::count(first, last, value)
+					: sse2::count(first, last, value);
+#else
+				return scalar::count(first, last, value);
+#endif
+			}
+
+			// Index of the first i in [0, n) with a[i] != b[i], or n.
+			template <Element T>
+			std::ptrdiff_t mismatch(const T* a, const T* b, std::ptrdiff_t n) noexcept
+			{
+#if STL2_SIMD_X86
+				return simd::has_avx2() ? avx2::mismatch(a, b, n)
+					: sse2::mismatch(a, b, n);
+#else
+				return scalar::mismatch(a, b, n);
+#endif
+			}
+
+			// Whether [a, a + n) and [b, b + n) hold the same values.
+			template <class T>
+			requires Element<T> || Byte<T>
+			bool equal(const T* a, const T* b, std::ptrdiff_t n) noexcept
+			{
+				return n == 0 || std::memcmp(a, b,
+					static_cast<std::size_t>(n) * sizeof(T)) == 0;
+			}
+
+			template <class T>
+			bool lexicographical_less(const T* a, std::ptrdiff_t n1,
+				const T* b, std::ptrdiff_t n2, std::true_type) noexcept
+			{
+				auto const n = n1 < n2 ? n1 : n2;
+				int const r = n == 0 ? 0 :
+					std::memcmp(a, b, static_cast<std::size_t>(n));
+				return r < 0 || (r == 0 && n1 < n2);
+			}
+
+			template <class T>
+			bool lexicographical_less(const T* a, std::ptrdiff_t n1,
+				const T* b, std::ptrdiff_t n2, std::false_type) noexcept
+			{
+				auto const n = n1 < n2 ? n1 : n2;
+				auto const i = simd::mismatch(a, b, n);
+				return i < n ? a[i] < b[i] : n1 < n2;
+			}
+
+			// Whether [a, a + n1) is lexicographically less than
+			// [b, b + n2): memcmp for bytes, the first difference otherwise.
+			template <class T>
+			requires Element<T> || Byte<T>
+			bool lexicographical_less(const T* a, std::ptrdiff_t n1,
+				const T* b, std::ptrdiff_t n2) noexcept
+			{
+				return simd::lexicographical_less(a, n1, b, n2, meta::bool_<Byte<T>>{});
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,600 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SIMD_COMPRESS_HPP
+#define STL2_DETAIL_ALGORITHM_SIMD_COMPRESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/utility.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/concepts/core.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Vectorized stream compaction [Extension]
+//
+// remove, remove_if, remove_copy, remove_copy_if, copy_if, partition_copy
+// and unique over contiguous 4 or 8 byte arithmetic elements with no
+// projection, when each element is kept or dropped by comparing it with a
+// constant - remove's value, or the value of an ext::less_than,
+// greater_than, equal_to_value or not_equal_to_value of the element type -
+// or, for unique with equal_to<>, with its predecessor. A vector of
+// elements is compared at once, and the survivors are packed to the front
+// with vpcompress on AVX-512 or a table-driven permute on AVX2, instead of
+// taking a branch per element. Elsewhere the in-place loops store every
+// element and advance the output conditionally.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace simd {
+			template <class T>
+			concept bool Lane =
+				(Integral<T> || _Is<T, std::is_floating_point>) &&
+				(sizeof(T) == 4 || sizeof(T) == 8);
+
+			enum class cmp { lt, gt, eq, ne };
+
+			template <cmp Op, class T>
+			struct compares_with {
+				static constexpr cmp op = Op;
+				using value_type = T;
+			};
+
+			// The comparison a predicate makes between its argument and its
+			// value, if it is one of the value predicates.
+			template <class>
+			struct value_predicate {};
+			template <class T>
+			struct value_predicate<ext::less_than<T>>
+			: compares_with<cmp::lt, T> {};
+			template <class T>
+			struct value_predicate<ext::greater_than<T>>
+			: compares_with<cmp::gt, T> {};
+			template <class T>
+			struct value_predicate<ext::equal_to_value<T>>
+			: compares_with<cmp::eq, T> {};
+			template <class T>
+			struct value_predicate<ext::not_equal_to_value<T>>
+			: compares_with<cmp::ne, T> {};
+			template <class P>
+			struct value_predicate<std::reference_wrapper<P>>
+			: value_predicate<std::remove_cv_t<P>> {};
+
+			template <class P>
+			const auto& predicate_value(const P& pred) noexcept {
+				return pred.value;
+			}
+			template <class P>
+			const auto& predicate_value(std::reference_wrapper<P> pred) noexcept {
+				return simd::predicate_value(pred.get());
+			}
+
+			// [first, last) is contiguous storage of lanes, used as they are.
+			template <class I, class S, class Proj>
+			concept bool LaneRange =
+				mem::MemoryIterator<I> &&
+				SizedSentinel<S, I> &&
+				Lane<value_type_t<I>> &&
+				__bool<is_identity<Proj>>;
+
+			// ... that pred compares with a value of their own type.
+			template <class I, class S, class Pred, class Proj>
+			concept bool CompressibleRange =
+				LaneRange<I, S, Proj> &&
+				Same<typename value_predicate<Pred>::value_type, value_type_t<I>>;
+
+			// O is contiguous storage for the elements of I.
+			template <class O, class I>
+			concept bool LaneOutput =
+				mem::MemoryIterator<O> &&
+				Same<value_type_t<O>, value_type_t<I>> &&
+				Same<reference_t<O>, value_type_t<O>&>;
+
+			// The type a lane of T is compared as: unsigned integers are
+			// biased into signed ones for lt and gt.
+			template <class T>
+			using compare_as = meta::if_<std::is_floating_point<T>, T,
+				meta::if_<std::is_signed<T>,
+					meta::_t<std::make_signed<meta::_t<uint_of_size<sizeof(T)>>>>,
+					meta::_t<uint_of_size<sizeof(T)>>>>;
+
+			namespace scalar {
+				template <cmp Op, class T>
+				constexpr bool test(T a, T b) noexcept
+				{
+					switch (Op) {
+					case cmp::lt: return a < b;
+					case cmp::gt: return a > b;
+					case cmp::eq: return a == b;
+					default: return a != b;
+					}
+				}
+
+				// Stores the elements e of [first, last) for which
+				// test<Op>(e, value) == keep to out, and returns the end of
+				// the output. InPlace: out <= first in the same array, and
+				// every element is stored, but out only advances past the
+				// ones kept.
+				template <bool InPlace, cmp Op, class T>
+				T* select(const T* first, const T* last, T* out, T value, bool keep) noexcept
+				{
+					for (; first != last; ++first) {
+						T const e = *first;
+						if (InPlace) {
+							*out = e;
+							out += scalar::test<Op>(e, value) == keep;
+						} else if (scalar::test<Op>(e, value) == keep) {
+							*out++ = e;
+						}
+					}
+					return out;
+				}
+
+				template <cmp Op, class T>
+				pair<T*, T*> partition(const T* first, const T* last,
+					T* out_true, T* out_false, T value) noexcept
+				{
+					for (; first != last; ++first) {
+						T const e = *first;
+						if (scalar::test<Op>(e, value)) {
+							*out_true++ = e;
+						} else {
+							*out_false++ = e;
+						}
+					}
+					return {out_true, out_false};
+				}
+
+				// Stores the elements of [first, last) that differ from their
+				// predecessor - prev for *first - to out <= first.
+				template <class T>
+				T* unique(const T* first, const T* last, T* out, T prev) noexcept
+				{
+					for (; first != last; ++first) {
+						T const e = *first;
+						*out = e;
+						out += scalar::test<cmp::ne>(e, prev);
+						prev = e;
+					}
+					return out;
+				}
+			}
+
+#if STL2_SIMD_X86
+			namespace avx2 {
+				// Lanes of all ones where lane j of a compares Op with lane j
+				// of b, and of zeros elsewhere.
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<std::int32_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm256_cmpgt_epi32(b, a);
+					case cmp::gt: return _mm256_cmpgt_epi32(a, b);
+					case cmp::eq: return _mm256_cmpeq_epi32(a, b);
+					default: return _mm256_xor_si256(_mm256_cmpeq_epi32(a, b), _mm256_set1_epi32(-1));
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<std::int64_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm256_cmpgt_epi64(b, a);
+					case cmp::gt: return _mm256_cmpgt_epi64(a, b);
+					case cmp::eq: return _mm256_cmpeq_epi64(a, b);
+					default: return _mm256_xor_si256(_mm256_cmpeq_epi64(a, b), _mm256_set1_epi32(-1));
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<std::uint32_t>) noexcept {
+					if (Op == cmp::lt || Op == cmp::gt) {
+						auto const bias = _mm256_set1_epi32(INT32_MIN);
+						a = _mm256_xor_si256(a, bias);
+						b = _mm256_xor_si256(b, bias);
+					}
+					return avx2::compare_lanes<Op>(a, b, meta::id<std::int32_t>{});
+				}
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<std::uint64_t>) noexcept {
+					if (Op == cmp::lt || Op == cmp::gt) {
+						auto const bias = _mm256_set1_epi64x(INT64_MIN);
+						a = _mm256_xor_si256(a, bias);
+						b = _mm256_xor_si256(b, bias);
+					}
+					return avx2::compare_lanes<Op>(a, b, meta::id<std::int64_t>{});
+				}
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<float>) noexcept {
+					auto const x = _mm256_castsi256_ps(a);
+					auto const y = _mm256_castsi256_ps(b);
+					switch (Op) {
+					case cmp::lt: return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_LT_OQ));
+					case cmp::gt: return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_GT_OQ));
+					case cmp::eq: return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_EQ_OQ));
+					default: return _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_NEQ_UQ));
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx2") __m256i compare_lanes(__m256i a, __m256i b, meta::id<double>) noexcept {
+					auto const x = _mm256_castsi256_pd(a);
+					auto const y = _mm256_castsi256_pd(b);
+					switch (Op) {
+					case cmp::lt: return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_LT_OQ));
+					case cmp::gt: return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_GT_OQ));
+					case cmp::eq: return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_EQ_OQ));
+					default: return _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_NEQ_UQ));
+					}
+				}
+
+				STL2_TARGET("avx2") inline unsigned movemask(__m256i m, meta::size_t<4>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+				}
+				STL2_TARGET("avx2") inline unsigned movemask(__m256i m, meta::size_t<8>) noexcept {
+					return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+				}
+
+				// Bit j of the result is set iff lane j of a compares Op with
+				// lane j of b.
+				template <cmp Op, class T>
+				STL2_TARGET("avx2") unsigned compare(__m256i a, __m256i b, meta::id<T> t) noexcept {
+					return avx2::movemask(avx2::compare_lanes<Op>(a, b, t),
+						meta::size_t<sizeof(T)>{});
+				}
+
+				// index[m] lists, a byte each, the 32-bit lanes that move the
+				// Size byte lanes selected by m to the front, in order.
+				template <std::size_t Size>
+				struct compress_table {
+					std::uint64_t index[1u << (32 / Size)] = {};
+
+					constexpr compress_table() {
+						constexpr unsigned lanes = 32 / Size;
+						constexpr unsigned parts = Size / 4;
+						for (unsigned m = 0; m < (1u << lanes); ++m) {
+							unsigned k = 0;
+							for (unsigned j = 0; j < lanes; ++j) {
+								if (m >> j & 1) {
+									for (unsigned p = 0; p < parts; ++p, ++k) {
+										index[m] |= std::uint64_t{j * parts + p} << (8 * k);
+									}
+								}
+							}
+						}
+					}
+				};
+
+				template <std::size_t Size>
+				STL2_TARGET("avx2") __m256i compress(__m256i v, unsigned m) noexcept
+				{
+					static constexpr compress_table<Size> table{};
+					auto const index = _mm256_cvtepu8_epi32(
+						_mm_cvtsi64_si128(static_cast<long long>(table.index[m])));
+					return _mm256_permutevar8x32_epi32(v, index);
+				}
+
+				// Stores the first k Size byte lanes of v to out.
+				template <std::size_t Size>
+				STL2_TARGET("avx2") void store_n(void* out, __m256i v, unsigned k) noexcept
+				{
+					auto const mask = _mm256_cmpgt_epi32(
+						_mm256_set1_epi32(static_cast<int>(k * (Size / 4))),
+						_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+					_mm256_maskstore_epi32(static_cast<int*>(out), mask, v);
+				}
+
+				// Lanes [prev[last], cur[0], ..., cur[last - 1]].
+				STL2_TARGET("avx2") inline __m256i shift_in(__m256i prev, __m256i cur, meta::size_t<4>) noexcept {
+					auto const rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+					return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(cur, rotate),
+						_mm256_permutevar8x32_epi32(prev, rotate), 0x01);
+				}
+				STL2_TARGET("avx2") inline __m256i shift_in(__m256i prev, __m256i cur, meta::size_t<8>) noexcept {
+					return _mm256_blend_epi32(_mm256_permute4x64_epi64(cur, 0x93),
+						_mm256_permute4x64_epi64(prev, 0x93), 0x03);
+				}
+
+				template <bool InPlace, cmp Op, class T>
+				STL2_TARGET("avx2") T* select(const T* first, const T* last, T* out, T value, bool keep) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr unsigned all = (1u << step) - 1;
+					unsigned const flip = keep ? 0u : all;
+					auto const v = avx2::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						auto const x = avx2::load(first);
+						unsigned const m = avx2::compare<Op>(x, v, meta::id<compare_as<T>>{}) ^ flip;
+						auto const packed = avx2::compress<sizeof(T)>(x, m);
+						auto const k = static_cast<unsigned>(__builtin_popcount(m));
+						if (InPlace) {
+							// Only overwrites elements that have been loaded.
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+						} else {
+							avx2::store_n<sizeof(T)>(out, packed, k);
+						}
+						out += k;
+					}
+					return scalar::select<InPlace, Op>(first, last, out, value, keep);
+				}
+
+				template <cmp Op, class T>
+				STL2_TARGET("avx2") pair<T*, T*> partition(const T* first, const T* last,
+					T* out_true, T* out_false, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr unsigned all = (1u << step) - 1;
+					auto const v = avx2::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						auto const x = avx2::load(first);
+						unsigned const m = avx2::compare<Op>(x, v, meta::id<compare_as<T>>{});
+						auto const k = static_cast<unsigned>(__builtin_popcount(m));
+						avx2::store_n<sizeof(T)>(out_true, avx2::compress<sizeof(T)>(x, m), k);
+						avx2::store_n<sizeof(T)>(out_false, avx2::compress<sizeof(T)>(x, m ^ all), step - k);
+						out_true += k;
+						out_false += step - k;
+					}
+					return scalar::partition<Op>(first, last, out_true, out_false, value);
+				}
+
+				template <class T>
+				STL2_TARGET("avx2") T* unique(const T* first, const T* last, T* out, T prev) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					if (last - first < step) {
+						return scalar::unique(first, last, out, prev);
+					}
+					// The predecessors of a block are shifted in from registers:
+					// the element before it may already have been overwritten.
+					auto p = avx2::broadcast(simd::bits(prev));
+					for (; last - first >= step; first += step) {
+						auto const x = avx2::load(first);
+						auto const before = avx2::shift_in(p, x, meta::size_t<sizeof(T)>{});
+						unsigned const m = avx2::compare<cmp::ne>(x, before, meta::id<compare_as<T>>{});
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+							avx2::compress<sizeof(T)>(x, m));
+						out += __builtin_popcount(m);
+						p = x;
+					}
+					alignas(32) T lanes[step];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), p);
+					return scalar::unique(first, last, out, lanes[step - 1]);
+				}
+			}
+
+			namespace avx512 {
+				constexpr std::ptrdiff_t width = 64;
+
+				STL2_TARGET("avx512f") inline __m512i load(const void* p) noexcept {
+					return _mm512_loadu_si512(p);
+				}
+
+				STL2_TARGET("avx512f") inline __m512i broadcast(std::uint32_t x) noexcept {
+					return _mm512_set1_epi32(static_cast<int>(x));
+				}
+				STL2_TARGET("avx512f") inline __m512i broadcast(std::uint64_t x) noexcept {
+					return _mm512_set1_epi64(static_cast<long long>(x));
+				}
+
+				// Bit j of the result is set iff lane j of a compares Op with
+				// lane j of b.
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<std::int32_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT);
+					case cmp::gt: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NLE);
+					case cmp::eq: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_EQ);
+					default: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NE);
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<std::uint32_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_LT);
+					case cmp::gt: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_NLE);
+					case cmp::eq: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_EQ);
+					default: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_NE);
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<std::int64_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LT);
+					case cmp::gt: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NLE);
+					case cmp::eq: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_EQ);
+					default: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NE);
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<std::uint64_t>) noexcept {
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_LT);
+					case cmp::gt: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_NLE);
+					case cmp::eq: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_EQ);
+					default: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_NE);
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<float>) noexcept {
+					auto const x = _mm512_castsi512_ps(a);
+					auto const y = _mm512_castsi512_ps(b);
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_ps_mask(x, y, _CMP_LT_OQ);
+					case cmp::gt: return _mm512_cmp_ps_mask(x, y, _CMP_GT_OQ);
+					case cmp::eq: return _mm512_cmp_ps_mask(x, y, _CMP_EQ_OQ);
+					default: return _mm512_cmp_ps_mask(x, y, _CMP_NEQ_UQ);
+					}
+				}
+				template <cmp Op>
+				STL2_TARGET("avx512f") unsigned compare(__m512i a, __m512i b, meta::id<double>) noexcept {
+					auto const x = _mm512_castsi512_pd(a);
+					auto const y = _mm512_castsi512_pd(b);
+					switch (Op) {
+					case cmp::lt: return _mm512_cmp_pd_mask(x, y, _CMP_LT_OQ);
+					case cmp::gt: return _mm512_cmp_pd_mask(x, y, _CMP_GT_OQ);
+					case cmp::eq: return _mm512_cmp_pd_mask(x, y, _CMP_EQ_OQ);
+					default: return _mm512_cmp_pd_mask(x, y, _CMP_NEQ_UQ);
+					}
+				}
+
+				// The lanes of v selected by m, moved to the front.
+				STL2_TARGET("avx512f") inline __m512i compress(__m512i v, unsigned m, meta::size_t<4>) noexcept {
+					return _mm512_maskz_compress_epi32(static_cast<__mmask16>(m), v);
+				}
+				STL2_TARGET("avx512f") inline __m512i compress(__m512i v, unsigned m, meta::size_t<8>) noexcept {
+					return _mm512_maskz_compress_epi64(static_cast<__mmask8>(m), v);
+				}
+
+				// Stores the first k lanes of v to out.
+				STL2_TARGET("avx512f") inline void store_n(void* out, __m512i v, unsigned k, meta::size_t<4>) noexcept {
+					_mm512_mask_storeu_epi32(out, static_cast<__mmask16>((1u << k) - 1), v);
+				}
+				STL2_TARGET("avx512f") inline void store_n(void* out, __m512i v, unsigned k, meta::size_t<8>) noexcept {
+					_mm512_mask_storeu_epi64(out, static_cast<__mmask8>((1u << k) - 1), v);
+				}
+
+				// Lanes [prev[last], cur[0], ..., cur[last - 1]].
+				STL2_TARGET("avx512f") inline __m512i shift_in(__m512i prev, __m512i cur, meta::size_t<4>) noexcept {
+					return _mm512_alignr_epi32(cur, prev, 15);
+				}
+				STL2_TARGET("avx512f") inline __m512i shift_in(__m512i prev, __m512i cur, meta::size_t<8>) noexcept {
+					return _mm512_alignr_epi64(cur, prev, 7);
+				}
+
+				template <bool InPlace, cmp Op, class T>
+				STL2_TARGET("avx512f") T* select(const T* first, const T* last, T* out, T value, bool keep) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr auto size = meta::size_t<sizeof(T)>{};
+					constexpr unsigned all = (1u << step) - 1;
+					unsigned const flip = keep ? 0u : all;
+					auto const v = avx512::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						auto const x = avx512::load(first);
+						unsigned const m = avx512::compare<Op>(x, v, meta::id<compare_as<T>>{}) ^ flip;
+						auto const packed = avx512::compress(x, m, size);
+						auto const k = static_cast<unsigned>(__builtin_popcount(m));
+						if (InPlace) {
+							// Only overwrites elements that have been loaded.
+							_mm512_storeu_si512(out, packed);
+						} else {
+							avx512::store_n(out, packed, k, size);
+						}
+						out += k;
+					}
+					return scalar::select<InPlace, Op>(first, last, out, value, keep);
+				}
+
+				template <cmp Op, class T>
+				STL2_TARGET("avx512f") pair<T*, T*> partition(const T* first, const T* last,
+					T* out_true, T* out_false, T value) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr auto size = meta::size_t<sizeof(T)>{};
+					constexpr unsigned all = (1u << step) - 1;
+					auto const v = avx512::broadcast(simd::bits(value));
+					for (; last - first >= step; first += step) {
+						auto const x = avx512::load(first);
+						unsigned const m = avx512::compare<Op>(x, v, meta::id<compare_as<T>>{});
+						auto const k = static_cast<unsigned>(__builtin_popcount(m));
+						avx512::store_n(out_true, avx512::compress(x, m, size), k, size);
+						avx512::store_n(out_false, avx512::compress(x, m ^ all, size), step - k, size);
+						out_true += k;
+						out_false += step - k;
+					}
+					return scalar::partition<Op>(first, last, out_true, out_false, value);
+				}
+
+				template <class T>
+				STL2_TARGET("avx512f") T* unique(const T* first, const T* last, T* out, T prev) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr auto size = meta::size_t<sizeof(T)>{};
+					if (last - first < step) {
+						return scalar::unique(first, last, out, prev);
+					}
+					auto p = avx512::broadcast(simd::bits(prev));
+					for (; last - first >= step; first += step) {
+						auto const x = avx512::load(first);
+						auto const before = avx512::shift_in(p, x, size);
+						unsigned const m = avx512::compare<cmp::ne>(x, before, meta::id<compare_as<T>>{});
+						_mm512_storeu_si512(out, avx512::compress(x, m, size));
+						out += __builtin_popcount(m);
+						p = x;
+					}
+					alignas(64) T lanes[step];
+					_mm512_store_si512(lanes, p);
+					return scalar::unique(first, last, out, lanes[step - 1]);
+				}
+			}
+
+			inline bool has_avx512() noexcept
+			{
+				static bool const avx512 = __builtin_cpu_supports("avx512f");
+				return avx512;
+			}
+#endif // STL2_SIMD_X86
+
+			// Stores the elements e of [first, last) that compare Op with
+			// value iff keep to out, and returns the end of the output.
+			// InPlace: out <= first, in the same array.
+			template <bool InPlace, cmp Op, Lane T>
+			T* select(const T* first, const T* last, T* out, T value, bool keep) noexcept
+			{
+#if STL2_SIMD_X86
+				if (simd::has_avx512()) {
+					return avx512::select<InPlace, Op>(first, last, out, value, keep);
+				}
+				if (simd::has_avx2()) {
+					return avx2::select<InPlace, Op>(first, last, out, value, keep);
+				}
+#endif
+				return scalar::select<InPlace, Op>(first, last, out, value, keep);
+			}
+
+			// Stores the elements of [first, last) that compare Op with value
+			// to out_true, and the others to out_false.
+			template <cmp Op, Lane T>
+			pair<T*, T*> partition(const T* first, const T* last,
+				T* out_true, T* out_false, T value) noexcept
+			{
+#if STL2_SIMD_X86
+				if (simd::has_avx512()) {
+					return avx512::partition<Op>(first, last, out_true, out_false, value);
+				}
+				if (simd::has_avx2()) {
+					return avx2::partition<Op>(first, last, out_true, out_false, value);
+				}
+#endif
+				return scalar::partition<Op>(first, last, out_true, out_false, value);
+			}
+
+			// unique over the nonempty [first, last) with equal_to<>; returns
+			// the end of the result.
+			template <Lane T>
+			T* unique(T* first, T* last) noexcept
+			{
+				T const prev = *first++;
+#if STL2_SIMD_X86
+				if (simd::has_avx512()) {
+					return avx512::unique(first, last, first, prev);
+				}
+				if (simd::has_avx2()) {
+					return avx2::unique(first, last, first, prev);
+				}
+#endif
+				return scalar::unique(first, last, first, prev);
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
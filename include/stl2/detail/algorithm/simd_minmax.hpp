@@ -0,0 +1,236 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SIMD_MINMAX_HPP
+#define STL2_DETAIL_ALGORITHM_SIMD_MINMAX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <stl2/functional.hpp>
+#include <stl2/utility.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
+#include <stl2/detail/concepts/core.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Vectorized min_element, max_element and minmax [Extension]
+//
+// min_element, max_element, minmax_element and minmax over contiguous 4 or
+// 8 byte arithmetic elements compared with less<> and no projection. On
+// AVX2, each lane keeps its own first minimum and last maximum along with
+// the block it came from, and the lanes are reduced at the end, so the
+// positions returned are the same as the scalar loops'. Value-only minmax
+// of integers keeps no positions at all.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		namespace simd {
+			// [first, last) is contiguous storage of lanes, ordered by less<>.
+			template <class I, class S, class Comp, class Proj>
+			concept bool ReducibleRange =
+				LaneRange<I, S, Proj> &&
+				__bool<is_less<Comp>>;
+
+			namespace scalar {
+				// Given the positions r of the first minimum and the last
+				// maximum of [first, first + i), those of [first, first + n).
+				template <bool Min, bool Max, class T>
+				pair<std::ptrdiff_t, std::ptrdiff_t>
+				extremes(const T* first, std::ptrdiff_t i, std::ptrdiff_t n,
+					pair<std::ptrdiff_t, std::ptrdiff_t> r) noexcept
+				{
+					for (; i < n; ++i) {
+						if (Min && first[i] < first[r.first]) {
+							r.first = i;
+						}
+						if (Max && !(first[i] < first[r.second])) {
+							r.second = i;
+						}
+					}
+					return r;
+				}
+
+				// The least and greatest of [first, first + n), n > 0.
+				template <class T>
+				pair<T, T> minmax(const T* first, std::ptrdiff_t n) noexcept
+				{
+					T lo = first[0], hi = first[0];
+					for (std::ptrdiff_t i = 1; i < n; ++i) {
+						T const e = first[i];
+						lo = e < lo ? e : lo;
+						hi = e < hi ? hi : e;
+					}
+					return {lo, hi};
+				}
+			}
+
+#if STL2_SIMD_X86
+			namespace avx2 {
+				STL2_TARGET("avx2") inline __m256i increment(__m256i x, meta::size_t<4>) noexcept {
+					return _mm256_add_epi32(x, _mm256_set1_epi32(1));
+				}
+				STL2_TARGET("avx2") inline __m256i increment(__m256i x, meta::size_t<8>) noexcept {
+					return _mm256_add_epi64(x, _mm256_set1_epi64x(1));
+				}
+
+				template <bool Min, bool Max, class T>
+				STL2_TARGET("avx2") pair<std::ptrdiff_t, std::ptrdiff_t>
+				extremes(const T* first, std::ptrdiff_t n) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr auto size = meta::size_t<sizeof(T)>{};
+					constexpr auto as = meta::id<compare_as<T>>{};
+					using block_t = meta::_t<std::make_signed<meta::_t<uint_of_size<sizeof(T)>>>>;
+					if (n < 2 * step || n / step > static_cast<std::ptrdiff_t>(
+						std::numeric_limits<block_t>::max())) {
+						return scalar::extremes<Min, Max>(first, 1, n, {0, 0});
+					}
+
+					// Lane j of lo holds the first minimum of the elements
+					// first[step * b + j], and lane j of lo_at holds its b;
+					// likewise for the last maximum in hi and hi_at.
+					auto lo = avx2::load(first), hi = lo;
+					auto block = _mm256_setzero_si256(), lo_at = block, hi_at = block;
+					std::ptrdiff_t i = step;
+					for (; n - i >= step; i += step) {
+						block = avx2::increment(block, size);
+						auto const x = avx2::load(first + i);
+						if (Min) {
+							auto const less = avx2::compare_lanes<cmp::lt>(x, lo, as);
+							lo = _mm256_blendv_epi8(lo, x, less);
+							lo_at = _mm256_blendv_epi8(lo_at, block, less);
+						}
+						if (Max) {
+							auto const less = avx2::compare_lanes<cmp::lt>(x, hi, as);
+							hi = _mm256_blendv_epi8(x, hi, less);
+							hi_at = _mm256_blendv_epi8(block, hi_at, less);
+						}
+					}
+
+					alignas(32) block_t lo_blocks[step];
+					alignas(32) block_t hi_blocks[step];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lo_blocks), lo_at);
+					_mm256_store_si256(reinterpret_cast<__m256i*>(hi_blocks), hi_at);
+					auto r = pair<std::ptrdiff_t, std::ptrdiff_t>{0, 0};
+					for (std::ptrdiff_t j = 0; j < step; ++j) {
+						if (Min) {
+							auto const at = step * lo_blocks[j] + j;
+							if (first[at] < first[r.first] ||
+								(!(first[r.first] < first[at]) && at < r.first)) {
+								r.first = at;
+							}
+						}
+						if (Max) {
+							auto const at = step * hi_blocks[j] + j;
+							if (first[r.second] < first[at] ||
+								(!(first[at] < first[r.second]) && at > r.second)) {
+								r.second = at;
+							}
+						}
+					}
+					return scalar::extremes<Min, Max>(first, i, n, r);
+				}
+
+				STL2_TARGET("avx2") inline __m256i min(__m256i a, __m256i b, meta::id<std::int32_t>) noexcept {
+					return _mm256_min_epi32(a, b);
+				}
+				STL2_TARGET("avx2") inline __m256i max(__m256i a, __m256i b, meta::id<std::int32_t>) noexcept {
+					return _mm256_max_epi32(a, b);
+				}
+				STL2_TARGET("avx2") inline __m256i min(__m256i a, __m256i b, meta::id<std::uint32_t>) noexcept {
+					return _mm256_min_epu32(a, b);
+				}
+				STL2_TARGET("avx2") inline __m256i max(__m256i a, __m256i b, meta::id<std::uint32_t>) noexcept {
+					return _mm256_max_epu32(a, b);
+				}
+				template <class U>
+				STL2_TARGET("avx2") __m256i min(__m256i a, __m256i b, meta::id<U> as) noexcept {
+					return _mm256_blendv_epi8(a, b, avx2::compare_lanes<cmp::lt>(b, a, as));
+				}
+				template <class U>
+				STL2_TARGET("avx2") __m256i max(__m256i a, __m256i b, meta::id<U> as) noexcept {
+					return _mm256_blendv_epi8(a, b, avx2::compare_lanes<cmp::lt>(a, b, as));
+				}
+
+				// Integers only: equal minima are indistinguishable.
+				template <class T>
+				STL2_TARGET("avx2") pair<T, T> minmax(const T* first, std::ptrdiff_t n) noexcept
+				{
+					constexpr std::ptrdiff_t step = width / sizeof(T);
+					constexpr auto as = meta::id<compare_as<T>>{};
+					if (n < 2 * step) {
+						return scalar::minmax(first, n);
+					}
+					auto lo = avx2::load(first), hi = lo;
+					std::ptrdiff_t i = step;
+					for (; n - i >= step; i += step) {
+						auto const x = avx2::load(first + i);
+						lo = avx2::min(lo, x, as);
+						hi = avx2::max(hi, x, as);
+					}
+					alignas(32) T lanes[2 * step];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), lo);
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes + step), hi);
+					auto r = scalar::minmax(lanes, step);
+					auto const h = scalar::minmax(lanes + step, step);
+					r.second = h.second;
+					for (; i < n; ++i) {
+						T const e = first[i];
+						r.first = e < r.first ? e : r.first;
+						r.second = e < r.second ? r.second : e;
+					}
+					return r;
+				}
+			}
+#endif // STL2_SIMD_X86
+
+			// The positions of the first minimum and the last maximum of the
+			// nonempty [first, first + n), or 0 for the one not asked for.
+			template <bool Min, bool Max, Lane T>
+			pair<std::ptrdiff_t, std::ptrdiff_t>
+			extremes(const T* first, std::ptrdiff_t n) noexcept
+			{
+#if STL2_SIMD_X86
+				if (simd::has_avx2()) {
+					return avx2::extremes<Min, Max>(first, n);
+				}
+#endif
+				return scalar::extremes<Min, Max>(first, 1, n, {0, 0});
+			}
+
+			// The first least and last greatest of the nonempty
+			// [first, first + n).
+			template <Lane T>
+			pair<T, T> minmax(const T* first, std::ptrdiff_t n) noexcept
+			{
+				auto const r = simd::extremes<true, true>(first, n);
+				return {first[r.first], first[r.second]};
+			}
+
+			template <Lane T>
+			requires Integral<T>
+			pair<T, T> minmax(const T* first, std::ptrdiff_t n) noexcept
+			{
+#if STL2_SIMD_X86
+				if (simd::has_avx2()) {
+					return avx2::minmax(first, n);
+				}
+#endif
+				return scalar::minmax(first, n);
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -17,6 +17,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/forward_sort.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
@@ -34,9 +35,22 @@ STL2_OPEN_NAMESPACE {
 			return first;
 		}
 		auto last = __stl2::next(first, std::move(sent));
-		auto n = __stl2::distance(first, last);
-		detail::rsort::introsort_loop(first, last, detail::rsort::log2(n) * 2, comp, proj);
-		detail::rsort::final_insertion_sort(first, last, comp, proj);
+		detail::rsort::pdqsort(first, last, comp, proj);
+		return last;
+	}
+
+	template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
+		class Proj = identity>
+	requires
+		ext::RadixSortable<I, Comp, Proj>
+	I sort(I first, S sent, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		auto last = __stl2::next(first, std::move(sent));
+		auto n = difference_type_t<I>(last - first);
+		if (n < detail::radix::sort_threshold ||
+			!detail::radix::sort_n(first, n, comp, proj)) {
+			detail::rsort::pdqsort(first, last, comp, proj);
+		}
 		return last;
 	}
 
@@ -61,9 +75,22 @@ STL2_OPEN_NAMESPACE {
 				return first;
 			}
 			auto last = __stl2::next(first, std::move(sent));
-			auto n = __stl2::distance(first, last);
-			detail::rsort::introsort_loop(first, last, detail::rsort::log2(n) * 2, comp, proj);
-			detail::rsort::final_insertion_sort(first, last, comp, proj);
+			detail::rsort::pdqsort(first, last, comp, proj);
+			return last;
+		}
+
+		template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
+			class Proj = identity>
+		requires
+			RadixSortable<I, Comp, Proj>
+		I sort(I first, S sent, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto last = __stl2::next(first, std::move(sent));
+			auto n = difference_type_t<I>(last - first);
+			if (n < detail::radix::sort_threshold ||
+				!detail::radix::sort_n(first, n, comp, proj)) {
+				detail::rsort::pdqsort(first, last, comp, proj);
+			}
 			return last;
 		}
 
@@ -33,7 +33,7 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		template <RandomAccessIterator I, class Comp, class Proj>
+		template <int D = 2, RandomAccessIterator I, class Comp, class Proj>
 		requires
 			Sortable<I, Comp, Proj>
 		void sort_heap_n(I first, difference_type_t<I> n, Comp comp, Proj proj)
@@ -43,7 +43,7 @@ STL2_OPEN_NAMESPACE {
 			}
 
 			for (auto i = n; i > 1; --i) {
-				detail::pop_heap_n(first, i, std::ref(comp), std::ref(proj));
+				detail::pop_heap_n<D>(first, i, std::ref(comp), std::ref(proj));
 			}
 		}
 	}
@@ -69,6 +69,35 @@ STL2_OPEN_NAMESPACE {
 		detail::sort_heap_n(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
 		return __stl2::begin(rng) + n;
 	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// sort_heap<D> [Extension]
+		//
+		template <int D, RandomAccessIterator I, Sentinel<I> S,
+			class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<I, Comp, Proj>
+		I sort_heap(I first, S last, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(first, std::move(last));
+			detail::sort_heap_n<D>(first, n, std::ref(comp), std::ref(proj));
+			return first + n;
+		}
+
+		template <int D, RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
+		requires
+			(D >= 2) &&
+			Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng>
+		sort_heap(Rng&& rng, Comp comp = Comp{}, Proj proj = Proj{})
+		{
+			auto n = __stl2::distance(rng);
+			detail::sort_heap_n<D>(__stl2::begin(rng), n, std::ref(comp), std::ref(proj));
+			return __stl2::begin(rng) + n;
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -39,10 +39,14 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/forward_sort.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/inplace_merge.hpp>
-#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/max.hpp>
 #include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -54,107 +58,181 @@ STL2_OPEN_NAMESPACE {
 			template <class I>
 			using buf_t = temporary_buffer<value_type_t<I>>;
 
-			constexpr int merge_sort_chunk_size = 7;
+			// Runs shorter than this are extended with insertion sort.
+			constexpr std::ptrdiff_t min_merge = 64;
 
-			template <RandomAccessIterator I, class C, class P>
-			requires
-				Sortable<I, C, P>
-			void inplace_stable_sort(I first, I last, C &pred, P &proj)
-			{
-				if (last - first < 15) {
-					rsort::insertion_sort(first, last, pred, proj);
-				} else {
-					I middle = first + difference_type_t<I>(last - first) / 2;
-					ssort::inplace_stable_sort(first, middle, pred, proj);
-					ssort::inplace_stable_sort(middle, last, pred, proj);
-					detail::inplace_merge_no_buffer(first, middle, last,
-						middle - first, last - middle,
-						std::ref(pred), std::ref(proj));
-				}
-			}
-
-			template <RandomAccessIterator I, WeaklyIncrementable O, class C, class P>
-			requires
-				Sortable<I, C, P>
-			void merge_sort_loop(I first, I last, O result,
-				difference_type_t<I> step_size, C &pred, P &proj)
+			// Between min_merge / 2 and min_merge, such that n / minrun is a
+			// power of two or just below one.
+			template <class D>
+			constexpr D min_run_length(D n) noexcept
 			{
-				auto two_step = difference_type_t<I>(2 * step_size);
-				while (last - first >= two_step) {
-					result = __stl2::merge(
-						__stl2::make_move_iterator(first),
-						__stl2::make_move_iterator(first + step_size),
-						__stl2::make_move_iterator(first + step_size),
-						__stl2::make_move_iterator(first + two_step),
-						result, std::ref(pred),
-						std::ref(proj), std::ref(proj)).out();
-					first += two_step;
+				D r = 0;
+				while (n >= min_merge) {
+					r |= n & 1;
+					n >>= 1;
 				}
-				step_size = __stl2::min(difference_type_t<I>(last - first), step_size);
-				__stl2::merge(
-					__stl2::make_move_iterator(first),
-					__stl2::make_move_iterator(first + step_size),
-					__stl2::make_move_iterator(first + step_size),
-					__stl2::make_move_iterator(last),
-					result, std::ref(pred),
-					std::ref(proj), std::ref(proj));
+				return n + r;
 			}
 
+			// Length of the run starting at first; a strictly descending run
+			// is reversed so that it ascends.
 			template <RandomAccessIterator I, class C, class P>
 			requires
 				Sortable<I, C, P>
-			void chunk_insertion_sort(I first, I last, difference_type_t<I> chunk_size,
-				C &comp, P &proj)
+			difference_type_t<I> count_run(I first, I last, C& comp, P& proj)
 			{
-				while (last - first >= chunk_size) {
-					rsort::insertion_sort(first, first + chunk_size, comp, proj);
-					first += chunk_size;
+				I run = __stl2::next(first);
+				if (run == last) {
+					return 1;
+				}
+				if (__stl2::invoke(comp, __stl2::invoke(proj, *run), __stl2::invoke(proj, *first))) {
+					do {
+						++run;
+					} while (run != last &&
+						__stl2::invoke(comp, __stl2::invoke(proj, *run), __stl2::invoke(proj, *__stl2::prev(run))));
+					__stl2::reverse(first, run);
+				} else {
+					do {
+						++run;
+					} while (run != last &&
+						!__stl2::invoke(comp, __stl2::invoke(proj, *run), __stl2::invoke(proj, *__stl2::prev(run))));
 				}
-				rsort::insertion_sort(first, last, comp, proj);
+				return run - first;
 			}
 
+			// TimSort: natural runs, extended to min_run_length, are kept on a
+			// stack whose lengths shrink at least as fast as the Fibonacci
+			// numbers, and adjacent runs are merged with galloping. Sorted,
+			// reversed and concatenated sorted inputs take O(n) comparisons.
+			// The buffer holds the shorter run of a merge, so it is never
+			// allocated for sorted input and never exceeds n / 2; without
+			// one, runs are merged in place.
 			template <RandomAccessIterator I, class C, class P>
 			requires
 				Sortable<I, C, P>
-			void merge_sort_with_buffer(I first, I last, buf_t<I>& buf, C &comp, P &proj)
-			{
-				auto len = difference_type_t<I>(last - first);
-				auto step_size = difference_type_t<I>(merge_sort_chunk_size);
-				ssort::chunk_insertion_sort(first, last, step_size, comp, proj);
-				if (step_size >= len) {
-					return;
+			class timsort {
+				using D = difference_type_t<I>;
+
+				// Enough for any D: run lengths grow faster than Fibonacci.
+				static constexpr int max_runs = 96;
+
+				I first_;
+				D n_;
+				C& comp_;
+				P& proj_;
+				buf_t<I> buf_;
+				bool buf_exhausted_ = false;
+				D base_[max_runs];
+				D len_[max_runs];
+				int runs_ = 0;
+
+				void reserve(D need) {
+					if (need <= buf_.size() || buf_exhausted_) {
+						return;
+					}
+					auto const want = __stl2::min(
+						__stl2::max(need, D(2 * buf_.size())), D(n_ / 2));
+					buf_ = buf_t<I>{want};
+					buf_exhausted_ = buf_.size() < need;
 				}
-				temporary_vector<value_type_t<I>> vec{buf};
-				ssort::merge_sort_loop(first, last, __stl2::back_inserter(vec), step_size, comp, proj);
-				step_size *= 2;
-				while (true) {
-					ssort::merge_sort_loop(vec.begin(), vec.end(), first, step_size, comp, proj);
-					step_size *= 2;
-					if (step_size >= len) {
+
+				// Merges runs i and i + 1.
+				void merge_at(int i) {
+					auto base1 = base_[i];
+					auto len1 = len_[i];
+					auto const base2 = base_[i + 1];
+					auto len2 = len_[i + 1];
+					len_[i] = len1 + len2;
+					if (i == runs_ - 3) {
+						base_[i + 1] = base_[i + 2];
+						len_[i + 1] = len_[i + 2];
+					}
+					--runs_;
+
+					// Elements of run 1 not greater than the first of run 2, and
+					// of run 2 not less than the last of run 1, are in place.
+					auto const middle = first_ + base2;
+					auto const skip = detail::gallop::upper_bound(first_ + base1, len1,
+						__stl2::invoke(proj_, *middle), comp_, proj_) - (first_ + base1);
+					base1 += skip;
+					len1 -= skip;
+					if (len1 == 0) {
+						return;
+					}
+					len2 = __stl2::ext::lower_bound_n(middle, len2,
+						__stl2::invoke(proj_, *__stl2::prev(middle)),
+						std::ref(comp_), std::ref(proj_)) - middle;
+					if (len2 == 0) {
 						return;
 					}
-					ssort::merge_sort_loop(first, last, vec.begin(), step_size, comp, proj);
-					step_size *= 2;
+
+					reserve(__stl2::min(len1, len2));
+					detail::merge_adaptive(first_ + base1, middle, middle + len2,
+						len1, len2, buf_, std::ref(comp_), std::ref(proj_));
 				}
-			}
+
+				// Merges until the run lengths satisfy, from the top of the
+				// stack down, len[i - 2] > len[i - 1] + len[i] and
+				// len[i - 1] > len[i].
+				void merge_collapse() {
+					while (runs_ > 1) {
+						int i = runs_ - 2;
+						if ((i > 0 && len_[i - 1] <= len_[i] + len_[i + 1]) ||
+							(i > 1 && len_[i - 2] <= len_[i - 1] + len_[i])) {
+							if (len_[i - 1] < len_[i + 1]) {
+								--i;
+							}
+						} else if (len_[i] > len_[i + 1]) {
+							break;
+						}
+						merge_at(i);
+					}
+				}
+
+				void merge_force_collapse() {
+					while (runs_ > 1) {
+						int i = runs_ - 2;
+						if (i > 0 && len_[i - 1] < len_[i + 1]) {
+							--i;
+						}
+						merge_at(i);
+					}
+				}
+
+			public:
+				timsort(I first, D n, C& comp, P& proj)
+				: first_{first}, n_{n}, comp_{comp}, proj_{proj} {}
+
+				void operator()() {
+					auto const min_run = ssort::min_run_length(n_);
+					auto const last = first_ + n_;
+					for (D lo = 0; lo < n_;) {
+						auto len = ssort::count_run(first_ + lo, last, comp_, proj_);
+						if (len < min_run) {
+							auto const force = __stl2::min(min_run, D(n_ - lo));
+							rsort::insertion_sort(first_ + lo, first_ + lo + force, comp_, proj_);
+							len = force;
+						}
+						STL2_EXPECT(runs_ < max_runs);
+						base_[runs_] = lo;
+						len_[runs_] = len;
+						++runs_;
+						merge_collapse();
+						lo += len;
+					}
+					merge_force_collapse();
+				}
+			};
 
 			template <RandomAccessIterator I, class C, class P>
 			requires
 				Sortable<I, C, P>
-			void stable_sort_adaptive(I first, I last, buf_t<I>& buf, C &comp, P &proj)
+			void merge_sort(I first, I last, C& comp, P& proj)
 			{
-				auto len = difference_type_t<I>((last - first + 1) / 2);
-				auto middle = first + len;
-				if (len > buf.size()) {
-					ssort::stable_sort_adaptive(first, middle, buf, comp, proj);
-					ssort::stable_sort_adaptive(middle, last, buf, comp, proj);
-				} else {
-					ssort::merge_sort_with_buffer(first, middle, buf, comp, proj);
-					ssort::merge_sort_with_buffer(middle, last, buf, comp, proj);
+				auto const n = difference_type_t<I>(last - first);
+				if (n > 1) {
+					timsort<I, C, P>{first, n, comp, proj}();
 				}
-				detail::merge_adaptive(first, middle, last,
-					middle - first, last - middle, buf,
-					std::ref(comp), std::ref(proj));
 			}
 		}
 	}
@@ -179,13 +257,22 @@ STL2_OPEN_NAMESPACE {
 	I stable_sort(I first, S&& last_, Comp comp = Comp{}, Proj proj = Proj{})
 	{
 		auto last = __stl2::next(first, std::forward<S>(last_));
-		auto len = difference_type_t<I>(last - first);
-		using buf_t = detail::ssort::buf_t<I>;
-		auto buf = len > 256 ? buf_t{len} : buf_t{};
-		if (!buf.size_) {
-			detail::ssort::inplace_stable_sort(first, last, comp, proj);
-		} else {
-			detail::ssort::stable_sort_adaptive(first, last, buf, comp, proj);
+		detail::ssort::merge_sort(first, last, comp, proj);
+		return last;
+	}
+
+	template <RandomAccessIterator I, class S, class Comp = less<>,
+						class Proj = identity>
+	requires
+		Sentinel<__f<S>, I> &&
+		ext::RadixSortable<I, Comp, Proj>
+	I stable_sort(I first, S&& last_, Comp comp = Comp{}, Proj proj = Proj{})
+	{
+		auto last = __stl2::next(first, std::forward<S>(last_));
+		auto n = difference_type_t<I>(last - first);
+		if (n < detail::radix::sort_threshold ||
+			!detail::radix::sort_n(first, n, comp, proj)) {
+			detail::ssort::merge_sort(first, last, comp, proj);
 		}
 		return last;
 	}
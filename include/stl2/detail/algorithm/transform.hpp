@@ -39,6 +39,29 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O,
+		CopyConstructible F, class Proj = identity>
+	requires
+		Writable<O,
+			indirect_result_of_t<F&(projected<I, Proj>)>> &&
+		detail::StreambufOutput<O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	transform(I first, S last, O result, F op, Proj proj = Proj{})
+	{
+		auto out = detail::ostreambuf_writer<
+			typename O::char_type, typename O::traits_type>{result};
+		try {
+			for (; first != last; ++first) {
+				out.put(__stl2::invoke(op, __stl2::invoke(proj, *first)));
+			}
+		} catch (...) {
+			out.flush();
+			throw;
+		}
+		out.flush();
+		return {std::move(first), std::move(result)};
+	}
+
 	template <InputRange R, WeaklyIncrementable O, CopyConstructible F, class Proj = identity>
 	requires
 		Writable<O,
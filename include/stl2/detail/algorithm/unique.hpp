@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/adjacent_find.hpp>
+#include <stl2/detail/algorithm/simd_compress.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -43,6 +44,23 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <ForwardIterator I, Sentinel<I> S,
+		class R = equal_to<>, class Proj = identity>
+	requires
+		Permutable<I> &&
+		IndirectRelation<__f<R>, projected<I, Proj>> &&
+		detail::simd::LaneRange<I, S, Proj> &&
+		__bool<detail::simd::is_equal_to<R>>
+	I unique(I first, S last, R = R{}, Proj = Proj{})
+	{
+		auto const n = difference_type_t<I>(last - first);
+		if (n == 0) {
+			return first;
+		}
+		auto const p = detail::addressof(*first);
+		return first + (detail::simd::unique(p, p + n) - p);
+	}
+
 	template <ForwardRange Rng, class R = equal_to<>, class Proj = identity>
 	requires
 		Permutable<iterator_t<Rng>> &&
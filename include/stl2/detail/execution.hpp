@@ -0,0 +1,59 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_HPP
+#define STL2_DETAIL_EXECUTION_HPP
+
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Execution policies [Extension]
+//
+// Passing ext::par or ext::par_unseq as the first argument of an algorithm
+// selects its parallel overload, which runs on detail::thread_pool. The
+// two policies are currently executed identically.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		struct parallel_policy {
+			explicit parallel_policy() = default;
+		};
+		struct parallel_unsequenced_policy {
+			explicit parallel_unsequenced_policy() = default;
+		};
+
+		inline namespace {
+			constexpr auto& par = detail::static_const<parallel_policy>::value;
+			constexpr auto& par_unseq =
+				detail::static_const<parallel_unsequenced_policy>::value;
+		}
+
+		template <class>
+		constexpr bool is_execution_policy = false;
+		template <>
+		constexpr bool is_execution_policy<parallel_policy> = true;
+		template <>
+		constexpr bool is_execution_policy<parallel_unsequenced_policy> = true;
+
+		template <class E>
+		concept bool ExecutionPolicy =
+			is_execution_policy<__uncvref<E>>;
+	}
+
+	namespace models {
+		template <class>
+		constexpr bool ExecutionPolicy = false;
+		__stl2::ext::ExecutionPolicy{E}
+		constexpr bool ExecutionPolicy<E> = true;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -18,6 +18,7 @@
 #include <stl2/detail/meta.hpp>
 #include <stl2/detail/concepts/compare.hpp>
 #include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/concepts/object.hpp>
 
 STL2_OPEN_NAMESPACE {
 	///////////////////////////////////////////////////////////////////////////
@@ -165,6 +166,66 @@ STL2_OPEN_NAMESPACE {
 	struct less_equal<T*> : private std::less_equal<T*> {
 		using std::less_equal<T*>::operator();
 	};
+
+	///////////////////////////////////////////////////////////////////////////
+	// less_than, greater_than, equal_to_value, not_equal_to_value [Extension]
+	// Unary predicates that compare their argument with a stored value:
+	// less_than(x)(y) is y < x. remove_if, copy_if and friends vectorize them
+	// over contiguous arithmetic elements of the stored value's type.
+	//
+	namespace ext {
+		template <CopyConstructible T>
+		struct less_than {
+			T value;
+
+			constexpr explicit less_than(T v) : value(std::move(v)) {}
+
+			template <class U>
+			requires StrictTotallyOrderedWith<U, T>
+			constexpr bool operator()(const U& u) const {
+				return u < value;
+			}
+		};
+
+		template <CopyConstructible T>
+		struct greater_than {
+			T value;
+
+			constexpr explicit greater_than(T v) : value(std::move(v)) {}
+
+			template <class U>
+			requires StrictTotallyOrderedWith<U, T>
+			constexpr bool operator()(const U& u) const {
+				return u > value;
+			}
+		};
+
+		template <CopyConstructible T>
+		struct equal_to_value {
+			T value;
+
+			constexpr explicit equal_to_value(T v) : value(std::move(v)) {}
+
+			template <class U>
+			requires EqualityComparableWith<U, T>
+			constexpr bool operator()(const U& u) const {
+				return u == value;
+			}
+		};
+
+		template <CopyConstructible T>
+		struct not_equal_to_value {
+			T value;
+
+			constexpr explicit not_equal_to_value(T v) : value(std::move(v)) {}
+
+			template <class U>
+			requires EqualityComparableWith<U, T>
+			constexpr bool operator()(const U& u) const {
+				return u != value;
+			}
+		};
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
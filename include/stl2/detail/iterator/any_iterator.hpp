@@ -13,60 +13,74 @@
 #define STL2_DETAIL_ITERATOR_ANY_ITERATOR_HPP
 
 #include <atomic>
+#include <cstddef>
 #include <exception>
 #include <new>
 #include <stl2/type_traits.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
 #include <stl2/detail/swap.hpp>
 #include <stl2/detail/concepts/core.hpp>
 #include <stl2/detail/iterator/basic_iterator.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 
+///////////////////////////////////////////////////////////////////////////
+// any_input_iterator [Extension]
+//
+// A type-erased input iterator. Iterators that fit the inline buffer of
+// the storage policy, and move without throwing, are held in place; larger
+// ones live in a reference counted heap block shared by copies, as input
+// iterators may be. Each erased type has a static table of operations, so
+// an increment or comparison is one indirect call.
+//
 STL2_OPEN_NAMESPACE {
-	namespace __any_iterator {
-		enum class op { copy, move, nuke, bump, comp, rval };
+	namespace ext {
+		// Storage policy for any_input_iterator: the size of the inline
+		// buffer, and whether the count of a shared heap block is atomic.
+		// Without ThreadSafe, copies of an iterator must stay on one thread.
+		template <std::size_t BufferSize = 2 * sizeof(void*), bool ThreadSafe = true>
+		struct any_iterator_storage {
+			static_assert(BufferSize >= sizeof(void*),
+				"any_iterator_storage needs room for a pointer");
+			static constexpr std::size_t buffer_size = BufferSize;
+			static constexpr bool thread_safe = ThreadSafe;
+		};
+	}
 
+	namespace __any_iterator {
+		template <bool ThreadSafe>
 		struct counted {
-			std::atomic<long> cnt{ 1 };
+			meta::if_c<ThreadSafe, std::atomic<long>, long> cnt{ 1 };
 		};
-		InputIterator{I} struct shared_iterator : counted {
+		template <InputIterator I, bool ThreadSafe>
+		struct shared_iterator : counted<ThreadSafe> {
 			shared_iterator(I i) : it(std::move(i)) {}
 			I it;
 		};
 
+		template <class Storage>
 		union blob {
-			counted* big;
-			std::aligned_storage_t<2 * sizeof(void *)> tiny;
+			counted<Storage::thread_safe>* big;
+			std::aligned_storage_t<Storage::buffer_size> tiny;
 		};
 
-		template <class It>
-		using is_small =
-			std::integral_constant<bool, (sizeof(It) <= sizeof(blob::tiny))>;
-		using small_tag = std::true_type;
-		using big_tag = std::false_type;
-
-		template <class RValueReference>
-		using iter_move_fn = RValueReference (*)(blob const &);
-
-		template <class RValueReference>
-		inline iter_move_fn<RValueReference> uninit_noop(op, blob *, blob *) {
-			return nullptr;
-		}
-
-		template <class Reference>
-		[[noreturn]] inline Reference uninit_deref(blob const &) {
-			std::terminate();
-		}
+		template <class It, class Storage>
+		using is_small = meta::bool_<
+			sizeof(It) <= sizeof(blob<Storage>::tiny) &&
+			alignof(It) <= alignof(blob<Storage>) &&
+			std::is_nothrow_move_constructible<It>::value>;
 
-		template <class Reference, InputIterator I>
-		Reference deref_small(blob const &src) {
-			return **static_cast<I const *>(static_cast<void const *>(&src.tiny));
-		}
-
-		template <class Reference, InputIterator I>
-		Reference deref_big(blob const &src) {
-			return *static_cast<shared_iterator<I> const *>(src.big)->it;
-		}
+		template <class Reference, class RValueReference, class Storage>
+		struct vtable {
+			using blob_t = blob<Storage>;
+			void (*copy)(blob_t const &src, blob_t &dst);
+			void (*move)(blob_t &src, blob_t &dst) noexcept;
+			void (*nuke)(blob_t &src) noexcept;
+			void (*next)(blob_t &src);
+			bool (*equal)(blob_t const &, blob_t const &);
+			Reference (*deref)(blob_t const &src);
+			RValueReference (*rval)(blob_t const &src);
+		};
 
 		template <class I, class J>
 		constexpr bool iter_equal(I const &, J const &) {
@@ -78,104 +92,143 @@ STL2_OPEN_NAMESPACE {
 			return i == j;
 		}
 
-		template <class RValueReference, InputIterator I>
-		iter_move_fn<RValueReference> exec_small(op o, blob *src, blob *dst) {
-			switch (o) {
-			case op::copy:
-				::new (static_cast<void *>(&dst->tiny))
-					I(*static_cast<I const *>(static_cast<void *>(&src->tiny)));
-				break;
-			case op::move:
-				::new (static_cast<void *>(&dst->tiny))
-					I(std::move(*static_cast<I *>(static_cast<void *>(&src->tiny))));
-				// fallthrough
-			case op::nuke:
-				static_cast<I *>(static_cast<void *>(&src->tiny))->~I();
-				break;
-			case op::bump:
-				++*static_cast<I *>(static_cast<void *>(&src->tiny));
-				break;
-			case op::comp:
-				if (__any_iterator::iter_equal(
-					*static_cast<I const *>(static_cast<void *>(&src->tiny)),
-					*static_cast<I const *>(static_cast<void *>(&dst->tiny)))) {
-					// fallthrough
-			case op::rval:
-					return +[](blob const &src) -> RValueReference {
-						return __stl2::iter_move(
-							*static_cast<I const *>(static_cast<void const *>(&src.tiny)));
-					};
-				}
+		// The operations on an empty blob.
+		template <class Reference, class RValueReference, class Storage>
+		struct uninit {
+			using blob_t = blob<Storage>;
+			static void copy(blob_t const &, blob_t &) {}
+			static void move(blob_t &, blob_t &) noexcept {}
+			static void nuke(blob_t &) noexcept {}
+			static void next(blob_t &) {}
+			static bool equal(blob_t const &, blob_t const &) { return false; }
+			[[noreturn]] static Reference deref(blob_t const &) { std::terminate(); }
+			[[noreturn]] static RValueReference rval(blob_t const &) { std::terminate(); }
+		};
+
+		// The operations on an I held in place.
+		template <class Storage, InputIterator I>
+		struct small {
+			using blob_t = blob<Storage>;
+			static I &get(blob_t &b) noexcept {
+				return *static_cast<I *>(static_cast<void *>(&b.tiny));
 			}
-			return nullptr;
-		}
+			static I const &get(blob_t const &b) noexcept {
+				return *static_cast<I const *>(static_cast<void const *>(&b.tiny));
+			}
+			static void copy(blob_t const &src, blob_t &dst) {
+				::new (static_cast<void *>(&dst.tiny)) I(get(src));
+			}
+			static void move(blob_t &src, blob_t &dst) noexcept {
+				::new (static_cast<void *>(&dst.tiny)) I(std::move(get(src)));
+				get(src).~I();
+			}
+			static void nuke(blob_t &src) noexcept {
+				get(src).~I();
+			}
+			static void next(blob_t &src) {
+				++get(src);
+			}
+			static bool equal(blob_t const &x, blob_t const &y) {
+				return __any_iterator::iter_equal(get(x), get(y));
+			}
+			template <class Reference>
+			static Reference deref(blob_t const &src) {
+				return *get(src);
+			}
+			template <class RValueReference>
+			static RValueReference rval(blob_t const &src) {
+				return __stl2::iter_move(get(src));
+			}
+		};
 
-		template <class RValueReference, InputIterator I>
-		iter_move_fn<RValueReference> exec_big(op o, blob *src, blob *dst) {
-			switch (o) {
-			case op::copy:
-				++(dst->big = src->big)->cnt;
-				break;
-			case op::move:
-				dst->big = __stl2::exchange(src->big, nullptr);
-				break;
-			case op::nuke:
-				if (0 == --src->big->cnt)
-					delete static_cast<shared_iterator<I>*>(src->big);
-				break;
-			case op::bump:
-				++static_cast<shared_iterator<I> *>(src->big)->it;
-				break;
-			case op::comp:
-				if (__any_iterator::iter_equal(
-					static_cast<shared_iterator<I> const *>(src->big)->it,
-					static_cast<shared_iterator<I> const *>(dst->big)->it)) {
-					// fallthrough
-			case op::rval:
-					return +[](blob const &src) -> RValueReference {
-						return __stl2::iter_move(
-							static_cast<shared_iterator<I> const *>(src.big)->it);
-					};
+		// The operations on an I in a shared heap block.
+		template <class Storage, InputIterator I>
+		struct big {
+			using blob_t = blob<Storage>;
+			using shared_t = shared_iterator<I, Storage::thread_safe>;
+			static I &get(blob_t const &b) noexcept {
+				return static_cast<shared_t *>(b.big)->it;
+			}
+			static void copy(blob_t const &src, blob_t &dst) {
+				++(dst.big = src.big)->cnt;
+			}
+			static void move(blob_t &src, blob_t &dst) noexcept {
+				dst.big = __stl2::exchange(src.big, nullptr);
+			}
+			static void nuke(blob_t &src) noexcept {
+				if (0 == --src.big->cnt) {
+					delete static_cast<shared_t *>(src.big);
 				}
 			}
-			return nullptr;
-		}
+			static void next(blob_t &src) {
+				++get(src);
+			}
+			static bool equal(blob_t const &x, blob_t const &y) {
+				return __any_iterator::iter_equal(get(x), get(y));
+			}
+			template <class Reference>
+			static Reference deref(blob_t const &src) {
+				return *get(src);
+			}
+			template <class RValueReference>
+			static RValueReference rval(blob_t const &src) {
+				return __stl2::iter_move(get(src));
+			}
+		};
 
-		template <class Reference, class ValueType, class RValueReference>
+		template <class Reference, class RValueReference, class Storage>
+		constexpr vtable<Reference, RValueReference, Storage> uninit_table = {
+			&uninit<Reference, RValueReference, Storage>::copy,
+			&uninit<Reference, RValueReference, Storage>::move,
+			&uninit<Reference, RValueReference, Storage>::nuke,
+			&uninit<Reference, RValueReference, Storage>::next,
+			&uninit<Reference, RValueReference, Storage>::equal,
+			&uninit<Reference, RValueReference, Storage>::deref,
+			&uninit<Reference, RValueReference, Storage>::rval
+		};
+
+		template <class Reference, class RValueReference, class Storage, class Ops>
+		constexpr vtable<Reference, RValueReference, Storage> table = {
+			&Ops::copy,
+			&Ops::move,
+			&Ops::nuke,
+			&Ops::next,
+			&Ops::equal,
+			&Ops::template deref<Reference>,
+			&Ops::template rval<RValueReference>
+		};
+
+		template <class Reference, class ValueType, class RValueReference, class Storage>
 		struct cursor {
 		private:
-			blob data_ = { nullptr };
-			Reference (*deref_)(blob const &) =
-				&uninit_deref<Reference>;
-			iter_move_fn<RValueReference> (*exec_)(op, blob *, blob *) =
-				&uninit_noop<RValueReference>;
+			using vtable_t = vtable<Reference, RValueReference, Storage>;
+
+			blob<Storage> data_ = { nullptr };
+			vtable_t const *vtable_ =
+				&uninit_table<Reference, RValueReference, Storage>;
 
-			InputIterator{I} cursor(I i, small_tag) {
+			InputIterator{I} cursor(I i, std::true_type) {
 				::new (static_cast<void *>(&data_.tiny)) I(std::move(i));
-				deref_ = &deref_small<Reference, I>;
-				exec_ = &exec_small<RValueReference, I>;
+				vtable_ = &table<Reference, RValueReference, Storage, small<Storage, I>>;
 			}
-			InputIterator{I} cursor(I i, big_tag) {
-				data_.big = new shared_iterator<I>(std::move(i));
-				deref_ = &deref_big<Reference, I>;
-				exec_ = &exec_big<RValueReference, I>;
+			InputIterator{I} cursor(I i, std::false_type) {
+				data_.big = new shared_iterator<I, Storage::thread_safe>(std::move(i));
+				vtable_ = &table<Reference, RValueReference, Storage, big<Storage, I>>;
 			}
 			void reset() noexcept {
-				exec_(op::nuke, &data_, nullptr);
-				deref_ = &uninit_deref<Reference>;
-				exec_ = &uninit_noop<RValueReference>;
+				vtable_->nuke(data_);
+				vtable_ = &uninit_table<Reference, RValueReference, Storage>;
 			}
 			void copy_from(cursor const &that) {
 				// Pre: *this is empty
-				that.exec_(op::copy, const_cast<blob *>(&that.data_), &data_);
-				deref_ = that.deref_;
-				exec_ = that.exec_;
+				that.vtable_->copy(that.data_, data_);
+				vtable_ = that.vtable_;
 			}
-			void move_from(cursor &that) {
+			void move_from(cursor &that) noexcept {
 				// Pre: *this is empty
-				that.exec_(op::move, &that.data_, &data_);
-				__stl2::swap(deref_, that.deref_);
-				__stl2::swap(exec_, that.exec_);
+				that.vtable_->move(that.data_, data_);
+				vtable_ = __stl2::exchange(that.vtable_,
+					&uninit_table<Reference, RValueReference, Storage>);
 			}
 		public:
 			using value_type = ValueType;
@@ -198,16 +251,16 @@ STL2_OPEN_NAMESPACE {
 			};
 
 			cursor() = default;
-			cursor(cursor &&that) {
+			cursor(cursor &&that) noexcept {
 				move_from(that);
 			}
 			cursor(cursor const &that) {
 				copy_from(that);
 			}
 			InputIterator{I} cursor(I i)
-			: cursor{std::move(i), is_small<I>{}}
+			: cursor{std::move(i), is_small<I, Storage>{}}
 			{}
-			cursor &operator=(cursor &&that) {
+			cursor &operator=(cursor &&that) noexcept {
 				if (&that != this) {
 					reset();
 					move_from(that);
@@ -222,29 +275,29 @@ STL2_OPEN_NAMESPACE {
 				return *this;
 			}
 			~cursor() {
-				exec_(op::nuke, &data_, nullptr);
+				vtable_->nuke(data_);
 			}
 			Reference read() const {
-				return deref_(data_);
+				return vtable_->deref(data_);
 			}
 			bool equal(cursor const &that) const {
-				return exec_(op::comp, const_cast<blob *>(&data_),
-					const_cast<blob *>(&that.data_)) != nullptr;
+				return vtable_->equal(data_, that.data_);
 			}
 			void next() {
-				exec_(op::bump, &data_, nullptr);
+				vtable_->next(data_);
 			}
 			RValueReference indirect_move() const {
-				return exec_(op::rval, nullptr, nullptr)(data_);
+				return vtable_->rval(data_);
 			}
 		};
 	}
 
 	template <class Reference,
 		class ValueType = __uncvref<Reference>,
-		class RValueReference = __iter_move::rvalue<Reference>>
+		class RValueReference = __iter_move::rvalue<Reference>,
+		class Storage = ext::any_iterator_storage<>>
 	using any_input_iterator =
-		basic_iterator<__any_iterator::cursor<Reference, ValueType, RValueReference>>;
+		basic_iterator<__any_iterator::cursor<Reference, ValueType, RValueReference, Storage>>;
 
 } STL2_CLOSE_NAMESPACE
 
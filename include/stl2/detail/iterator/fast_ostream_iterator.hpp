@@ -0,0 +1,139 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ITERATOR_FAST_OSTREAM_ITERATOR_HPP
+#define STL2_DETAIL_ITERATOR_FAST_OSTREAM_ITERATOR_HPP
+
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#include <ostream>
+#include <string>
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+#include <stl2/detail/memory/addressof.hpp>
+
+// Not included by <stl2/iterator.hpp>: fast_ostream_iterator is defined
+// only where the standard library has std::to_chars for floating-point
+// numbers as well as integers, as __cpp_lib_to_chars says.
+#ifdef __cpp_lib_to_chars
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// The arithmetic types std::to_chars formats; operator<< writes bool
+		// and the character types otherwise.
+		template <class T>
+		concept bool ToCharsNumber =
+			ext::Arithmetic<T> &&
+			!_OneOf<T, bool, char, signed char, unsigned char,
+				wchar_t, char16_t, char32_t>;
+
+		// Room for any number to_chars writes in its shortest form.
+		constexpr std::ptrdiff_t to_chars_max = 128;
+
+		// Writes t to out as std::to_chars does and returns how many
+		// characters it wrote, at most to_chars_max.
+		template <class traits, ToCharsNumber T>
+		std::streamsize to_stream_chars(char* out, const T& t,
+			const std::basic_ostream<char, traits>&)
+		{
+			auto const r = std::to_chars(out, out + to_chars_max, t);
+			STL2_EXPECT(r.ec == std::errc{});
+			return r.ptr - out;
+		}
+
+		// Other character types get the chars widened by the stream.
+		template <class charT, class traits, ToCharsNumber T>
+		std::streamsize to_stream_chars(charT* out, const T& t,
+			const std::basic_ostream<charT, traits>& os)
+		{
+			char chars[to_chars_max];
+			auto const r = std::to_chars(chars, chars + to_chars_max, t);
+			STL2_EXPECT(r.ec == std::errc{});
+			std::streamsize n = 0;
+			for (auto p = chars; p != r.ptr; ++p) {
+				out[n++] = os.widen(*p);
+			}
+			return n;
+		}
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// fast_ostream_iterator [Extension]
+		// An ostream_iterator for numbers that formats them with std::to_chars,
+		// and hands each number and its delimiter to the stream buffer in a
+		// single sputn. It ignores the stream's format flags, width and
+		// locale, writes floating-point numbers in their shortest
+		// round-tripping form rather than to the stream's precision, and
+		// does not flush the tied stream first.
+		//
+		template <detail::ToCharsNumber T, class charT = char,
+			class traits = std::char_traits<charT>>
+		class fast_ostream_iterator {
+		public:
+			using difference_type = ptrdiff_t;
+			using char_type = charT;
+			using traits_type = traits;
+			using ostream_type = std::basic_ostream<charT, traits>;
+
+			constexpr fast_ostream_iterator() noexcept = default;
+
+			STL2_CONSTEXPR_EXT fast_ostream_iterator(
+				ostream_type& os, const charT* delimiter = nullptr) noexcept
+			: out_stream_(detail::addressof(os)), delim_(delimiter),
+				delim_size_(delimiter ? traits::length(delimiter) : 0) {}
+
+			fast_ostream_iterator& operator=(const T& t) {
+				auto& os = *out_stream_;
+				auto const sbuf = os.rdbuf();
+				if (!os.good() || !sbuf) {
+					os.setstate(std::ios_base::failbit);
+					return *this;
+				}
+				charT out[detail::to_chars_max + 32];
+				std::streamsize n = detail::to_stream_chars(out, t, os);
+				bool ok;
+				if (delim_size_ <= 32) {
+					traits::copy(out + n, delim_, static_cast<std::size_t>(delim_size_));
+					n += delim_size_;
+					ok = sbuf->sputn(out, n) == n;
+				} else {
+					ok = sbuf->sputn(out, n) == n &&
+						sbuf->sputn(delim_, delim_size_) == delim_size_;
+				}
+				if (!ok) {
+					os.setstate(std::ios_base::badbit);
+				} else if (os.flags() & std::ios_base::unitbuf) {
+					os.flush();
+				}
+				return *this;
+			}
+
+			fast_ostream_iterator& operator*() noexcept {
+				return *this;
+			}
+			fast_ostream_iterator& operator++() noexcept {
+				return *this;
+			}
+			fast_ostream_iterator& operator++(int) noexcept {
+				return *this;
+			}
+		private:
+			detail::raw_ptr<ostream_type> out_stream_{nullptr};
+			const charT* delim_{nullptr};
+			std::streamsize delim_size_{0};
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+#endif // __cpp_lib_to_chars
+
+#endif
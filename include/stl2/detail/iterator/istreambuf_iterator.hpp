@@ -12,7 +12,11 @@
 #ifndef STL2_DETAIL_ITERATOR_ISTREAMBUF_ITERATOR_HPP
 #define STL2_DETAIL_ITERATOR_ISTREAMBUF_ITERATOR_HPP
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <iosfwd>
+#include <streambuf>
 #include <string>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/raw_ptr.hpp>
@@ -168,6 +172,10 @@ STL2_OPEN_NAMESPACE {
 				return sbuf_ == nullptr;
 			}
 
+			STL2_CONSTEXPR_EXT streambuf_type* streambuf() const noexcept {
+				return sbuf_;
+			}
+
 		private:
 			detail::raw_ptr<streambuf_type> sbuf_ = nullptr;
 
@@ -186,6 +194,92 @@ STL2_OPEN_NAMESPACE {
 				return old_c;
 			}
 		};
+
+		// The get area of a basic_streambuf, through pointers to its
+		// protected members.
+		template <class charT, class traits>
+		struct get_area : std::basic_streambuf<charT, traits> {
+			using streambuf_type = std::basic_streambuf<charT, traits>;
+
+			static charT* next(streambuf_type& s) noexcept {
+				return (s.*&get_area::gptr)();
+			}
+			static charT* end(streambuf_type& s) noexcept {
+				return (s.*&get_area::egptr)();
+			}
+			static void bump(streambuf_type& s, int n) noexcept {
+				(s.*&get_area::gbump)(n);
+			}
+		};
+
+		// Feeds the characters of [first, last) to f in blocks taken straight
+		// from the get area of the stream buffer, which sgetc refills.
+		// f(p, n) returns how many characters of [p, p + n) it consumed;
+		// consuming fewer than n ends the scan. Returns the position after
+		// the last character consumed.
+		template <class charT, class traits, class F>
+		istreambuf_iterator<charT, traits>
+		for_each_block(istreambuf_iterator<charT, traits> first, default_sentinel, F f)
+		{
+			using area = get_area<charT, traits>;
+			auto const sbuf = __stl2::get_cursor(first).streambuf();
+			if (!sbuf) {
+				return first;
+			}
+			for (;;) {
+				const charT* const p = area::next(*sbuf);
+				auto const n = std::min<std::ptrdiff_t>(area::end(*sbuf) - p, INT_MAX);
+				if (n > 0) {
+					std::ptrdiff_t const k = f(p, n);
+					area::bump(*sbuf, static_cast<int>(k));
+					if (k < n) {
+						return sbuf;
+					}
+					continue;
+				}
+				auto const c = sbuf->sgetc();
+				if (traits::eq_int_type(c, traits::eof())) {
+					return default_sentinel{};
+				}
+				if (area::next(*sbuf) == area::end(*sbuf)) {
+					// Unbuffered: one character at a time.
+					charT const ch = traits::to_char_type(c);
+					if (f(&ch, 1) == 0) {
+						return sbuf;
+					}
+					sbuf->sbumpc();
+				}
+			}
+		}
+
+		template <class charT, class traits, class F>
+		istreambuf_iterator<charT, traits>
+		for_each_block(istreambuf_iterator<charT, traits> first,
+			const istreambuf_iterator<charT, traits>& last, F f)
+		{
+			// Two iterators into a stream are equal only when both or
+			// neither are at its end.
+			if (last != default_sentinel{}) {
+				return first;
+			}
+			return __istreambuf_iterator::for_each_block(
+				std::move(first), default_sentinel{}, std::move(f));
+		}
+	}
+
+	namespace detail {
+		template <class I>
+		constexpr bool is_istreambuf_iterator = false;
+		template <class charT, class traits>
+		constexpr bool is_istreambuf_iterator<
+			basic_iterator<__istreambuf_iterator::cursor<charT, traits>>> = true;
+
+		// [first, last) runs an istreambuf_iterator to the end of its stream;
+		// the algorithms read such ranges a block of the get area at a time.
+		template <class I, class S>
+		concept bool StreambufRange =
+			__bool<is_istreambuf_iterator<I>> &&
+			(Same<S, default_sentinel> || Same<S, I>);
 	}
 } STL2_CLOSE_NAMESPACE
 
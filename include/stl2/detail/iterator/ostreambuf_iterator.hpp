@@ -12,7 +12,9 @@
 #ifndef STL2_DETAIL_ITERATOR_OSTREAMBUF_ITERATOR_HPP
 #define STL2_DETAIL_ITERATOR_OSTREAMBUF_ITERATOR_HPP
 
+#include <cstddef>
 #include <iosfwd>
+#include <streambuf>
 #include <string>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/raw_ptr.hpp>
@@ -50,6 +52,15 @@ STL2_OPEN_NAMESPACE {
 			}
 			return *this;
 		}
+		// Extension: writes [s, s + n) with a single sputn.
+		ostreambuf_iterator& __sputn(const charT* s, std::streamsize n) {
+			if (sbuf_ && n > 0) {
+				if (sbuf_->sputn(s, n) < n) {
+					sbuf_ = nullptr;
+				}
+			}
+			return *this;
+		}
 		ostreambuf_iterator& operator*() noexcept {
 			return *this;
 		}
@@ -85,6 +96,48 @@ STL2_OPEN_NAMESPACE {
 	private:
 		detail::raw_ptr<streambuf_type> sbuf_{nullptr};
 	};
+
+	namespace detail {
+		template <class O>
+		constexpr bool is_ostreambuf_iterator = false;
+		template <class charT, class traits>
+		constexpr bool is_ostreambuf_iterator<ostreambuf_iterator<charT, traits>> = true;
+
+		// The algorithms write to such an iterator a block at a time.
+		template <class O>
+		concept bool StreambufOutput = __bool<is_ostreambuf_iterator<O>>;
+
+		// Collects the characters written through an ostreambuf_iterator,
+		// and hands them to its stream buffer a block at a time.
+		template <class charT, class traits>
+		class ostreambuf_writer {
+		public:
+			using iterator = ostreambuf_iterator<charT, traits>;
+
+			explicit ostreambuf_writer(iterator& out) noexcept
+			: out_{out} {}
+			ostreambuf_writer(const ostreambuf_writer&) = delete;
+			ostreambuf_writer& operator=(const ostreambuf_writer&) = delete;
+
+			void put(charT c) {
+				buf_[n_++] = std::move(c);
+				if (n_ == size) {
+					flush();
+				}
+			}
+			void flush() {
+				out_.__sputn(buf_, n_);
+				n_ = 0;
+			}
+
+		private:
+			static constexpr std::streamsize size = 512 / sizeof(charT);
+
+			iterator& out_;
+			std::streamsize n_ = 0;
+			charT buf_[size];
+		};
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
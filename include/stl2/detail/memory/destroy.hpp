@@ -13,13 +13,16 @@
 #ifndef STL2_DETAIL_MEMORY_DESTROY_HPP
 #define STL2_DETAIL_MEMORY_DESTROY_HPP
 
+#include <type_traits>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
 #include <stl2/detail/raw_ptr.hpp>
 #include <stl2/detail/swap.hpp>
 #include <stl2/detail/concepts/object.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/iterator/dangling.hpp>
+#include <stl2/detail/iterator/operations.hpp>
 #include <stl2/detail/memory/addressof.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/range/access.hpp>
@@ -60,6 +63,16 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <InputIterator I, Sentinel<I> S>
+	requires
+		Destructible<value_type_t<I>> &&
+		__ReferenceTo<I, value_type_t<I>> &&
+		_Is<value_type_t<I>, std::is_trivially_destructible>
+	I destroy(I first, S last) noexcept
+	{
+		return __stl2::next(std::move(first), std::move(last));
+	}
+
 	template <InputRange Rng>
 	requires
 		Destructible<value_type_t<iterator_t<Rng>>> &&
@@ -103,6 +116,29 @@ STL2_OPEN_NAMESPACE {
 
 			void release() noexcept { last_ = nullptr; }
 		};
+
+		template <class I>
+		struct null_destroy_guard {
+			template <class... Args>
+			explicit null_destroy_guard(Args&...) noexcept {}
+			void release() noexcept {}
+		};
+
+		// destroy_guard<I>, unless nothing could be left to destroy: the
+		// guarded construction can't throw, or the destructor is trivial.
+		template <__NoThrowForwardIterator I, bool NoThrow = false>
+		using destroy_guard_t = meta::if_c<
+			NoThrow || std::is_trivially_destructible<value_type_t<I>>::value,
+			null_destroy_guard<I>, destroy_guard<I>>;
+
+		// Constructing value_type_t<O> from R while walking I to S can't
+		// throw.
+		template <class I, class S, class O, class R>
+		constexpr bool nothrow_construct =
+			std::is_nothrow_constructible<value_type_t<O>, R>::value &&
+			noexcept(*std::declval<I&>()) &&
+			noexcept(++std::declval<I&>()) &&
+			noexcept(std::declval<I&>() != std::declval<const S&>());
 	}
 } STL2_CLOSE_NAMESPACE
 
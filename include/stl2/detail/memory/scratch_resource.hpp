@@ -0,0 +1,233 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_MEMORY_SCRATCH_RESOURCE_HPP
+#define STL2_DETAIL_MEMORY_SCRATCH_RESOURCE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// scratch_resource [Extension]
+//
+// Where the temporary buffers of stable_sort, stable_partition,
+// inplace_merge and friends come from. Like std::pmr::memory_resource, but
+// allocation failure returns nullptr: the algorithms then ask for less, or
+// fall back to their unbuffered versions.
+//
+// The default resource keeps a per-thread arena of up to
+// scratch_arena_limit bytes that is reused from call to call, so that
+// threads sorting small batches don't contend in operator new. Larger
+// requests go to operator new directly. A buffer may be released on any
+// thread, but must be released before the thread that allocated it exits.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		class scratch_resource {
+		public:
+			virtual ~scratch_resource() = default;
+
+			void* allocate(std::size_t bytes, std::size_t alignment) noexcept {
+				return do_allocate(bytes, alignment);
+			}
+			void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+				do_deallocate(p, bytes, alignment);
+			}
+
+		private:
+			virtual void* do_allocate(std::size_t bytes, std::size_t alignment) noexcept = 0;
+			virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept = 0;
+		};
+
+		// Counts for the calling thread; assign {} to reset them.
+		struct scratch_counters {
+			std::size_t allocations = 0;
+			std::size_t bytes_requested = 0;
+			// Bytes handed out from arena memory held since an earlier call.
+			std::size_t bytes_reused = 0;
+		};
+
+		inline scratch_counters& scratch_statistics() noexcept {
+			static thread_local scratch_counters counters;
+			return counters;
+		}
+
+		constexpr std::size_t scratch_arena_limit = std::size_t{1} << 20;
+	}
+
+	namespace detail {
+		// operator new for the given alignment, nullptr on failure.
+		inline void* scratch_new(std::size_t bytes, std::size_t alignment) noexcept {
+			if (alignment <= alignof(std::max_align_t)) {
+				return ::operator new(bytes, std::nothrow);
+			}
+			return ::operator new(bytes, std::align_val_t{alignment}, std::nothrow);
+		}
+
+		inline void scratch_delete(void* p, std::size_t alignment) noexcept {
+			if (alignment <= alignof(std::max_align_t)) {
+				::operator delete(p);
+			} else {
+				::operator delete(p, std::align_val_t{alignment});
+			}
+		}
+
+		// A single block that is bump-allocated while any allocation from it
+		// is live, and rewound once the last one is released. The block
+		// grows, up to the limit, when a request doesn't fit an idle block.
+		// Only the owning thread allocates, and rewinds; any thread may
+		// release.
+		class scratch_arena {
+			unsigned char* block_ = nullptr;
+			std::size_t capacity_ = 0;
+			std::size_t top_ = 0;
+			std::atomic<std::size_t> live_{0};
+
+			static constexpr std::size_t block_alignment = alignof(std::max_align_t);
+
+		public:
+			scratch_arena() = default;
+			scratch_arena(const scratch_arena&) = delete;
+			scratch_arena& operator=(const scratch_arena&) = delete;
+			~scratch_arena() {
+				STL2_EXPECT(live_.load(std::memory_order_relaxed) == 0);
+				scratch_delete(block_, block_alignment);
+			}
+
+			// Returns bytes aligned to alignment with header bytes before
+			// them, or nullptr.
+			void* allocate(std::size_t header, std::size_t bytes,
+				std::size_t alignment) noexcept
+			{
+				if (bytes > ext::scratch_arena_limit ||
+					header > ext::scratch_arena_limit - bytes) {
+					return nullptr;
+				}
+				bool const idle = live_.load(std::memory_order_acquire) == 0;
+				if (idle) {
+					top_ = 0;
+				}
+				auto const base = reinterpret_cast<std::uintptr_t>(block_);
+				auto offset = ((base + top_ + header + alignment - 1) & ~(alignment - 1)) - base;
+				if (offset + bytes > capacity_) {
+					if (!idle) {
+						return nullptr;
+					}
+					auto size = capacity_ ? capacity_ : std::size_t{4096};
+					while (size < header + bytes + alignment) {
+						size *= 2;
+					}
+					if (size > ext::scratch_arena_limit) {
+						return nullptr;
+					}
+					auto block = static_cast<unsigned char*>(
+						scratch_new(size, block_alignment));
+					if (!block) {
+						return nullptr;
+					}
+					scratch_delete(block_, block_alignment);
+					block_ = block;
+					capacity_ = size;
+					auto const b = reinterpret_cast<std::uintptr_t>(block_);
+					offset = ((b + header + alignment - 1) & ~(alignment - 1)) - b;
+				} else {
+					ext::scratch_statistics().bytes_reused += bytes;
+				}
+				top_ = offset + bytes;
+				live_.fetch_add(1, std::memory_order_relaxed);
+				return block_ + offset;
+			}
+
+			void deallocate() noexcept {
+				live_.fetch_sub(1, std::memory_order_release);
+			}
+		};
+
+		// Each allocation is preceded by the address of the arena it came
+		// from, or nullptr if it came from operator new, so that it goes
+		// back where it came from whichever thread releases it.
+		class default_scratch_resource final : public ext::scratch_resource {
+			static scratch_arena& arena() noexcept {
+				static thread_local scratch_arena a;
+				return a;
+			}
+
+			static std::size_t header_size(std::size_t alignment) noexcept {
+				return alignment > sizeof(scratch_arena*) ? alignment : sizeof(scratch_arena*);
+			}
+
+			void* do_allocate(std::size_t bytes, std::size_t alignment) noexcept override {
+				auto const header = header_size(alignment);
+				scratch_arena* owner = &arena();
+				auto p = static_cast<unsigned char*>(owner->allocate(header, bytes, alignment));
+				if (!p) {
+					if (bytes > SIZE_MAX - header) {
+						return nullptr;
+					}
+					owner = nullptr;
+					p = static_cast<unsigned char*>(scratch_new(header + bytes, alignment));
+					if (!p) {
+						return nullptr;
+					}
+					p += header;
+				}
+				std::memcpy(p - sizeof(owner), &owner, sizeof(owner));
+				return p;
+			}
+			void do_deallocate(void* p, std::size_t, std::size_t alignment) noexcept override {
+				auto const q = static_cast<unsigned char*>(p);
+				scratch_arena* owner;
+				std::memcpy(&owner, q - sizeof(owner), sizeof(owner));
+				if (owner) {
+					owner->deallocate();
+				} else {
+					scratch_delete(q - header_size(alignment), alignment);
+				}
+			}
+
+		public:
+			static default_scratch_resource& instance() noexcept {
+				static default_scratch_resource r;
+				return r;
+			}
+		};
+
+		inline std::atomic<ext::scratch_resource*>& scratch_resource_ptr() noexcept {
+			static std::atomic<ext::scratch_resource*> ptr{
+				&default_scratch_resource::instance()};
+			return ptr;
+		}
+	}
+
+	namespace ext {
+		inline scratch_resource* default_scratch_resource() noexcept {
+			return &detail::default_scratch_resource::instance();
+		}
+
+		inline scratch_resource* get_scratch_resource() noexcept {
+			return detail::scratch_resource_ptr().load(std::memory_order_acquire);
+		}
+
+		// Installs r for all threads, or the default resource if r is null,
+		// and returns the previous one. r must outlive every temporary
+		// buffer it allocates.
+		inline scratch_resource* set_scratch_resource(scratch_resource* r) noexcept {
+			if (!r) {
+				r = ext::default_scratch_resource();
+			}
+			return detail::scratch_resource_ptr().exchange(r, std::memory_order_acq_rel);
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
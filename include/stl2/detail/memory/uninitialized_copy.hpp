@@ -15,6 +15,7 @@
 
 #include <new>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
@@ -33,7 +34,8 @@ STL2_OPEN_NAMESPACE {
 	tagged_pair<tag::in(I), tag::out(O)>
 	uninitialized_copy(I first, S last, O result)
 	{
-		auto guard = detail::destroy_guard<O>{result};
+		auto guard = detail::destroy_guard_t<O,
+			detail::nothrow_construct<I, S, O, reference_t<I>>>{result};
 		for (; first != last; ++result, (void)++first) {
 			__stl2::__construct_at(*result, *first);
 		}
@@ -41,6 +43,20 @@ STL2_OPEN_NAMESPACE {
 		return {std::move(first), std::move(result)};
 	}
 
+	template <InputIterator I, Sentinel<I> S, __NoThrowForwardIterator O>
+	requires
+		Constructible<value_type_t<O>, reference_t<I>> &&
+		__ReferenceTo<O, value_type_t<O>> &&
+		SizedSentinel<S, I> &&
+		detail::MemCopyConstructible<I, O>
+	tagged_pair<tag::in(I), tag::out(O)>
+	uninitialized_copy(I first, S last, O result)
+	{
+		auto n = difference_type_t<I>(last - first);
+		detail::mem::construct(first, n, result);
+		return {first + n, result + n};
+	}
+
 	template <InputRange Rng, __NoThrowForwardIterator O>
 	requires
 		Constructible<value_type_t<O>, reference_t<iterator_t<Rng>>> &&
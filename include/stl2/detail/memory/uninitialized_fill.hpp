@@ -14,8 +14,10 @@
 #define STL2_DETAIL_MEMORY_UNINITIALIZED_FILL_HPP
 
 #include <new>
+#include <type_traits>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
@@ -31,7 +33,8 @@ STL2_OPEN_NAMESPACE {
 		__ReferenceTo<I, value_type_t<I>>
 	I uninitialized_fill(I first, S last, const T& x)
 	{
-		auto guard = detail::destroy_guard<I>{first};
+		auto guard = detail::destroy_guard_t<I,
+			std::is_nothrow_constructible<value_type_t<I>, const T&>::value>{first};
 		for (; first != last; ++first) {
 			__stl2::__construct_at(*first, x);
 		}
@@ -39,6 +42,19 @@ STL2_OPEN_NAMESPACE {
 		return first;
 	}
 
+	template <__NoThrowForwardIterator I, Sentinel<I> S, typename T>
+	requires
+		Constructible<value_type_t<I>, const T&> &&
+		__ReferenceTo<I, value_type_t<I>> &&
+		SizedSentinel<S, I> &&
+		detail::mem::MemFillable<I, T>
+	I uninitialized_fill(I first, S last, const T& x)
+	{
+		auto n = difference_type_t<I>(last - first);
+		detail::mem::fill(first, n, x);
+		return first + n;
+	}
+
 	template <__NoThrowForwardRange Rng, typename T>
 	requires
 		Constructible<value_type_t<iterator_t<Rng>>, const T&> &&
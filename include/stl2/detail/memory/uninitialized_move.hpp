@@ -16,6 +16,7 @@
 #include <new>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
 #include <stl2/detail/algorithm/tagspec.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
@@ -32,7 +33,8 @@ STL2_OPEN_NAMESPACE {
 		__ReferenceTo<I, value_type_t<O>>
 	tagged_pair<tag::in(I), tag::out(O)> uninitialized_move(I first, S last, O result)
 	{
-		auto guard = detail::destroy_guard<O>{result};
+		auto guard = detail::destroy_guard_t<O,
+			detail::nothrow_construct<I, S, O, rvalue_reference_t<I>>>{result};
 		for (; first != last; (void)++result, ++first) {
 			__stl2::__construct_at(*result, __stl2::iter_move(first));
 		}
@@ -40,6 +42,19 @@ STL2_OPEN_NAMESPACE {
 		return {first, result};
 	}
 
+	template <InputIterator I, Sentinel<I> S, __NoThrowForwardIterator O>
+	requires
+		Constructible<value_type_t<O>, rvalue_reference_t<I>> &&
+		__ReferenceTo<I, value_type_t<O>> &&
+		SizedSentinel<S, I> &&
+		detail::MemMoveConstructible<I, O>
+	tagged_pair<tag::in(I), tag::out(O)> uninitialized_move(I first, S last, O result)
+	{
+		auto n = difference_type_t<I>(last - first);
+		detail::mem::construct(first, n, result);
+		return {first + n, result + n};
+	}
+
 	///////////////////////////////////////////////////////////////////////////
 	// uninitialized_move [Extension]
 	//
@@ -0,0 +1,157 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_MEMORY_UNINITIALIZED_RELOCATE_HPP
+#define STL2_DETAIL_MEMORY_UNINITIALIZED_RELOCATE_HPP
+
+#include <cstring>
+#include <type_traits>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memmove.hpp>
+#include <stl2/detail/algorithm/tagspec.hpp>
+#include <stl2/detail/memory/addressof.hpp>
+#include <stl2/detail/memory/concepts.hpp>
+#include <stl2/detail/memory/construct_at.hpp>
+#include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/tagged.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// uninitialized_relocate [Extension]
+//
+// Relocating an object moves it to new storage and ends the lifetime of
+// the original, as a growing vector does with its elements. For a
+// trivially relocatable type that is a copy of the object's bytes, with
+// neither a move constructor nor a destructor run: contiguous ranges of
+// such objects are relocated with memmove.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// Specialize as true for types that relocate trivially without
+		// being trivially copyable, such as most owning handles whose
+		// moved-from state is their only link to the old storage.
+		template <class T>
+		constexpr bool enable_trivially_relocatable =
+			std::is_trivially_move_constructible<T>::value &&
+			std::is_trivially_destructible<T>::value;
+
+		template <class T>
+		concept bool TriviallyRelocatable =
+			MoveConstructible<T> && Destructible<T> &&
+			enable_trivially_relocatable<std::remove_cv_t<T>>;
+	}
+
+	namespace detail {
+		// Relocating [in, in + n) to [out, out + n) can be done with memmove.
+		template <class In, class Out>
+		concept bool MemRelocatable =
+			mem::ContiguousStorage<mem::base_t<In>> &&
+			mem::ContiguousStorage<mem::base_t<Out>> &&
+			Same<value_type_t<mem::base_t<In>>, value_type_t<mem::base_t<Out>>> &&
+			Same<reference_t<mem::base_t<In>>, value_type_t<mem::base_t<In>>&> &&
+			ext::TriviallyRelocatable<value_type_t<mem::base_t<In>>>;
+
+		// Destroys [first, last) unless released; what relocation leaves of
+		// the input when a constructor throws.
+		template <InputIterator I, Sentinel<I> S>
+		class relocate_guard {
+			I& first_;
+			S& last_;
+			bool active_ = true;
+		public:
+			relocate_guard(I& first, S& last) noexcept
+			: first_{first}, last_{last} {}
+			relocate_guard(const relocate_guard&) = delete;
+			relocate_guard& operator=(const relocate_guard&) = delete;
+			~relocate_guard() {
+				if (active_) {
+					__stl2::destroy(first_, last_);
+				}
+			}
+
+			void release() noexcept { active_ = false; }
+		};
+	}
+
+	namespace ext {
+		// Move-constructs [result, result + (last - first)) from [first,
+		// last) and destroys [first, last). If a move constructor throws,
+		// every object of both ranges is destroyed before the exception
+		// propagates.
+		template <InputIterator I, Sentinel<I> S, __NoThrowForwardIterator O>
+		requires
+			Constructible<value_type_t<O>, rvalue_reference_t<I>> &&
+			__ReferenceTo<I, value_type_t<I>> &&
+			__ReferenceTo<O, value_type_t<O>>
+		tagged_pair<tag::in(I), tag::out(O)>
+		uninitialized_relocate(I first, S last, O result)
+		{
+			constexpr bool nothrow =
+				detail::nothrow_construct<I, S, O, rvalue_reference_t<I>>;
+			auto out_guard = detail::destroy_guard_t<O, nothrow>{result};
+			auto in_guard = meta::if_c<nothrow,
+				detail::null_destroy_guard<I>, detail::relocate_guard<I, S>>{first, last};
+			for (; first != last; ++first, (void)++result) {
+				__stl2::__construct_at(*result, __stl2::iter_move(first));
+				__stl2::destroy_at(detail::addressof(*first));
+			}
+			in_guard.release();
+			out_guard.release();
+			return {std::move(first), std::move(result)};
+		}
+
+		template <InputIterator I, Sentinel<I> S, __NoThrowForwardIterator O>
+		requires
+			Constructible<value_type_t<O>, rvalue_reference_t<I>> &&
+			__ReferenceTo<I, value_type_t<I>> &&
+			__ReferenceTo<O, value_type_t<O>> &&
+			SizedSentinel<S, I> &&
+			detail::MemRelocatable<I, O>
+		tagged_pair<tag::in(I), tag::out(O)>
+		uninitialized_relocate(I first, S last, O result) noexcept
+		{
+			auto n = difference_type_t<I>(last - first);
+			if (n > 0) {
+				std::memmove(
+					detail::mem::storage(detail::addressof(*detail::mem::base(result))),
+					detail::addressof(*detail::mem::base(first)),
+					static_cast<std::size_t>(n) * sizeof(value_type_t<I>));
+			}
+			return {first + n, result + n};
+		}
+
+		template <InputRange Rng, __NoThrowForwardIterator O>
+		requires
+			Constructible<value_type_t<O>, rvalue_reference_t<iterator_t<Rng>>> &&
+			__ReferenceTo<iterator_t<Rng>, value_type_t<iterator_t<Rng>>> &&
+			__ReferenceTo<O, value_type_t<O>>
+		tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+		uninitialized_relocate(Rng&& rng, O result)
+		{
+			return ext::uninitialized_relocate(
+				__stl2::begin(rng), __stl2::end(rng), std::move(result));
+		}
+
+		template <InputIterator I, __NoThrowForwardIterator O>
+		requires
+			Constructible<value_type_t<O>, rvalue_reference_t<I>> &&
+			__ReferenceTo<I, value_type_t<I>> &&
+			__ReferenceTo<O, value_type_t<O>>
+		tagged_pair<tag::in(I), tag::out(O)>
+		uninitialized_relocate_n(I first, difference_type_t<I> n, O result)
+		{
+			auto r = ext::uninitialized_relocate(
+				__stl2::make_counted_iterator(std::move(first), n),
+				default_sentinel{}, std::move(result));
+			return {r.in().base(), r.out()};
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif // STL2_DETAIL_MEMORY_UNINITIALIZED_RELOCATE_HPP
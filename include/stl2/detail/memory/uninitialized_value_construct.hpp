@@ -14,6 +14,7 @@
 #define STL2_DETAIL_MEMORY_UNINITIALIZED_VALUE_CONSTRUCT_HPP
 
 #include <new>
+#include <type_traits>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/memory/concepts.hpp>
@@ -31,7 +32,8 @@ STL2_OPEN_NAMESPACE {
 		__ReferenceTo<I, value_type_t<I>>
 	I uninitialized_value_construct(I first, S last)
 	{
-		auto guard = detail::destroy_guard<I>{first};
+		auto guard = detail::destroy_guard_t<I,
+			std::is_nothrow_default_constructible<value_type_t<I>>::value>{first};
 		for (; first != last; ++first) {
 			__stl2::__construct_at(*first);
 		}
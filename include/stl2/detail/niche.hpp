@@ -0,0 +1,185 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_NICHE_HPP
+#define STL2_DETAIL_NICHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/concepts/object.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// niche_traits [Extension]
+//
+// A niche of T is an object representation that no T object has.
+// optional<T> keeps its engaged flag, and variant<T, E...> with empty
+// E... its index, in the niches of a trivially copyable T instead of in a
+// member of its own. Specialize niche_traits<T> with members
+//
+//   static constexpr std::size_t count;  // the number of niches, > 0
+//   static void store(void* p, std::size_t i) noexcept;
+//     // Writes niche i < count to the sizeof(T) bytes at p.
+//   static std::size_t load(const void* p) noexcept;
+//     // i if the bytes at p hold niche i, count if they hold a T.
+//
+// Niches are read and written as bytes, which no constant expression may
+// do, so niche_traits is not specialized for T* and bool: optional<T*>,
+// optional<bool> and their variants stay usable in constant expressions.
+// niche_ptr<T> and niche_bool are a T* and a bool that opt in.
+// Pointers and detail::raw_ptr take the addresses below 256, in the page
+// that hosted platforms never map; niche_bool takes the byte values
+// above 1.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template <class T>
+		struct niche_traits {};
+
+		template <class T>
+		constexpr std::size_t niche_count = 0;
+		template <class T>
+		requires
+			requires { niche_traits<T>::count; }
+		constexpr std::size_t niche_count<T> = niche_traits<T>::count;
+
+		// The niches of T are the object representations of the values
+		// [First, First + Count) of the unsigned integer type U.
+		template <class T, class U, U First, std::size_t Count>
+		struct range_niche_traits {
+			static_assert(std::is_unsigned<U>::value && sizeof(U) == sizeof(T));
+			static_assert(Count > 0 && Count - 1 <= U(~First));
+
+			static constexpr std::size_t count = Count;
+
+			static void store(void* p, std::size_t i) noexcept {
+				STL2_EXPECT(i < count);
+				U const u = First + static_cast<U>(i);
+				std::memcpy(p, &u, sizeof(U));
+			}
+
+			static std::size_t load(const void* p) noexcept {
+				U u;
+				std::memcpy(&u, p, sizeof(U));
+				U const i = u - First;
+				return i < count ? i : count;
+			}
+		};
+
+		// Reserved values of the integral or enumeration type T, which no T
+		// object holds, as its niches.
+		template <class T, T... Values>
+		struct reserved_niche_traits {
+			static constexpr std::size_t count = sizeof...(Values);
+
+			static void store(void* p, std::size_t i) noexcept {
+				constexpr T values[] = {Values...};
+				STL2_EXPECT(i < count);
+				std::memcpy(p, &values[i], sizeof(T));
+			}
+
+			static std::size_t load(const void* p) noexcept {
+				constexpr T values[] = {Values...};
+				T t;
+				std::memcpy(&t, p, sizeof(T));
+				std::size_t i = 0;
+				while (i < count && values[i] != t) {
+					++i;
+				}
+				return i;
+			}
+		};
+
+		template <class T>
+		struct pointer_niche_traits
+		: range_niche_traits<T, std::uintptr_t, 1, 255> {};
+
+		// A T* that gives its niches to optional and variant.
+		template <class T>
+		class niche_ptr {
+		public:
+			niche_ptr() = default;
+			constexpr niche_ptr(T* ptr) noexcept
+			: ptr_{ptr} {}
+
+			constexpr niche_ptr& operator=(T* ptr) & noexcept {
+				ptr_ = ptr;
+				return *this;
+			}
+
+			constexpr operator T*() const noexcept { return ptr_; }
+			constexpr T* get() const noexcept { return ptr_; }
+
+			constexpr decltype(auto) operator*() const noexcept {
+				STL2_EXPECT(ptr_);
+				return *ptr_;
+			}
+			constexpr T* operator->() const noexcept {
+				STL2_EXPECT(ptr_);
+				return ptr_;
+			}
+		private:
+			T* ptr_;
+		};
+
+		// A bool that gives its niches to optional and variant.
+		class niche_bool {
+		public:
+			niche_bool() = default;
+			constexpr niche_bool(bool b) noexcept
+			: b_{b} {}
+
+			constexpr operator bool() const noexcept { return b_; }
+		private:
+			bool b_;
+		};
+
+		template <class T>
+		struct niche_traits<niche_ptr<T>>
+		: pointer_niche_traits<niche_ptr<T>> {};
+
+		template <class T>
+		struct niche_traits<detail::raw_ptr<T>>
+		: pointer_niche_traits<detail::raw_ptr<T>> {};
+
+		template <>
+		struct niche_traits<niche_bool>
+		: range_niche_traits<niche_bool, unsigned char, 2, 254> {};
+
+		template <class T>
+		struct niche_traits<const T> : niche_traits<T> {};
+	}
+
+	namespace detail {
+		// T can keep N discriminant values in its niches.
+		template <class T, std::size_t N>
+		concept bool NichePacked =
+			ext::TriviallyCopyable<std::remove_cv_t<T>> &&
+			ext::niche_count<T> >= N;
+
+		// Stores niche i of T at p, which may point to a const T.
+		template <class T>
+		void store_niche(const T* p, std::size_t i) noexcept {
+			ext::niche_traits<T>::store(
+				const_cast<void*>(static_cast<const volatile void*>(p)), i);
+		}
+
+		template <class T>
+		std::size_t load_niche(const T* p) noexcept {
+			return ext::niche_traits<T>::load(
+				const_cast<const void*>(static_cast<const volatile void*>(p)));
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
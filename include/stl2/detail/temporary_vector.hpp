@@ -12,6 +12,8 @@
 #ifndef STL2_DETAIL_TEMPORARY_VECTOR_HPP
 #define STL2_DETAIL_TEMPORARY_VECTOR_HPP
 
+#include <cstdint>
+#include <utility>
 #include <stl2/memory.hpp>
 #include <stl2/type_traits.hpp>
 #include <stl2/utility.hpp>
@@ -19,69 +21,71 @@
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/for_each.hpp>
 #include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/memory/scratch_resource.hpp>
 
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		struct temporary_buffer_deleter {
-			void operator()(auto* ptr) const {
-				std::return_temporary_buffer(ptr);
-			}
-		};
-
+		// Storage for up to size() objects of type T, drawn from the current
+		// scratch resource. Like std::get_temporary_buffer, it asks for less
+		// when the resource can't provide n; size() may be zero. Must be
+		// released by the thread that created it.
 		template <class T>
 		class temporary_buffer {
-			unique_ptr<T, temporary_buffer_deleter> alloc_;
+			T* data_ = nullptr;
 			std::ptrdiff_t size_ = 0;
+			ext::scratch_resource* resource_ = nullptr;
 
-			temporary_buffer(pair<T*, std::ptrdiff_t> buf) :
-				alloc_{buf.first}, size_{buf.second} {}
+			void reset() noexcept {
+				if (data_) {
+					resource_->deallocate(data_,
+						static_cast<std::size_t>(size_) * sizeof(T), alignof(T));
+				}
+			}
 
 		public:
 			temporary_buffer() = default;
 			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<T>(n)) {}
-
-			T* data() const {
-				return alloc_.get();
-			}
-
-			std::ptrdiff_t size() const {
-				return size_;
-			}
-		};
-
-		template <class T>
-		requires alignof(T) > alignof(std::max_align_t)
-		class temporary_buffer<T> {
-			unique_ptr<unsigned char, temporary_buffer_deleter> alloc_;
-			T* aligned_ = nullptr;
-			std::ptrdiff_t size_ = 0;
-
-			static_assert((alignof(T) & (alignof(T) - 1)) == 0,
-				"Alignment must be a power of two.");
-
-			temporary_buffer(pair<unsigned char*, std::ptrdiff_t> buf)
-			: alloc_{buf.first}
+			: resource_{ext::get_scratch_resource()}
 			{
-				if (buf.second > 0 && static_cast<std::size_t>(buf.second) >= sizeof(T)) {
-					void* ptr = buf.first;
-					std::size_t n = buf.second;
-					aligned_ = static_cast<T*>(std::align(alignof(T), sizeof(T), ptr, n));
-					if (aligned_) {
-						size_ = n / sizeof(T);
+				static_assert((alignof(T) & (alignof(T) - 1)) == 0,
+					"Alignment must be a power of two.");
+				constexpr auto max_n = PTRDIFF_MAX / static_cast<std::ptrdiff_t>(sizeof(T));
+				if (n > max_n) {
+					n = max_n;
+				}
+				if (n <= 0) {
+					return;
+				}
+				auto& stats = ext::scratch_statistics();
+				++stats.allocations;
+				stats.bytes_requested += static_cast<std::size_t>(n) * sizeof(T);
+				for (; n > 0; n /= 2) {
+					data_ = static_cast<T*>(resource_->allocate(
+						static_cast<std::size_t>(n) * sizeof(T), alignof(T)));
+					if (data_) {
+						size_ = n;
+						break;
 					}
 				}
 			}
-
-		public:
-			temporary_buffer() = default;
-			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<unsigned char>(
-				n * sizeof(T) + alignof(T) - 1))
+			temporary_buffer(temporary_buffer&& that) noexcept
+			: data_{std::exchange(that.data_, nullptr)}
+			, size_{std::exchange(that.size_, 0)}
+			, resource_{that.resource_}
 			{}
+			temporary_buffer& operator=(temporary_buffer&& that) & noexcept {
+				reset();
+				data_ = std::exchange(that.data_, nullptr);
+				size_ = std::exchange(that.size_, 0);
+				resource_ = that.resource_;
+				return *this;
+			}
+			~temporary_buffer() {
+				reset();
+			}
 
 			T* data() const {
-				return aligned_;
+				return data_;
 			}
 
 			std::ptrdiff_t size() const {
@@ -109,7 +113,7 @@ STL2_OPEN_NAMESPACE {
 			temporary_vector() = default;
 			temporary_vector(temporary_buffer<T>& buf)
 			: begin_{buf.data()}, end_{begin_}
-			, alloc_{begin_ + buf.size_}
+			, alloc_{begin_ + buf.size()}
 			{}
 			temporary_vector(temporary_vector&&) = delete;
 			temporary_vector& operator=(temporary_vector&& that) = delete;
@@ -119,6 +123,14 @@ STL2_OPEN_NAMESPACE {
 				end_ = begin_;
 			}
 
+			// Destroys the elements in [first, end()).
+			void erase(T* first) noexcept {
+				STL2_EXPECT(begin_ <= first);
+				STL2_EXPECT(first <= end_);
+				__stl2::for_each(first, end_, destruct);
+				end_ = first;
+			}
+
 			constexpr bool empty() const noexcept {
 				return begin_ == end_;
 			}
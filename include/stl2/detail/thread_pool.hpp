@@ -0,0 +1,293 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_THREAD_POOL_HPP
+#define STL2_DETAIL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Work-stealing thread pool for the parallel algorithms [Extension]
+//
+// Each worker owns a deque of tasks: it pushes and pops its own tasks at
+// the back, and when that runs dry steals from the front of the other
+// workers' deques, and finally from a queue shared by all threads outside
+// the pool. A thread waiting on a task_group runs queued tasks until there
+// are none, so nested parallelism cannot deadlock the pool, and then sleeps
+// until another task is queued or the group is done.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		struct pool_task {
+			virtual ~pool_task() = default;
+			virtual void run() noexcept = 0;
+		};
+
+		class thread_pool {
+			struct task_queue {
+				std::mutex mutex;
+				std::deque<pool_task*> tasks;
+			};
+
+			std::size_t const workers_;
+			// One queue per worker, then the queue for outside threads.
+			std::unique_ptr<task_queue[]> queues_;
+			std::atomic<std::size_t> queued_{0};
+			std::atomic<bool> stop_{false};
+			std::mutex sleep_mutex_;
+			std::condition_variable wake_;
+			std::vector<std::thread> threads_;
+
+			static std::size_t& worker_index() noexcept {
+				static thread_local std::size_t index = std::size_t(-1);
+				return index;
+			}
+
+			static pool_task* pop_back(task_queue& q) {
+				std::lock_guard<std::mutex> lock{q.mutex};
+				if (q.tasks.empty()) {
+					return nullptr;
+				}
+				pool_task* t = q.tasks.back();
+				q.tasks.pop_back();
+				return t;
+			}
+
+			static pool_task* pop_front(task_queue& q) {
+				std::lock_guard<std::mutex> lock{q.mutex};
+				if (q.tasks.empty()) {
+					return nullptr;
+				}
+				pool_task* t = q.tasks.front();
+				q.tasks.pop_front();
+				return t;
+			}
+
+			pool_task* find_task() {
+				if (queued_.load(std::memory_order_acquire) == 0) {
+					return nullptr;
+				}
+				std::size_t const self = worker_index();
+				pool_task* t = nullptr;
+				if (self < workers_) {
+					t = pop_back(queues_[self]);
+				}
+				if (!t) {
+					t = pop_front(queues_[workers_]);
+				}
+				for (std::size_t i = 1; !t && i <= workers_; ++i) {
+					std::size_t const victim = (self < workers_ ? self + i : i) % workers_;
+					t = pop_front(queues_[victim]);
+				}
+				if (t) {
+					queued_.fetch_sub(1, std::memory_order_relaxed);
+				}
+				return t;
+			}
+
+			void work(std::size_t index) {
+				worker_index() = index;
+				while (true) {
+					if (run_one()) {
+						continue;
+					}
+					std::unique_lock<std::mutex> lock{sleep_mutex_};
+					wake_.wait(lock, [this] {
+						return stop_.load() || queued_.load() != 0;
+					});
+					if (stop_.load()) {
+						return;
+					}
+				}
+			}
+
+		public:
+			explicit thread_pool(std::size_t workers)
+			: workers_{workers}, queues_{new task_queue[workers + 1]}
+			{
+				threads_.reserve(workers);
+				for (std::size_t i = 0; i < workers; ++i) {
+					threads_.emplace_back([this, i] { work(i); });
+				}
+			}
+
+			~thread_pool() {
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+					stop_.store(true);
+				}
+				wake_.notify_all();
+				for (auto& t : threads_) {
+					t.join();
+				}
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator=(const thread_pool&) = delete;
+
+			// The process-wide pool: one worker per hardware thread besides
+			// the calling thread, which takes part while it waits.
+			static thread_pool& instance() {
+				static thread_pool pool{[] {
+					unsigned const n = std::thread::hardware_concurrency();
+					return n > 1 ? std::size_t(n - 1) : std::size_t(0);
+				}()};
+				return pool;
+			}
+
+			// Number of threads that can make progress concurrently.
+			std::size_t concurrency() const noexcept {
+				return workers_ + 1;
+			}
+
+			// Takes ownership of t, unless it throws.
+			void submit(pool_task* t) {
+				std::size_t const self = worker_index();
+				auto& q = queues_[self < workers_ ? self : workers_];
+				// Counted before it can be found, so that find_task never
+				// takes the count below zero.
+				queued_.fetch_add(1, std::memory_order_release);
+				try {
+					std::lock_guard<std::mutex> lock{q.mutex};
+					q.tasks.push_back(t);
+				} catch (...) {
+					queued_.fetch_sub(1, std::memory_order_relaxed);
+					throw;
+				}
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+				}
+				wake_.notify_one();
+			}
+
+			// Runs one queued task, if there is one.
+			bool run_one() {
+				pool_task* t = find_task();
+				if (!t) {
+					return false;
+				}
+				t->run();
+				delete t;
+				return true;
+			}
+
+			// Blocks until done() holds or a task is queued. done is
+			// evaluated under the lock that notify_all takes.
+			template <class Pred>
+			void wait_for_work(Pred done) {
+				std::unique_lock<std::mutex> lock{sleep_mutex_};
+				wake_.wait(lock, [&] {
+					return done() || queued_.load() != 0;
+				});
+			}
+
+			// Wakes every thread blocked in work or wait_for_work.
+			void notify_all() {
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+				}
+				wake_.notify_all();
+			}
+		};
+
+		// Fork-join scope: run() queues a task on the pool, wait() helps run
+		// queued tasks until all of this group's tasks are done, then
+		// rethrows the first exception any of them threw.
+		class task_group {
+			thread_pool& pool_;
+			std::atomic<std::size_t> pending_{0};
+			std::mutex error_mutex_;
+			std::exception_ptr error_;
+
+			template <class F>
+			struct task : pool_task {
+				task_group& group;
+				F fn;
+
+				task(task_group& g, F&& f)
+				: group(g), fn(std::move(f)) {}
+
+				void run() noexcept override {
+					try {
+						fn();
+					} catch (...) {
+						std::lock_guard<std::mutex> lock{group.error_mutex_};
+						if (!group.error_) {
+							group.error_ = std::current_exception();
+						}
+					}
+					// The group may be gone as soon as pending_ is zero.
+					thread_pool& pool = group.pool_;
+					if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+						pool.notify_all();
+					}
+				}
+			};
+
+			bool done() const noexcept {
+				return pending_.load(std::memory_order_acquire) == 0;
+			}
+
+			void help_until_done() {
+				while (!done()) {
+					if (!pool_.run_one()) {
+						pool_.wait_for_work([this] { return done(); });
+					}
+				}
+			}
+
+		public:
+			explicit task_group(thread_pool& pool = thread_pool::instance())
+			: pool_(pool) {}
+
+			task_group(const task_group&) = delete;
+			task_group& operator=(const task_group&) = delete;
+
+			~task_group() {
+				help_until_done();
+			}
+
+			thread_pool& pool() const noexcept {
+				return pool_;
+			}
+
+			template <class F>
+			void run(F f) {
+				pending_.fetch_add(1, std::memory_order_relaxed);
+				try {
+					auto t = std::make_unique<task<F>>(*this, std::move(f));
+					pool_.submit(t.get());
+					t.release();
+				} catch (...) {
+					pending_.fetch_sub(1, std::memory_order_relaxed);
+					throw;
+				}
+			}
+
+			void wait() {
+				help_until_done();
+				if (error_) {
+					std::rethrow_exception(std::exchange(error_, nullptr));
+				}
+			}
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
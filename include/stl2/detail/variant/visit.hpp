@@ -125,9 +125,21 @@ STL2_OPEN_NAMESPACE {
 					meta::bind_front<meta::quote<single_visit_noexcept>,
 						F, meta::list<Vs...>>>>>;
 
-		// TODO: Tune.
+		// Visitations of fewer combinations of alternatives than the threshold
+		// find the active alternatives by comparison, the rest index a table
+		// of handlers. ext::visit and friends take the threshold per call.
 		constexpr std::size_t O1_visit_threshold = 5;
 
+		// Single variants with at most this many alternatives are visited
+		// with a switch, whatever the threshold.
+		constexpr std::size_t switch_visit_limit = 32;
+
+		template <class... Vs>
+		constexpr bool switch_visitable = false;
+		template <Variant V>
+		constexpr bool switch_visitable<V> =
+			VariantTypes<V>::size() <= switch_visit_limit;
+
 		template <std::size_t... Is, Variant... Vs, RawVisitorWithIndices<Vs...> F>
 		constexpr VisitReturn<F, Vs...>
 		visit_handler(std::index_sequence<Is...> indices, F&& f, Vs&&... vs)
@@ -213,11 +225,14 @@ STL2_OPEN_NAMESPACE {
 			}
 		};
 
-		RawVisitorWithIndices{F, ...Vs}
+		template <std::size_t Threshold = O1_visit_threshold, class F, Variant... Vs>
+		requires
+			RawVisitorWithIndices<F, Vs...> &&
+			!switch_visitable<Vs...> &&
+			total_alternatives<Vs...> < Threshold
 		constexpr VisitReturn<F, Vs...>
 		raw_visit_with_indices(F&& f, Vs&&... vs)
 		noexcept(VisitNothrow<F, Vs...>)
-		requires total_alternatives<Vs...> < O1_visit_threshold
 		{
 			return ON_dispatch<F, Vs...>{
 				std::forward<F>(f), std::forward<Vs>(vs)...
@@ -292,11 +307,14 @@ STL2_OPEN_NAMESPACE {
 						VariantTypes<Vs>::size()>>...>>,
 				meta::quote<__as_integer_sequence>>;
 
-		RawVisitorWithIndices{F, ...Vs}
+		template <std::size_t Threshold = O1_visit_threshold, class F, Variant... Vs>
+		requires
+			RawVisitorWithIndices<F, Vs...> &&
+			!switch_visitable<Vs...> &&
+			total_alternatives<Vs...> >= Threshold
 		constexpr VisitReturn<F, Vs...>
 		raw_visit_with_indices(F&& f, Vs&&... vs)
 		noexcept(VisitNothrow<F, Vs...>)
-		requires total_alternatives<Vs...> >= O1_visit_threshold
 		{
 			using Dispatch = O1_dispatch<all_index_vectors<Vs...>, F, Vs...>;
 			std::size_t i = calc_index(vs...);
@@ -304,6 +322,70 @@ STL2_OPEN_NAMESPACE {
 			return Dispatch::table[i](std::forward<F>(f), std::forward<Vs>(vs)...);
 		}
 
+		///////////////////////////////////////////////////////////////////////////
+		// Switch visitor implementation for a single variant: the compiler
+		// lowers the switch to a jump table as it does the O(1) table, but can
+		// inline the handlers into the cases.
+		//
+		// Whether case I of the switch has a handler: I names an
+		// alternative, and that alternative isn't void.
+		template <std::size_t I, class Types, bool = (I < Types::size())>
+		constexpr bool switch_case_handled = false;
+		template <std::size_t I, class Types>
+		constexpr bool switch_case_handled<I, Types, true> =
+			!is_void<meta::at_c<Types, I>>::value;
+
+		template <std::size_t I, class F, Variant V>
+		requires
+			RawVisitorWithIndices<F, V> &&
+			switch_case_handled<I, VariantTypes<V>>
+		constexpr VisitReturn<F, V>
+		switch_visit_case(F&& f, V&& v)
+		noexcept(VisitNothrow<F, V>)
+		{
+			return visit_handler(std::index_sequence<I>{},
+				std::forward<F>(f), std::forward<V>(v));
+		}
+
+		template <std::size_t I, class F, Variant V>
+		requires
+			RawVisitorWithIndices<F, V> &&
+			!switch_case_handled<I, VariantTypes<V>>
+		constexpr VisitReturn<F, V>
+		switch_visit_case(F&&, V&&)
+		noexcept(VisitNothrow<F, V>)
+		{
+			STL2_EXPECT(false);
+		}
+
+		template <std::size_t Threshold = O1_visit_threshold, class F, Variant V>
+		requires
+			RawVisitorWithIndices<F, V> &&
+			switch_visitable<V>
+		constexpr VisitReturn<F, V>
+		raw_visit_with_indices(F&& f, V&& v)
+		noexcept(VisitNothrow<F, V>)
+		{
+			STL2_EXPECT(v.valid());
+			switch (v.index()) {
+#define STL2_VISIT_CASE(I) \
+			case I: return __variant::switch_visit_case<I>( \
+				std::forward<F>(f), std::forward<V>(v))
+#define STL2_VISIT_CASES(I) \
+			STL2_VISIT_CASE(I + 0); STL2_VISIT_CASE(I + 1); \
+			STL2_VISIT_CASE(I + 2); STL2_VISIT_CASE(I + 3); \
+			STL2_VISIT_CASE(I + 4); STL2_VISIT_CASE(I + 5); \
+			STL2_VISIT_CASE(I + 6); STL2_VISIT_CASE(I + 7)
+			STL2_VISIT_CASES(0);
+			STL2_VISIT_CASES(8);
+			STL2_VISIT_CASES(16);
+			STL2_VISIT_CASES(24);
+#undef STL2_VISIT_CASES
+#undef STL2_VISIT_CASE
+			}
+			STL2_EXPECT(false);
+		}
+
 		///////////////////////////////////////////////////////////////////////////
 		// Adapt a visitor that accepts a single integral_constant index
 		// to the variadic visitor model that accepts an integer_sequence of indices.
@@ -383,12 +465,13 @@ STL2_OPEN_NAMESPACE {
 		concept bool VisitorWithIndices =
 			RawVisitorWithIndices<cooked_visitor<F, Vs...>, Vs...>;
 
-		VisitorWithIndices{F, ...Vs}
+		template <std::size_t Threshold = O1_visit_threshold, class F, class... Vs>
+		requires VisitorWithIndices<F, Vs...>
 		constexpr VisitReturn<cooked_visitor<F, Vs...>, Vs...>
 		visit_with_indices(F&& f, Vs&&...  vs)
 		noexcept(VisitNothrow<cooked_visitor<F, Vs...>, Vs...>)
 		{
-			return raw_visit_with_indices(
+			return raw_visit_with_indices<Threshold>(
 				cooked_visitor<F, Vs...>{std::forward<F>(f)},
 				std::forward<Vs>(vs)...);
 		}
@@ -397,12 +480,13 @@ STL2_OPEN_NAMESPACE {
 		concept bool VisitorWithIndex =
 			VisitorWithIndices<single_index_visitor<F>, V>;
 
-		VisitorWithIndex{F, V}
+		template <std::size_t Threshold = O1_visit_threshold, class F, class V>
+		requires VisitorWithIndex<F, V>
 		constexpr VisitReturn<cooked_visitor<single_index_visitor<F>, V>, V>
 		visit_with_index(F&& f, V&& v)
 		noexcept(VisitNothrow<cooked_visitor<single_index_visitor<F>, V>, V>)
 		{
-			return visit_with_indices(
+			return visit_with_indices<Threshold>(
 				single_index_visitor<F>{std::forward<F>(f)},
 				std::forward<V>(v));
 		}
@@ -411,12 +495,13 @@ STL2_OPEN_NAMESPACE {
 		concept bool Visitor =
 			VisitorWithIndices<no_index_visitor<F>, Vs...>;
 
-		Visitor{F, ...Vs}
+		template <std::size_t Threshold = O1_visit_threshold, class F, class... Vs>
+		requires Visitor<F, Vs...>
 		constexpr VisitReturn<cooked_visitor<no_index_visitor<F>, Vs...>, Vs...>
 		visit(F&& f, Vs&&... vs)
 		noexcept(VisitNothrow<cooked_visitor<no_index_visitor<F>, Vs...>, Vs...>)
 		{
-			return visit_with_indices(
+			return visit_with_indices<Threshold>(
 				no_index_visitor<F>{std::forward<F>(f)},
 				std::forward<Vs>(vs)...);
 		}
@@ -436,6 +521,8 @@ STL2_OPEN_NAMESPACE {
 			meta::all_of<meta::list<Ts...>, meta::quote<hashable_element_t>>::value;
 	}
 
+	// visit<Threshold>(f, vs...) and friends [Extension] override
+	// O1_visit_threshold for a single call.
 	using __variant::visit;
 	using __variant::visit_with_index;
 	using __variant::visit_with_indices;
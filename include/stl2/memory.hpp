@@ -17,10 +17,12 @@
 #include <stl2/detail/memory/addressof.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/memory/scratch_resource.hpp>
 #include <stl2/detail/memory/uninitialized_copy.hpp>
 #include <stl2/detail/memory/uninitialized_default_construct.hpp>
 #include <stl2/detail/memory/uninitialized_fill.hpp>
 #include <stl2/detail/memory/uninitialized_move.hpp>
+#include <stl2/detail/memory/uninitialized_relocate.hpp>
 #include <stl2/detail/memory/uninitialized_value_construct.hpp>
 
 #endif
@@ -18,6 +18,7 @@
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/hash.hpp>
 #include <stl2/detail/meta.hpp>
+#include <stl2/detail/niche.hpp>
 #include <stl2/detail/smf_control.hpp>
 #include <stl2/detail/concepts/core.hpp>
 #include <stl2/detail/concepts/object.hpp>
@@ -99,12 +100,13 @@ STL2_OPEN_NAMESPACE {
 				T item_;
 			};
 			bool engaged_ = false;
+
+			constexpr bool engaged() const noexcept { return engaged_; }
+			constexpr void set_engaged(bool b) noexcept { engaged_ = b; }
 		};
 
 		template <class T>
-		requires
-			Destructible<T> &&
-			std::is_trivially_destructible<T>::value
+		requires ext::TriviallyDestructible<T>
 		class storage_destruct_layer<T> {
 		public:
 			constexpr storage_destruct_layer() noexcept {}
@@ -123,6 +125,46 @@ STL2_OPEN_NAMESPACE {
 				T item_;
 			};
 			bool engaged_ = false;
+
+			constexpr bool engaged() const noexcept { return engaged_; }
+			constexpr void set_engaged(bool b) noexcept { engaged_ = b; }
+		};
+
+		///////////////////////////////////////////////////////////////////////////
+		// Specialization for trivially copyable T with a niche, which holds
+		// the niche when disengaged in place of a separate engaged flag.
+		//
+		template <class T>
+		requires
+			ext::TriviallyDestructible<T> &&
+			detail::NichePacked<T, 1>
+		class storage_destruct_layer<T> {
+		public:
+			storage_destruct_layer() noexcept { set_engaged(false); }
+			template <class... Args>
+			requires Constructible<T, Args...>
+			constexpr explicit storage_destruct_layer(in_place_t, Args&&... args)
+			noexcept(std::is_nothrow_constructible<T, Args...>::value)
+			: item_(std::forward<Args>(args)...) {}
+
+			void clear() noexcept {
+				STL2_EXPECT(engaged());
+			}
+		protected:
+			union {
+				char dummy_ = {};
+				T item_;
+			};
+
+			bool engaged() const noexcept {
+				return detail::load_niche(detail::addressof(item_)) ==
+					ext::niche_count<T>;
+			}
+			void set_engaged(bool b) noexcept {
+				if (!b) {
+					detail::store_niche(detail::addressof(item_), 0);
+				}
+			}
 		};
 
 		template <class T>
@@ -137,18 +179,18 @@ STL2_OPEN_NAMESPACE {
 			{
 				const volatile void* as_void = detail::addressof(this->item_);
 				::new(const_cast<void*>(as_void)) T{std::forward<Args>(args)...};
-				this->engaged_ = true;
+				this->set_engaged(true);
 			}
 
 			void reset() noexcept {
-				if (this->engaged_) {
+				if (this->engaged()) {
 					this->clear();
 				}
-				this->engaged_ = false;
+				this->set_engaged(false);
 			}
 
-			constexpr bool has_value() const noexcept { return this->engaged_; }
-			constexpr explicit operator bool() const noexcept { return this->engaged_; }
+			constexpr bool has_value() const noexcept { return this->engaged(); }
+			constexpr explicit operator bool() const noexcept { return this->engaged(); }
 
 			constexpr T& operator*() & noexcept {
 				STL2_EXPECT(has_value());
@@ -21,10 +21,12 @@
 #include <stl2/detail/construct_destruct.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/meta.hpp>
+#include <stl2/detail/niche.hpp>
 #include <stl2/detail/tagged.hpp>
 #include <stl2/detail/tuple_like.hpp>
 #include <stl2/detail/concepts/compare.hpp>
 #include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/memory/addressof.hpp>
 #include <stl2/detail/utility/in_place.hpp>
 #include <stl2/detail/variant/fwd.hpp>
 #include <stl2/detail/variant/storage.hpp>
@@ -145,40 +147,135 @@ STL2_OPEN_NAMESPACE {
 		using constructible_from =
 			constructible_from_<T, 0u, Types...>;
 
+		template <class... Ts>
+		using index_type =
+			meta::if_c<
+				(sizeof...(Ts) <= std::numeric_limits<std::int_least8_t>::max()),
+				std::int_least8_t,
+				meta::if_c<
+					(sizeof...(Ts) <= std::numeric_limits<std::int_least16_t>::max()),
+					std::int_least16_t,
+					meta::if_c<
+						(sizeof...(Ts) <= std::numeric_limits<std::int_least32_t>::max()),
+						std::int_least32_t,
+						std::size_t>>>;
+
+		// The position of the only alternative whose element type is not
+		// empty, or sizeof...(Ts) if there is no such alternative.
+		template <class... Ts>
+		constexpr std::size_t nonempty_alternative() noexcept {
+			constexpr bool empty[] = {is_empty<element_t<Ts>>::value...};
+			std::size_t d = sizeof...(Ts);
+			for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+				if (!empty[i]) {
+					if (d != sizeof...(Ts)) {
+						return sizeof...(Ts);
+					}
+					d = i;
+				}
+			}
+			return d;
+		}
+
+		///////////////////////////////////////////////////////////////////////////
+		// index_storage: keeps the index of the active alternative for base.
+		//
+		template <class... Ts>
+		class index_storage {
+		protected:
+			using storage_t = storage<element_t<Ts>...>;
+			using index_t = index_type<Ts...>;
+
+			index_t index_;
+
+			index_storage() = default;
+			constexpr index_storage(index_t i) noexcept
+			: index_{i} {}
+
+			constexpr index_t get_index(const storage_t&) const noexcept {
+				return index_;
+			}
+			constexpr void set_index(storage_t&, index_t i) noexcept {
+				index_ = i;
+			}
+			// Called once the alternative a constructor chose is constructed.
+			constexpr void init_index(storage_t&, index_t) noexcept {}
+		};
+
+		///////////////////////////////////////////////////////////////////////////
+		// Specialization for trivially copyable variants whose alternatives
+		// but one are empty: the niches of the nonempty alternative D hold the
+		// index of any other, with the first niche for the invalid index.
+		//
+		template <class... Ts>
+		requires
+			ext::TriviallyCopyable<storage<element_t<Ts>...>> &&
+			(nonempty_alternative<Ts...>() < sizeof...(Ts)) &&
+			detail::NichePacked<
+				element_t<meta::at_c<meta::list<Ts...>, nonempty_alternative<Ts...>()>>,
+				sizeof...(Ts)>
+		class index_storage<Ts...> {
+			static constexpr std::size_t D = nonempty_alternative<Ts...>();
+			using niche_t = element_t<meta::at_c<meta::list<Ts...>, D>>;
+
+			template <class S>
+			static auto niche(S& s) noexcept {
+				return detail::addressof(st_access::raw_get(in_place_index<D>, s));
+			}
+		protected:
+			using storage_t = storage<element_t<Ts>...>;
+			using index_t = index_type<Ts...>;
+
+			index_storage() = default;
+			constexpr index_storage(index_t) noexcept {}
+
+			index_t get_index(const storage_t& s) const noexcept {
+				auto const k = detail::load_niche(niche(s));
+				if (k == ext::niche_count<niche_t>) {
+					return index_t(D);
+				}
+				return k == 0 ? index_t(-1) : index_t(k - 1 < D ? k - 1 : k);
+			}
+			void set_index(storage_t& s, index_t i) noexcept {
+				if (i == index_t(-1)) {
+					detail::store_niche(niche(s), 0);
+				} else if (auto const j = static_cast<std::size_t>(i); j != D) {
+					detail::store_niche(niche(s), j < D ? j + 1 : j);
+				}
+			}
+			void init_index(storage_t& s, index_t i) noexcept {
+				set_index(s, i);
+			}
+		};
+
 		///////////////////////////////////////////////////////////////////////////
 		// __variant::base: lowest layer of the variant implementation.
 		//
 		template <class... Ts>
 		requires(Destructible<element_t<Ts>> && ...)
-		class base {
+		class base : index_storage<Ts...> {
 			friend v_access;
+			using index_base_t = index_storage<Ts...>;
 		protected:
 			using storage_t = storage<element_t<Ts>...>;
-			using index_t =
-				meta::if_c<
-					(sizeof...(Ts) <= std::numeric_limits<std::int_least8_t>::max()),
-					std::int_least8_t,
-					meta::if_c<
-						(sizeof...(Ts) <= std::numeric_limits<std::int_least16_t>::max()),
-						std::int_least16_t,
-						meta::if_c<
-							(sizeof...(Ts) <= std::numeric_limits<std::int_least32_t>::max()),
-							std::int_least32_t,
-							std::size_t>>>;
+			using index_t = index_type<Ts...>;
 			static_assert(sizeof...(Ts) - is_unsigned<index_t>::value <
 				std::numeric_limits<index_t>::max());
 			static constexpr auto invalid_index = index_t(-1);
 
-			index_t index_;
 			storage_t storage_;
 
+			constexpr index_t raw_index() const noexcept {
+				return this->get_index(storage_);
+			}
+
 			struct index_guard {
 				base* target_;
 				index_t index_;
 
 				~index_guard() {
 					if (target_) {
-						target_->index_ = index_;
+						target_->set_index(target_->storage_, index_);
 					}
 				}
 
@@ -221,7 +318,7 @@ STL2_OPEN_NAMESPACE {
 			}
 
 			void move_assign_from(DerivedFrom<base>&& that) {
-				if (index_ == that.index_) {
+				if (raw_index() == that.raw_index()) {
 					if (valid()) {
 						raw_visit_with_index([this](auto i, auto&& from) {
 							st_access::raw_get(in_place_index<i>, storage_) =
@@ -235,7 +332,7 @@ STL2_OPEN_NAMESPACE {
 			}
 
 			void copy_assign_from(const DerivedFrom<base>& that) {
-				if (index_ == that.index_) {
+				if (raw_index() == that.raw_index()) {
 					if (valid()) {
 						raw_visit_with_index([this](auto i, const auto& from) {
 							st_access::raw_get(in_place_index<i>, storage_) = from;
@@ -260,7 +357,8 @@ STL2_OPEN_NAMESPACE {
 			constexpr base()
 			noexcept(is_nothrow_default_constructible<storage_t>::value)
 			requires DefaultConstructible<storage_t>
-			: index_{0} {}
+			: index_base_t{0}
+			{ this->init_index(storage_, 0); }
 
 			template <class T>
 			requires
@@ -270,9 +368,9 @@ STL2_OPEN_NAMESPACE {
 			constexpr base(T&& t)
 			noexcept(is_nothrow_constructible<storage_t,
 				in_place_index_t<constructible_from<T&&, Ts...>::index>, T&&>::value)
-			: index_{constructible_from<T&&, Ts...>::index}
+			: index_base_t{constructible_from<T&&, Ts...>::index}
 			, storage_{in_place_index<constructible_from<T&&, Ts...>::index>, std::forward<T>(t)}
-			{}
+			{ this->init_index(storage_, constructible_from<T&&, Ts...>::index); }
 
 			template <class T>
 			requires
@@ -281,9 +379,9 @@ STL2_OPEN_NAMESPACE {
 			constexpr base(T&& t)
 			noexcept(is_nothrow_constructible<storage_t,
 				in_place_index_t<constructible_from<T&&, Ts...>::index>, T&>::value)
-			: index_{constructible_from<T&&, Ts...>::index}
+			: index_base_t{constructible_from<T&&, Ts...>::index}
 			, storage_{in_place_index<constructible_from<T&&, Ts...>::index>, t}
-			{}
+			{ this->init_index(storage_, constructible_from<T&&, Ts...>::index); }
 
 			template <class T>
 			requires
@@ -295,23 +393,27 @@ STL2_OPEN_NAMESPACE {
 			requires Constructible<T, Args...>
 			explicit constexpr base(in_place_index_t<I>, Args&&... args)
 			noexcept(is_nothrow_constructible<storage_t, in_place_index_t<I>, Args...>::value)
-			: index_{I}, storage_{in_place_index<I>, std::forward<Args>(args)...} {}
+			: index_base_t{I}, storage_{in_place_index<I>, std::forward<Args>(args)...}
+			{ this->init_index(storage_, I); }
 
 			template <std::size_t I, class... Args, _Is<is_reference> T = meta::at_c<types, I>>
 			explicit constexpr base(in_place_index_t<I>, meta::id_t<T> t)
 			noexcept(is_nothrow_constructible<storage_t, in_place_index_t<I>, T&>::value)
-			: index_{I}, storage_{in_place_index<I>, t} {}
+			: index_base_t{I}, storage_{in_place_index<I>, t}
+			{ this->init_index(storage_, I); }
 
 			template <_IsNot<is_reference> T, class... Args, std::size_t I = index_of_type<T, types>>
 			requires Constructible<T, Args...>
 			explicit constexpr base(in_place_type_t<T>, Args&&... args)
 			noexcept(is_nothrow_constructible<storage_t, in_place_index_t<I>, Args...>::value)
-			: index_{I}, storage_{in_place_index<I>, std::forward<Args>(args)...} {}
+			: index_base_t{I}, storage_{in_place_index<I>, std::forward<Args>(args)...}
+			{ this->init_index(storage_, I); }
 
 			template <_Is<is_reference> T, std::size_t I = index_of_type<T, types>>
 			explicit constexpr base(in_place_type_t<T>, meta::id_t<T> t)
 			noexcept(is_nothrow_constructible<storage_t, in_place_index_t<I>, T&>::value)
-			: index_{I}, storage_{in_place_index<I>, t} {}
+			: index_base_t{I}, storage_{in_place_index<I>, t}
+			{ this->init_index(storage_, I); }
 
 			template <_IsNot<is_reference> T, class... Args, std::size_t I = index_of_type<T, types>>
 			requires Constructible<T, Args...>
@@ -386,17 +488,17 @@ STL2_OPEN_NAMESPACE {
 			}
 
 			constexpr std::size_t index() const noexcept {
-				return index_;
+				return raw_index();
 			}
 			constexpr bool valid() const noexcept
 			requires is_unsigned<index_t>::value
 			{
-				 // Consider index_ < invalid_index
-				return index_ != invalid_index;
+				 // Consider raw_index() < invalid_index
+				return raw_index() != invalid_index;
 			}
 			constexpr bool valid() const noexcept
 			requires is_signed<index_t>::value
-			{ return index_ >= 0; }
+			{ return raw_index() >= 0; }
 
 			template <std::size_t I, Variant V>
 			requires
@@ -693,7 +795,7 @@ STL2_OPEN_NAMESPACE {
 			is_nothrow_move_assignable<T>::value)
 		{
 			constexpr auto I = CF::index;
-			if (this->index_ == I) {
+			if (this->raw_index() == I) {
 				auto& target = __variant::v_access::raw_get(in_place_index<I>, *this);
 				target = std::move(t);
 			} else {
@@ -712,7 +814,7 @@ STL2_OPEN_NAMESPACE {
 			is_nothrow_move_constructible<T>::value)
 		{
 			constexpr auto I = CF::index;
-			if (this->index_ == I) {
+			if (this->raw_index() == I) {
 				auto& target = __variant::v_access::raw_get(in_place_index<I>, *this);
 				target = t;
 			} else {
@@ -740,7 +842,7 @@ STL2_OPEN_NAMESPACE {
 			Movable<base_t> && // Movable<variant> explodes here.
 			(Swappable<__variant::element_t<Ts>> && ...)
 		{
-			if (this->index_ == that.index_) {
+			if (this->raw_index() == that.raw_index()) {
 				if (this->valid()) {
 					__variant::raw_visit_with_index(swap_visitor{*this}, that);
 				}
@@ -760,7 +862,7 @@ STL2_OPEN_NAMESPACE {
 		friend constexpr bool operator==(const variant& lhs, const variant& rhs)
 		requires(EqualityComparable<__variant::element_t<Ts>> && ...)
 		{
-			if (lhs.index_ != rhs.index_) {
+			if (lhs.raw_index() != rhs.raw_index()) {
 				return false;
 			}
 			return __variant::visit_with_index(equal_to_visitor{lhs}, rhs);
@@ -775,9 +877,9 @@ STL2_OPEN_NAMESPACE {
 		friend constexpr bool operator<(const variant& lhs, const variant& rhs)
 		requires(StrictTotallyOrdered<__variant::element_t<Ts>> && ...)
 		{
-			if (lhs.index_ < rhs.index_) {
+			if (lhs.raw_index() < rhs.raw_index()) {
 				return true;
-			} else if (lhs.index_ == rhs.index_) {
+			} else if (lhs.raw_index() == rhs.raw_index()) {
 				return __variant::visit_with_index(less_than_visitor{lhs}, rhs);
 			} else {
 				return false;
@@ -0,0 +1,189 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_MAPPED_FILE_HPP
+#define STL2_VIEW_MAPPED_FILE_HPP
+
+#ifndef STL2_HAS_MMAP
+ #if defined(__unix__) || defined(__APPLE__)
+  #define STL2_HAS_MMAP 1
+ #else
+  #define STL2_HAS_MMAP 0
+ #endif
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/range/concepts.hpp>
+
+#if STL2_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+///////////////////////////////////////////////////////////////////////////
+// mapped_file_view [Extension]
+//
+// The contents of a file, mapped into memory with mmap, as a contiguous
+// sized view of the T objects it holds; a trailing partial object is not
+// part of the view. mapped_file_view<const T> maps the file read-only, and
+// mapped_file_view<T> maps it shared and writable, so that stores through
+// the view change the file. Copies of a view share its mapping, which is
+// unmapped with the last of them. Failures to open or map the file throw
+// std::system_error.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// How a view will be read, for madvise.
+		enum class map_advice { normal, sequential, random };
+	}
+
+	namespace detail {
+		[[noreturn]] inline void throw_mapping_error(int error, const char* what) {
+			throw std::system_error{error, std::generic_category(), what};
+		}
+
+		// A whole file mapped into memory.
+		class file_mapping {
+		public:
+			file_mapping(const char* path, bool writable) {
+				int const fd = ::open(path, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+				if (fd < 0) {
+					detail::throw_mapping_error(errno, "mapped_file_view: open");
+				}
+				struct ::stat st;
+				if (::fstat(fd, &st) != 0) {
+					int const error = errno;
+					::close(fd);
+					detail::throw_mapping_error(error, "mapped_file_view: fstat");
+				}
+				size_ = static_cast<std::size_t>(st.st_size);
+				if (size_ != 0) {
+					void* const p = ::mmap(nullptr, size_,
+						PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+					if (p == MAP_FAILED) {
+						int const error = errno;
+						::close(fd);
+						detail::throw_mapping_error(error, "mapped_file_view: mmap");
+					}
+					data_ = p;
+				}
+				::close(fd);
+			}
+			file_mapping(const file_mapping&) = delete;
+			file_mapping& operator=(const file_mapping&) = delete;
+			~file_mapping() {
+				if (data_) {
+					::munmap(data_, size_);
+				}
+			}
+
+			void* data() const noexcept { return data_; }
+			std::size_t size() const noexcept { return size_; }
+
+			bool advise(int advice) const noexcept {
+				return !data_ || ::madvise(data_, size_, advice) == 0;
+			}
+
+			void sync() const {
+				if (data_ && ::msync(data_, size_, MS_SYNC) != 0) {
+					detail::throw_mapping_error(errno, "mapped_file_view: msync");
+				}
+			}
+
+		private:
+			void* data_ = nullptr;
+			std::size_t size_ = 0;
+		};
+	}
+
+	namespace ext {
+		template <class T>
+		requires
+			TriviallyCopyable<std::remove_const_t<T>> &&
+			!_Is<T, std::is_volatile>
+		class mapped_file_view : view_base {
+		public:
+			mapped_file_view() = default;
+
+			explicit mapped_file_view(const char* path,
+				map_advice advice = map_advice::normal)
+			: mapping_{std::make_shared<const detail::file_mapping>(
+				path, !std::is_const<T>::value)}
+			, data_{static_cast<T*>(mapping_->data())}
+			, size_{static_cast<std::ptrdiff_t>(mapping_->size() / sizeof(T))}
+			{
+				if (advice != map_advice::normal) {
+					this->advise(advice);
+				}
+			}
+			explicit mapped_file_view(const std::string& path,
+				map_advice advice = map_advice::normal)
+			: mapped_file_view{path.c_str(), advice}
+			{}
+
+			T* begin() const noexcept { return data_; }
+			T* end() const noexcept { return data_ + size_; }
+			T* data() const noexcept { return data_; }
+			std::ptrdiff_t size() const noexcept { return size_; }
+			bool empty() const noexcept { return size_ == 0; }
+
+			// Returns whether the kernel took the advice.
+			bool advise(map_advice advice) const noexcept {
+				if (!mapping_) {
+					return true;
+				}
+				switch (advice) {
+				case map_advice::sequential:
+					return mapping_->advise(MADV_SEQUENTIAL);
+				case map_advice::random:
+					return mapping_->advise(MADV_RANDOM);
+				default:
+					return mapping_->advise(MADV_NORMAL);
+				}
+			}
+
+			// Asks for the mapping to be backed by transparent huge pages;
+			// returns whether the kernel took the request. Few file systems
+			// can back a file mapping so.
+			bool use_huge_pages() const noexcept {
+#ifdef MADV_HUGEPAGE
+				return mapping_ && mapping_->advise(MADV_HUGEPAGE);
+#else
+				return false;
+#endif
+			}
+
+			// Writes the stores made through the view back to the file.
+			void sync() const
+			requires !_Is<T, std::is_const>
+			{
+				if (mapping_) {
+					mapping_->sync();
+				}
+			}
+
+		private:
+			std::shared_ptr<const detail::file_mapping> mapping_;
+			T* data_ = nullptr;
+			std::ptrdiff_t size_ = 0;
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif // STL2_HAS_MMAP
+
+#endif
@@ -15,7 +15,12 @@
 #include <stl2/utility.hpp>
 #include <algorithm>
 #include <cstring>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../test_iterators.hpp"
 
 namespace ranges = __stl2;
 
@@ -115,5 +120,92 @@ int main()
 		check_equal(target, {0,1,2,3,4,5,6,0});
 	}
 
+	{
+		// Contiguous trivially copyable ranges are copied with memmove.
+		static_assert(ranges::detail::MemCopyable<const int*, int*>);
+		static_assert(ranges::detail::MemCopyable<
+			std::vector<int>::const_iterator, std::vector<int>::iterator>);
+		static_assert(ranges::detail::MemCopyable<
+			ranges::move_iterator<std::string::iterator>, char*>);
+		static_assert(ranges::detail::MemCopyable<
+			ranges::counted_iterator<const int*>, ranges::counted_iterator<int*>>);
+		static_assert(!ranges::detail::MemCopyable<int*, const int*>);
+		static_assert(!ranges::detail::MemCopyable<int*, long*>);
+		static_assert(!ranges::detail::MemCopyable<volatile int*, int*>);
+		static_assert(!ranges::detail::MemCopyable<std::string*, std::string*>);
+		static_assert(!ranges::detail::MemCopyable<
+			std::vector<bool>::iterator, std::vector<bool>::iterator>);
+		// Nor are iterators over elements that no vector could hold.
+		struct abstract { virtual void f() = 0; };
+		static_assert(!ranges::detail::MemCopyable<
+			random_access_iterator<const abstract*>, random_access_iterator<abstract*>>);
+
+		std::vector<int> v{1,2,3,4,5,6};
+		std::vector<int> w(8);
+		auto r1 = ranges::copy(v, w.begin() + 1);
+		CHECK(r1.in() == v.end());
+		CHECK(r1.out() == w.begin() + 7);
+		check_equal(w, {0,1,2,3,4,5,6,0});
+
+		std::string s = "hello";
+		char buf[6] = {};
+		auto r2 = ranges::copy(ranges::make_move_iterator(s.begin()),
+			ranges::make_move_iterator(s.end()), buf);
+		CHECK(r2.in().base() == s.end());
+		CHECK(r2.out() == buf + 5);
+		CHECK(std::strcmp(buf, "hello") == 0);
+
+		auto r3 = ranges::copy(ranges::make_counted_iterator(v.data(), 6),
+			ranges::default_sentinel{}, ranges::make_counted_iterator(w.data(), 8));
+		CHECK(r3.in().count() == 0);
+		CHECK(r3.out().count() == 2);
+
+		// Empty ranges don't touch either side.
+		CHECK(ranges::copy(v.data(), v.data(), (int*)nullptr).out() == nullptr);
+	}
+
+	{
+		// Contiguous characters go to an ostreambuf_iterator in one sputn.
+		struct limited_buf : std::streambuf {
+			std::string s_;
+			std::streamsize limit_;
+			int calls_ = 0;
+
+			explicit limited_buf(std::streamsize limit) : limit_(limit) {}
+
+			int_type overflow(int_type) override {
+				++calls_;
+				return traits_type::eof();
+			}
+			std::streamsize xsputn(const char* p, std::streamsize n) override {
+				++calls_;
+				n = std::min<std::streamsize>(n, limit_ - s_.size());
+				s_.append(p, n);
+				return n;
+			}
+		};
+		using O = ranges::ostreambuf_iterator<char>;
+		const std::string text(2000, 'x');
+
+		limited_buf buf{10000};
+		auto r1 = ranges::copy(text, O{&buf});
+		CHECK(r1.in() == text.end());
+		CHECK(r1.out() != ranges::default_sentinel{});
+		CHECK(buf.s_ == text);
+		CHECK(buf.calls_ == 1);
+
+		limited_buf small{100};
+		auto r2 = ranges::copy(text, O{&small});
+		CHECK(r2.out() == ranges::default_sentinel{});
+		CHECK(small.s_ == text.substr(0, 100));
+
+		std::istringstream is{text};
+		std::ostringstream os;
+		auto r3 = ranges::copy(ranges::istreambuf_iterator<char>{is},
+			ranges::default_sentinel{}, O{os});
+		CHECK(r3.in() == ranges::default_sentinel{});
+		CHECK(os.str() == text);
+	}
+
 	return test_result();
 }
@@ -15,6 +15,7 @@
 #include <cstring>
 #include <utility>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -88,5 +89,14 @@ int main()
 	test_repeat_view();
 	test_initializer_list();
 
+	{
+		// Overlapping copy towards the back
+		std::vector<int> v{0,1,2,3,4,5};
+		auto r = ranges::copy_backward(v.begin(), v.begin() + 4, v.end());
+		CHECK(r.in() == v.begin() + 4);
+		CHECK(r.out() == v.begin() + 2);
+		CHECK(std::equal(v.begin(), v.end(), std::vector<int>{0,1,0,1,2,3}.begin()));
+	}
+
 	return test_result();
 }
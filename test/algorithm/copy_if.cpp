@@ -11,7 +11,9 @@
 //
 #include <stl2/detail/algorithm/copy_if.hpp>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../test_utils.hpp"
 
 namespace ranges = __stl2;
 
@@ -104,5 +106,19 @@ int main() {
 		CHECK(std::count(target + n / 2, target + n, -1) == n / 2);
 	}
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto const source) {
+		using T = typename decltype(source)::value_type;
+		auto const x = static_cast<T>(-2);
+		// One element of slack, which must not be written.
+		std::vector<T> target(source.size() + 1, T(42)), expected(source.size() + 1, T(42));
+		auto res = ranges::copy_if(source, target.begin(), ranges::ext::greater_than<T>{x});
+		auto e = std::copy_if(source.begin(), source.end(), expected.begin(),
+			[x](T v) { return v > x; });
+		CHECK(res.in() == source.end());
+		auto const m = e - expected.begin();
+		CHECK(res.out() == target.begin() + m);
+		CHECK(target == expected);
+	});
+
 	return test_result();
 }
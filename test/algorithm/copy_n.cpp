@@ -11,6 +11,7 @@
 //
 #include <stl2/detail/algorithm/copy_n.hpp>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace stl2 = __stl2;
@@ -30,5 +31,14 @@ int main() {
 	CHECK(target[n - 2] == 0);
 	CHECK(target[n - 1] == 0);
 
+	{
+		// Overlapping copy towards the front
+		std::vector<int> v{0,1,2,3,4,5};
+		auto r = stl2::copy_n(stl2::make_counted_iterator(v.begin() + 2, 4), 3, v.begin());
+		CHECK(r.in().count() == 1);
+		CHECK(r.out() == v.begin() + 3);
+		CHECK(std::equal(v.begin(), v.end(), std::vector<int>{2,3,4,3,4,5}.begin()));
+	}
+
 	return test_result();
 }
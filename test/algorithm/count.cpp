@@ -10,6 +10,8 @@
 // Project home: https://github.com/ericniebler/range-v3
 
 #include <stl2/detail/algorithm/count.hpp>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -18,6 +20,29 @@ struct S
 	int i;
 };
 
+template <class T>
+void test_kernels()
+{
+	namespace simd = __stl2::detail::simd;
+	for (int n = 0; n <= 70; ++n) {
+		std::vector<T> v(n);
+		int expected = 0;
+		for (int i = 0; i < n; ++i) {
+			v[i] = T(i % 3 ? -1 : 7);
+			expected += i % 3 ? 1 : 0;
+		}
+		CHECK(__stl2::count(v, T(-1)) == expected);
+		CHECK(__stl2::count(v.data(), v.data() + n, T(-1)) == expected);
+		CHECK(simd::scalar::count(v.data(), v.data() + n, T(-1)) == expected);
+#if STL2_SIMD_X86
+		CHECK(simd::sse2::count(v.data(), v.data() + n, T(-1)) == expected);
+		if (simd::has_avx2()) {
+			CHECK(simd::avx2::count(v.data(), v.data() + n, T(-1)) == expected);
+		}
+#endif
+	}
+}
+
 int main()
 {
 	using namespace __stl2;
@@ -66,5 +91,21 @@ int main()
 		CHECK(count(std::move(l), 7) == 0);
 	}
 
+	test_kernels<std::uint8_t>();
+	test_kernels<std::int16_t>();
+	test_kernels<std::uint32_t>();
+	test_kernels<std::int64_t>();
+
+	{
+		std::vector<signed char> v(100, -1);
+		CHECK(count(v, 255) == 0);
+		CHECK(count(v, -1) == 100);
+
+		bool b[40] = {};
+		b[3] = b[17] = b[39] = true;
+		CHECK(count(b, true) == 3);
+		CHECK(count(b, false) == 37);
+	}
+
 	return ::test_result();
 }
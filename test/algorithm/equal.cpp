@@ -19,6 +19,8 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/equal.hpp>
+#include <cstddef>
+#include <cstdint>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -274,6 +276,25 @@ void test_rng_pred()
 											 std::equal_to<int>()));
 }
 
+template <class T>
+void test_kernels()
+{
+	T a[71], b[71];
+	for (int i = 0; i < 71; ++i) {
+		a[i] = b[i] = T(3);
+	}
+	for (int n = 0; n <= 70; ++n) {
+		CHECK(ranges::equal(a, a + n, b, b + n));
+		CHECK(!ranges::equal(a, a + n, b, b + n + 1));
+		for (int i = 0; i < n; ++i) {
+			b[i] = T(-3);
+			CHECK(!ranges::equal(a, a + n, b, b + n));
+			CHECK(ranges::equal(a, a + i, b, b + i));
+			b[i] = T(3);
+		}
+	}
+}
+
 int main()
 {
 	::test();
@@ -288,5 +309,14 @@ int main()
 		CHECK(ranges::equal(ranges::begin(a), ranges::end(a), ranges::begin(b)));
 	}
 
+	test_kernels<std::int8_t>();
+	test_kernels<std::uint16_t>();
+	test_kernels<std::int32_t>();
+	test_kernels<std::int64_t>();
+	test_kernels<unsigned char>();
+#ifdef __cpp_lib_byte
+	test_kernels<std::byte>();
+#endif
+
 	return ::test_result();
 }
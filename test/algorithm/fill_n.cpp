@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/fill_n.hpp>
 #include <cstring>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "../simple_test.hpp"
@@ -109,5 +110,15 @@ int main()
 	test_int<bidirectional_iterator<int*>, sentinel<int*> >();
 	test_int<random_access_iterator<int*>, sentinel<int*> >();
 
+	{
+		std::ostringstream os;
+		auto o = stl2::fill_n(stl2::ostreambuf_iterator<char>{os}, 1500, ',');
+		CHECK(o != stl2::default_sentinel{});
+		CHECK(os.str() == std::string(1500, ','));
+		stl2::fill_n(o, 0, '.');
+		stl2::fill_n(o, -1, '.');
+		CHECK(os.str().size() == 1500u);
+	}
+
 	return ::test_result();
 }
@@ -20,6 +20,8 @@
 
 #include <stl2/detail/algorithm/find.hpp>
 #include <stl2/utility.hpp>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -30,6 +32,32 @@ struct S
 
 template <class> class show_type;
 
+// Every match position and length around the vector widths, through the
+// public interface and through each kernel directly.
+template <class T>
+void test_kernels()
+{
+	namespace simd = __stl2::detail::simd;
+	for (int n = 0; n <= 70; ++n) {
+		std::vector<T> v(n, T(1));
+		CHECK(__stl2::find(v, T(2)) == v.end());
+		for (int i = 0; i < n; ++i) {
+			v[i] = T(-2);
+			auto const pos = __stl2::find(v, T(-2)) - v.begin();
+			CHECK(pos == i);
+			CHECK(__stl2::find(v.data(), v.data() + n, T(-2)) == v.data() + i);
+			CHECK(simd::scalar::find(v.data(), v.data() + n, T(-2)) == v.data() + i);
+#if STL2_SIMD_X86
+			CHECK(simd::sse2::find(v.data(), v.data() + n, T(-2)) == v.data() + i);
+			if (simd::has_avx2()) {
+				CHECK(simd::avx2::find(v.data(), v.data() + n, T(-2)) == v.data() + i);
+			}
+#endif
+			v[i] = T(1);
+		}
+	}
+}
+
 int main()
 {
 	using namespace __stl2;
@@ -61,5 +89,24 @@ int main()
 	ps = find(sa, 10, &S::i_);
 	CHECK(ps == end(sa));
 
+	test_kernels<std::int8_t>();
+	test_kernels<std::uint16_t>();
+	test_kernels<std::int32_t>();
+	test_kernels<std::uint64_t>();
+	test_kernels<char32_t>();
+
+	{
+		// Values the element type can't hold are never found.
+		std::vector<unsigned char> v(100, 44);
+		CHECK(find(v, 300) == v.end());
+		CHECK(find(v, 44 + 256) == v.end());
+		CHECK(find(v, 44) == v.begin());
+		std::vector<std::int64_t> w(100, -1);
+		w[50] = std::int64_t{1} << 32;
+		CHECK(find(w, std::int64_t{0}) == w.end());
+		CHECK(find(w, std::int64_t{1} << 32) == w.begin() + 50);
+		CHECK(find(w, 1) == w.end());
+	}
+
 	return ::test_result();
 }
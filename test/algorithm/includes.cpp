@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/includes.hpp>
 #include <functional>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -149,5 +150,23 @@ int main()
 		CHECK(stl2::includes(ia, id, std::less<int>(), &S::i, &T::j));
 	}
 
+	// Test galloping on skewed inputs
+	{
+		std::vector<int> big;
+		for (int i = 0; i < 10000; ++i) {
+			big.push_back(3 * i);
+		}
+		std::vector<int> const subset = {0, 3, 300, 9000, 9003, 29997};
+		std::vector<int> const other = {0, 3, 301, 9000};
+		int comparisons = 0;
+		auto const less = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+		CHECK(stl2::includes(big, subset, less));
+		CHECK(comparisons < 1000);
+		comparisons = 0;
+		CHECK(!stl2::includes(big, other, less));
+		CHECK(comparisons < 1000);
+		CHECK(!stl2::includes(subset, big, less));
+	}
+
 	return ::test_result();
 }
@@ -22,8 +22,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <random>
+#include <string>
+#include <vector>
 #include <stl2/utility.hpp>
 #include <stl2/detail/algorithm/is_permutation.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
+#include <stl2/detail/algorithm/shuffle.hpp>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -49,6 +54,62 @@ struct T
 	int i;
 };
 
+// StrictTotallyOrdered, but not Hashable.
+struct ordered
+{
+	int i;
+	friend bool operator==(ordered a, ordered b) { return a.i == b.i; }
+	friend bool operator!=(ordered a, ordered b) { return !(a == b); }
+	friend bool operator<(ordered a, ordered b) { return a.i < b.i; }
+	friend bool operator>(ordered a, ordered b) { return b < a; }
+	friend bool operator<=(ordered a, ordered b) { return !(b < a); }
+	friend bool operator>=(ordered a, ordered b) { return !(a < b); }
+};
+
+// Large inputs take the hashed and sorted paths; values that differ only
+// in their high bits all collide in std::hash's low bits.
+template <class V, class F>
+void test_large(int n, F make)
+{
+	std::vector<V> a, b;
+	for (int i = 0; i < n; ++i) {
+		a.push_back(make(i / 3));
+	}
+	b = a;
+	stl2::shuffle(b, std::mt19937{n});
+	CHECK(stl2::is_permutation(a, b));
+	CHECK(stl2::is_permutation(a.begin(), a.end(), b.begin(), b.end()));
+	stl2::reverse(b);
+	CHECK(stl2::is_permutation(forward_iterator<const V*>(a.data()),
+							   sentinel<const V*>(a.data() + n),
+							   forward_iterator<const V*>(b.data()),
+							   sentinel<const V*>(b.data() + n)));
+
+	// Same distinct values, different counts.
+	auto c = b;
+	CHECK(c.front() != c.back());
+	c.front() = c.back();
+	CHECK(!stl2::is_permutation(a, c));
+	CHECK(!stl2::is_permutation(c, a));
+	// A value missing from the first range.
+	c.front() = make(n);
+	CHECK(!stl2::is_permutation(a, c));
+	CHECK(!stl2::is_permutation(c, a));
+}
+
+void test_projected()
+{
+	std::vector<S> a;
+	std::vector<T> b;
+	for (int i = 0; i < 1000; ++i) {
+		a.push_back(S{i % 7});
+		b.push_back(T{(999 - i) % 7});
+	}
+	CHECK(stl2::is_permutation(a, b, stl2::equal_to<>{}, &S::i, &T::i));
+	b[0].i = 7;
+	CHECK(!stl2::is_permutation(a, b, stl2::equal_to<>{}, &S::i, &T::i));
+}
+
 int main()
 {
 	{
@@ -856,5 +917,11 @@ int main()
 		CHECK(stl2::is_permutation(stl2::begin(a), stl2::end(a), stl2::begin(b)));
 	}
 
+	test_large<int>(1000, [](int i) { return i << 20; });
+	test_large<int>(1000, [](int i) { return i; });
+	test_large<std::string>(1000, [](int i) { return std::to_string(i); });
+	test_large<ordered>(1000, [](int i) { return ordered{i}; });
+	test_projected();
+
 	return ::test_result();
 }
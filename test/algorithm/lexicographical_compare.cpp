@@ -19,6 +19,8 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <cstddef>
+#include <cstdint>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -168,10 +170,63 @@ void test_iter_comp()
 }
 
 
+template <class T>
+bool less_loop(const T* a, int n1, const T* b, int n2)
+{
+	for (int i = 0; i < n1 && i < n2; ++i) {
+		if (a[i] < b[i]) {
+			return true;
+		}
+		if (b[i] < a[i]) {
+			return false;
+		}
+	}
+	return n1 < n2;
+}
+
+template <class T>
+void test_kernels()
+{
+	T a[71], b[71];
+	for (int i = 0; i < 71; ++i) {
+		a[i] = b[i] = T(i * 37 % 5);
+	}
+	for (int n = 0; n <= 70; ++n) {
+		CHECK(!ranges::lexicographical_compare(a, a + n, b, b + n));
+		CHECK(ranges::lexicographical_compare(a, a + n, b, b + n + 1));
+		CHECK(!ranges::lexicographical_compare(a, a + n + 1, b, b + n));
+		for (int i = 0; i < n; ++i) {
+			// Negative values must not order as large unsigned ones
+			// unless T is unsigned.
+			for (int v : {-3, 0, 7, 200}) {
+				b[i] = T(v);
+				CHECK(ranges::lexicographical_compare(a, a + n, b, b + n) ==
+					less_loop(a, n, b, n));
+				CHECK(ranges::lexicographical_compare(b, b + n, a, a + i + 1) ==
+					less_loop(b, n, a, i + 1));
+			}
+			b[i] = a[i];
+		}
+	}
+	int x[] = {1, 2, 3};
+	int y[] = {1, 2, 3, 0};
+	CHECK(ranges::lexicographical_compare(x, y));
+	CHECK(!ranges::lexicographical_compare(y, x));
+}
+
 int main()
 {
 	test_iter();
 	test_iter_comp();
 
+	test_kernels<char>();
+	test_kernels<unsigned char>();
+#ifdef __cpp_lib_byte
+	test_kernels<std::byte>();
+#endif
+	test_kernels<std::int16_t>();
+	test_kernels<std::uint32_t>();
+	test_kernels<std::int64_t>();
+
 	return test_result();
 }
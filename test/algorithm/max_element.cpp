@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/max_element.hpp>
 #include <memory>
+#include <vector>
 #include <numeric>
 #include <random>
 #include <algorithm>
@@ -169,5 +170,28 @@ int main()
 	S const *ps = stl2::max_element(s, std::less<int>{}, &S::i);
 	CHECK(ps->i == 40);
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		auto const n = a.size();
+		if (n == 0) {
+			CHECK(stl2::max_element(a) == a.end());
+			return;
+		}
+		auto m = a.begin();
+		for (auto i = a.begin(); i != a.end(); ++i) {
+			if (!(*i < *m)) {
+				m = i;
+			}
+		}
+		CHECK(stl2::max_element(a) == m);
+		CHECK(stl2::max_element(a.begin(), a.end(), std::less<>{}) == m);
+
+		// The last of equal maxima.
+		a.assign(n, T(2));
+		a[0] = T(3);
+		a[n / 2] = T(3);
+		CHECK(stl2::max_element(a) == a.begin() + n / 2);
+	});
+
 	return test_result();
 }
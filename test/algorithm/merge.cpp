@@ -15,8 +15,10 @@
 
 #include <stl2/detail/algorithm/merge.hpp>
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace stl2 = __stl2;
@@ -83,5 +85,66 @@ int main()
 		CHECK(std::is_sorted(ic.get(), ic.get() + 2 * N));
 	}
 
+	{
+		// Stability: equivalent elements of the first range come first.
+		std::pair<int, int> a[] = {{0, 0}, {1, 0}, {1, 0}, {2, 0}};
+		std::pair<int, int> b[] = {{1, 1}, {2, 1}, {2, 1}};
+		std::pair<int, int> c[7];
+		stl2::merge(a, b, c, stl2::less<>{}, &std::pair<int, int>::first,
+			&std::pair<int, int>::first);
+		std::pair<int, int> expected[] = {{0, 0}, {1, 0}, {1, 0}, {1, 1},
+			{2, 0}, {2, 1}, {2, 1}};
+		CHECK(std::equal(c, c + 7, expected));
+	}
+
+	// Test galloping on skewed inputs
+	{
+		std::vector<int> big;
+		for (int i = 0; i < 10000; ++i) {
+			big.push_back(3 * i);
+			if (i % 100 == 0) {
+				big.push_back(3 * i);
+			}
+		}
+		std::vector<int> const small = {-1, 5, 6, 300, 301, 9000, 9000, 9000, 29997, 40000};
+		int comparisons = 0;
+		auto const less = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+		for (int pass = 0; pass < 2; ++pass) {
+			auto const& a = pass ? big : small;
+			auto const& b = pass ? small : big;
+			std::vector<int> expected;
+			std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+			std::vector<int> actual(a.size() + b.size());
+			comparisons = 0;
+			auto const end = stl2::merge(a, b, actual.begin(), less).out();
+			actual.erase(end, actual.end());
+			CHECK(actual == expected);
+			CHECK(comparisons < 1000);
+		}
+	}
+
+	// Test merge_path
+	{
+		using P = std::pair<int, int>;
+		std::vector<P> a, b;
+		for (int i = 0; i < 40; ++i) a.push_back({i / 4, 0});
+		for (int i = 0; i < 25; ++i) b.push_back({i / 2, 1});
+		std::vector<P> expected(a.size() + b.size());
+		stl2::merge(a, b, expected.begin(), stl2::less<>{}, &P::first, &P::first);
+		auto const n = static_cast<int>(expected.size());
+		for (int d = 0; d <= n; ++d) {
+			auto const p = stl2::ext::merge_path(a, b, d, stl2::less<>{}, &P::first, &P::first);
+			auto const taken = (p.in1() - a.begin()) + (p.in2() - b.begin());
+			CHECK(taken == d);
+			std::vector<P> head(d), tail(n - d);
+			stl2::merge(a.begin(), p.in1(), b.begin(), p.in2(), head.begin(),
+				stl2::less<>{}, &P::first, &P::first);
+			stl2::merge(p.in1(), a.end(), p.in2(), b.end(), tail.begin(),
+				stl2::less<>{}, &P::first, &P::first);
+			CHECK(std::equal(head.begin(), head.end(), expected.begin()));
+			CHECK(std::equal(tail.begin(), tail.end(), expected.begin() + d));
+		}
+	}
+
 	return ::test_result();
 }
@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/min_element.hpp>
 #include <memory>
+#include <vector>
 #include <random>
 #include <numeric>
 #include <algorithm>
@@ -169,5 +170,28 @@ int main()
 	S const *ps = stl2::min_element(s, std::less<int>{}, &S::i);
 	CHECK(ps->i == -4);
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		auto const n = a.size();
+		if (n == 0) {
+			CHECK(stl2::min_element(a) == a.end());
+			return;
+		}
+		auto m = a.begin();
+		for (auto i = a.begin(); i != a.end(); ++i) {
+			if (*i < *m) {
+				m = i;
+			}
+		}
+		CHECK(stl2::min_element(a) == m);
+		CHECK(stl2::min_element(a.begin(), a.end(), std::less<>{}) == m);
+
+		// The first of equal minima.
+		a.assign(n, T(3));
+		a[n - 1] = T(2);
+		a[n / 2] = T(2);
+		CHECK(stl2::min_element(a) == a.begin() + n / 2);
+	});
+
 	return test_result();
 }
@@ -21,7 +21,9 @@
 
 #include <stl2/detail/algorithm/minmax.hpp>
 #include <cassert>
+#include <limits>
 #include <memory>
+#include <vector>
 #include <numeric>
 #include <random>
 #include <algorithm>
@@ -141,5 +143,25 @@ int main()
 	CHECK(res.second.value == 40);
 	CHECK(res.second.index == 7);
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		if (a.empty()) {
+			return;
+		}
+		auto lo = a[0], hi = a[0];
+		for (auto e : a) {
+			lo = e < lo ? e : lo;
+			hi = e < hi ? hi : e;
+		}
+		auto r = stl2::minmax(a);
+		CHECK(r.min() == lo);
+		CHECK(r.max() == hi);
+		r = stl2::ext::minmax(a.begin(), a.end());
+		CHECK(r.min() == lo);
+		CHECK(r.max() == hi);
+		a.back() = std::numeric_limits<T>::max();
+		CHECK(stl2::ext::minmax(a.begin(), a.end()).max() == std::numeric_limits<T>::max());
+	});
+
 	return test_result();
 }
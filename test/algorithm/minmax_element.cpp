@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/minmax_element.hpp>
 #include <memory>
+#include <vector>
 #include <numeric>
 #include <random>
 #include <algorithm>
@@ -228,5 +229,31 @@ int main()
 	CHECK(ps.first->i == -4);
 	CHECK(ps.second->i == 40);
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		auto r = stl2::minmax_element(a);
+		if (a.empty()) {
+			CHECK(r.min() == a.end());
+			CHECK(r.max() == a.end());
+			return;
+		}
+		auto lo = a.begin(), hi = a.begin();
+		for (auto i = a.begin(); i != a.end(); ++i) {
+			if (*i < *lo) {
+				lo = i;
+			}
+			if (!(*i < *hi)) {
+				hi = i;
+			}
+		}
+		CHECK(r.min() == lo);
+		CHECK(r.max() == hi);
+
+		a.assign(a.size(), T(2));
+		r = stl2::minmax_element(a);
+		CHECK(r.min() == a.begin());
+		CHECK(r.max() == a.end() - 1);
+	});
+
 	return test_result();
 }
@@ -21,6 +21,8 @@
 #include <stl2/detail/algorithm/mismatch.hpp>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -101,6 +103,33 @@ struct S
 	int i;
 };
 
+template <class T>
+void test_kernels()
+{
+	namespace simd = __stl2::detail::simd;
+	for (int n = 0; n <= 70; ++n) {
+		std::vector<T> a(n, T(5)), b(n + 3, T(5));
+		auto r = ranges::mismatch(a, b);
+		CHECK(r.in1() == a.end());
+		CHECK(r.in2() == b.begin() + n);
+		for (int i = 0; i < n; ++i) {
+			// Differ only in the high byte of an element.
+			b[i] = T(5 | (T(1) << (8 * sizeof(T) - 2)));
+			r = ranges::mismatch(a, b);
+			CHECK(r.in1() == a.begin() + i);
+			CHECK(r.in2() == b.begin() + i);
+			CHECK(simd::scalar::mismatch(a.data(), b.data(), n) == i);
+#if STL2_SIMD_X86
+			CHECK(simd::sse2::mismatch(a.data(), b.data(), n) == i);
+			if (simd::has_avx2()) {
+				CHECK(simd::avx2::mismatch(a.data(), b.data(), n) == i);
+			}
+#endif
+			b[i] = T(5);
+		}
+	}
+}
+
 int main()
 {
 	test_iter<input_iterator<const int*>>();
@@ -146,6 +175,11 @@ int main()
 		CHECK(ps2.first->i == -4);
 		CHECK(ps2.second->i == 5);
 	}
+
+	test_kernels<std::uint8_t>();
+	test_kernels<std::int16_t>();
+	test_kernels<std::int32_t>();
+	test_kernels<std::uint64_t>();
 	{
 		std::pair<S const *, S const *> ps2
 			= ranges::mismatch(ranges::begin(s1), ranges::end(s2), s2, std::equal_to<int>(), &S::i, &S::i);
@@ -21,6 +21,7 @@
 #include <stl2/detail/algorithm/move_backward.hpp>
 #include <memory>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -141,5 +142,14 @@ int main()
 	test1<std::unique_ptr<int>*, random_access_iterator<std::unique_ptr<int>*> >();
 	test1<std::unique_ptr<int>*, std::unique_ptr<int>*>();
 
+	{
+		// Overlapping move towards the back
+		std::vector<int> v{0,1,2,3,4,5};
+		auto r = stl2::move_backward(v.begin() + 1, v.begin() + 5, v.end());
+		CHECK(r.in() == v.begin() + 5);
+		CHECK(r.out() == v.begin() + 2);
+		CHECK(std::equal(v.begin(), v.end(), std::vector<int>{0,1,1,2,3,4}.begin()));
+	}
+
 	return test_result();
 }
@@ -0,0 +1,100 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/multiway_merge.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace stl2 = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct rec {
+		int key;
+		int seq;
+	};
+
+	// k runs of random lengths up to max_len, with keys from [0, range).
+	std::vector<std::vector<rec>> random_runs(int k, int max_len, int range)
+	{
+		std::vector<std::vector<rec>> runs(k);
+		int seq = 0;
+		for (auto& run : runs) {
+			run.resize(gen() % (max_len + 1));
+			for (auto& r : run) r.key = static_cast<int>(gen() % range);
+			std::sort(run.begin(), run.end(),
+				[](const rec& x, const rec& y) { return x.key < y.key; });
+			for (auto& r : run) r.seq = seq++;
+		}
+		return runs;
+	}
+
+	void test_runs(int k, int max_len, int range)
+	{
+		auto runs = random_runs(k, max_len, range);
+		std::vector<rec> expected;
+		for (auto& run : runs) expected.insert(expected.end(), run.begin(), run.end());
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const rec& x, const rec& y) { return x.key < y.key; });
+
+		std::vector<rec> out(expected.size());
+		auto r = stl2::ext::multiway_merge(runs, out.begin(), stl2::less<>{}, &rec::key);
+		CHECK(r.in() == runs.end());
+		CHECK(r.out() == out.end());
+		// Stable: ties are taken from earlier runs first.
+		CHECK(std::equal(out.begin(), out.end(), expected.begin(),
+			[](const rec& x, const rec& y) { return x.seq == y.seq; }));
+
+		std::vector<rec> back;
+		stl2::ext::multiway_merge(runs, stl2::back_inserter(back), stl2::greater<>{},
+			[](const rec& x) { return -x.key; });
+		CHECK(std::equal(back.begin(), back.end(), expected.begin(),
+			[](const rec& x, const rec& y) { return x.seq == y.seq; }));
+	}
+
+	void test_views()
+	{
+		// Runs that are views, and input iterators.
+		using I = input_iterator<const int*>;
+		static const int a[] = {1, 4, 7, 10};
+		static const int b[] = {2, 5, 8};
+		static const int c[] = {3, 6, 9, 11, 12};
+		std::vector<stl2::ext::range<I, I>> runs = {
+			{I(a), I(a + 4)}, {I(b), I(b)}, {I(b), I(b + 3)}, {I(c), I(c + 5)}
+		};
+		int out[12] = {};
+		auto r = stl2::ext::multiway_merge(runs, out);
+		CHECK(r.out() == out + 12);
+		for (int i = 0; i < 12; ++i) {
+			CHECK(out[i] == i + 1);
+		}
+
+		std::vector<stl2::ext::range<const int*, const int*>> none;
+		CHECK(stl2::ext::multiway_merge(none, out).out() == out);
+	}
+}
+
+int main()
+{
+	test_runs(0, 10, 10);
+	test_runs(1, 100, 10);
+	test_runs(2, 100, 10);
+	test_runs(3, 100, 10);
+	test_runs(7, 1000, 50);
+	test_runs(64, 1000, 1000);
+	test_runs(100, 10, 3);
+	test_views();
+
+	return ::test_result();
+}
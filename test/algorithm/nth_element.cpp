@@ -21,6 +21,7 @@
 #include <stl2/detail/algorithm/nth_element.hpp>
 #include <cassert>
 #include <memory>
+#include <vector>
 #include <random>
 #include <algorithm>
 #include "../simple_test.hpp"
@@ -71,6 +72,88 @@ struct S
 	int i,j;
 };
 
+// Checks that [first, last) is partitioned about each of the positions in ms.
+bool
+partitioned_at(const std::vector<int>& v, std::initializer_list<int> ms)
+{
+	std::vector<int> sorted = v;
+	std::sort(sorted.begin(), sorted.end());
+	int lo = 0;
+	for (int m : ms) {
+		if (v[m] != sorted[m])
+			return false;
+		if (!std::all_of(v.begin() + lo, v.begin() + m, [&](int x) { return x <= v[m]; }))
+			return false;
+		if (!std::all_of(v.begin() + m, v.end(), [&](int x) { return x >= v[m]; }))
+			return false;
+		lo = m;
+	}
+	return true;
+}
+
+void
+test_adversarial(int N)
+{
+	std::vector<std::vector<int>> inputs(5, std::vector<int>(N));
+	for (int i = 0; i < N; ++i) {
+		inputs[0][i] = 42;                             // all equal
+		inputs[1][i] = i;                              // ascending
+		inputs[2][i] = N - i;                          // descending
+		inputs[3][i] = i < N / 2 ? i : N - i;          // organ pipe
+		inputs[4][i] = i % 2 ? i : N / 2;              // half duplicates
+	}
+	for (auto const& input : inputs) {
+		for (int m : {0, 1, N / 3, N / 2, N - 2, N - 1}) {
+			auto v = input;
+			long comparisons = 0;
+			auto const comp = [&](int x, int y) { ++comparisons; return x < y; };
+			CHECK(stl2::nth_element(v, v.begin() + m, comp) == v.end());
+			CHECK(partitioned_at(v, {m}));
+			// Linear on average; a generous bound catches quadratic behavior.
+			CHECK(comparisons < 40L * N);
+		}
+	}
+}
+
+void
+test_nth_elements(int N)
+{
+	std::vector<int> v(N);
+	for (int i = 0; i < N; ++i)
+		v[i] = i % (N / 4);
+	std::shuffle(v.begin(), v.end(), gen);
+	int const p50 = N / 2, p90 = N * 9 / 10, p99 = N * 99 / 100, p999 = N * 999 / 1000;
+	std::vector<std::vector<int>::iterator> nths = {
+		v.begin() + p50, v.begin() + p90, v.begin() + p99, v.begin() + p999
+	};
+	CHECK(stl2::ext::nth_elements(v, nths) == v.end());
+	CHECK(partitioned_at(v, {p50, p90, p99, p999}));
+
+	// Every position, with a projection.
+	std::vector<S> ia(N);
+	for (int i = 0; i < N; ++i)
+		ia[i].i = ia[i].j = i;
+	std::shuffle(ia.begin(), ia.end(), gen);
+	std::vector<std::vector<S>::iterator> all;
+	for (auto i = ia.begin(); i != ia.end(); ++i)
+		all.push_back(i);
+	CHECK(stl2::ext::nth_elements(ia.begin(), ia.end(), all, std::less<int>(), &S::i) == ia.end());
+	CHECK(std::is_sorted(ia.begin(), ia.end(), [](S x, S y) { return x.i < y.i; }));
+
+	// Adjacent and end positions; no positions at all.
+	std::shuffle(v.begin(), v.end(), gen);
+	nths = {v.begin(), v.begin() + 1, v.begin() + 2, v.end() - 1, v.end()};
+	stl2::ext::nth_elements(v, nths, std::greater<>());
+	std::vector<int> sorted = v;
+	std::sort(sorted.begin(), sorted.end(), std::greater<>());
+	CHECK(v[0] == sorted[0]);
+	CHECK(v[1] == sorted[1]);
+	CHECK(v[2] == sorted[2]);
+	CHECK(v[N - 1] == sorted[N - 1]);
+	nths.clear();
+	CHECK(stl2::ext::nth_elements(v, nths) == v.end());
+}
+
 int main()
 {
 	int d = 0;
@@ -95,5 +178,25 @@ int main()
 	CHECK(ia[M].i == M);
 	CHECK(ia[M].j == M);
 
+	// Many duplicates, descending order
+	{
+		const int N = 1000;
+		std::unique_ptr<int[]> array{new int[N]};
+		for (int m : {0, 1, 17, N / 2, N - 1}) {
+			for (int i = 0; i < N; ++i)
+				array[i] = i % 5;
+			std::shuffle(array.get(), array.get()+N, gen);
+			stl2::nth_element(array.get(), array.get()+m, array.get()+N, std::greater<>());
+			CHECK(array[m] == 4 - m * 5 / N);
+			CHECK(std::all_of(array.get(), array.get()+m, [&](int x) { return x >= array[m]; }));
+			CHECK(std::all_of(array.get()+m, array.get()+N, [&](int x) { return x <= array[m]; }));
+		}
+	}
+
+	for (int N : {100, 1000, 100000})
+		test_adversarial(N);
+	test_nth_elements(1000);
+	test_nth_elements(100000);
+
 	return test_result();
 }
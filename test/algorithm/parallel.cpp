@@ -0,0 +1,223 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct rec {
+		int key;
+		int seq;
+	};
+
+	std::vector<int> random_ints(int n, int range)
+	{
+		std::vector<int> v(n);
+		for (auto& x : v) x = static_cast<int>(gen() % range);
+		return v;
+	}
+
+	void test_elementwise(int n)
+	{
+		auto v = random_ints(n, 1000);
+		std::vector<int> out(n);
+
+		std::atomic<long> sum{0};
+		CHECK(stl2::for_each(stl2::ext::par, v, [&](int x) { sum += x; }) == v.end());
+		CHECK(sum.load() == std::accumulate(v.begin(), v.end(), 0L));
+
+		auto t = stl2::transform(stl2::ext::par, v, out.begin(), [](int x) { return 2 * x; });
+		CHECK(t.in() == v.end());
+		CHECK(t.out() == out.end());
+		CHECK(std::equal(v.begin(), v.end(), out.begin(),
+			[](int x, int y) { return y == 2 * x; }));
+
+		std::vector<int> sums(n);
+		stl2::transform(stl2::ext::par_unseq, v, out, sums.begin(), std::plus<>{});
+		CHECK(std::equal(v.begin(), v.end(), sums.begin(),
+			[](int x, int y) { return y == 3 * x; }));
+
+		CHECK(stl2::copy(stl2::ext::par, v, out.begin()).out() == out.end());
+		CHECK(out == v);
+
+		CHECK(stl2::fill(stl2::ext::par, out, 42) == out.end());
+		CHECK(std::count(out.begin(), out.end(), 42) == n);
+
+		auto odd = [](int x) { return x % 2 != 0; };
+		CHECK(stl2::count_if(stl2::ext::par, v, odd) ==
+			std::count_if(v.begin(), v.end(), odd));
+	}
+
+	void test_search(int n)
+	{
+		std::vector<int> v(n, 1);
+		auto is0 = [](int x) { return x == 0; };
+		CHECK(stl2::find_if(stl2::ext::par, v, is0) == v.end());
+		CHECK(stl2::all_of(stl2::ext::par, v, [](int x) { return x == 1; }));
+		CHECK(!stl2::any_of(stl2::ext::par, v, is0));
+		CHECK(stl2::none_of(stl2::ext::par, v, is0));
+		if (n == 0) return;
+
+		// The first match wins, wherever the other matches are.
+		for (int i : {n - 1, n / 2, n / 3, 0}) {
+			v[i] = 0;
+			CHECK(stl2::find_if(stl2::ext::par, v.begin(), v.end(), is0) == v.begin() + i);
+			CHECK(stl2::any_of(stl2::ext::par, v, is0));
+			CHECK(!stl2::none_of(stl2::ext::par, v, is0));
+			CHECK(!stl2::all_of(stl2::ext::par, v, [](int x) { return x == 1; }));
+		}
+	}
+
+	void test_sort(int n)
+	{
+		auto v = random_ints(n, 1 << 30);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		auto w = v;
+		CHECK(stl2::sort(stl2::ext::par, w) == w.end());
+		CHECK(w == expected);
+
+		std::vector<rec> r(n);
+		for (int i = 0; i < n; ++i) r[i] = {static_cast<int>(gen() % 100), i};
+		auto er = r;
+		std::stable_sort(er.begin(), er.end(),
+			[](const rec& x, const rec& y) { return x.key > y.key; });
+		stl2::stable_sort(stl2::ext::par, r, stl2::greater<>{}, &rec::key);
+		CHECK(std::equal(r.begin(), r.end(), er.begin(),
+			[](const rec& x, const rec& y) { return x.seq == y.seq; }));
+
+		// Move-only elements
+		std::vector<std::unique_ptr<int>> p;
+		for (int x : v) p.push_back(std::make_unique<int>(x));
+		stl2::sort(stl2::ext::par, p, stl2::less<>{}, [](const auto& x) { return *x; });
+		CHECK(std::is_sorted(p.begin(), p.end(),
+			[](const auto& x, const auto& y) { return *x < *y; }));
+	}
+
+	void test_merge(int n)
+	{
+		std::vector<rec> a(n), b(n / 3);
+		for (int i = 0; i < n; ++i) a[i] = {static_cast<int>(gen() % 50), i};
+		for (int i = 0; i < n / 3; ++i) b[i] = {static_cast<int>(gen() % 50), n + i};
+		auto by_key = [](const rec& x, const rec& y) { return x.key < y.key; };
+		auto same = [](const rec& x, const rec& y) { return x.seq == y.seq; };
+		std::stable_sort(a.begin(), a.end(), by_key);
+		std::stable_sort(b.begin(), b.end(), by_key);
+
+		std::vector<rec> expected, out(a.size() + b.size());
+		std::merge(a.begin(), a.end(), b.begin(), b.end(),
+			std::back_inserter(expected), by_key);
+		auto m = stl2::merge(stl2::ext::par, a, b, out.begin(), stl2::less<>{},
+			&rec::key, &rec::key);
+		CHECK(m.in1() == a.end());
+		CHECK(m.in2() == b.end());
+		CHECK(m.out() == out.end());
+		CHECK(std::equal(out.begin(), out.end(), expected.begin(), same));
+
+		auto c = a;
+		c.insert(c.end(), b.begin(), b.end());
+		CHECK(stl2::inplace_merge(stl2::ext::par, c, c.begin() + n,
+			stl2::less<>{}, &rec::key) == c.end());
+		CHECK(std::equal(c.begin(), c.end(), expected.begin(), same));
+	}
+
+	void test_partition(int n)
+	{
+		for (int range : {2, 7, 1000}) {
+			auto v = random_ints(n, range);
+			auto w = v;
+			auto small = [=](int x) { return x < range / 2; };
+			auto split = stl2::partition(stl2::ext::par, w, small) - w.begin();
+			CHECK(split == std::count_if(v.begin(), v.end(), small));
+			CHECK(std::is_partitioned(w.begin(), w.end(), small));
+			CHECK(std::is_permutation(v.begin(), v.end(), w.begin()));
+		}
+
+		// Inputs with nothing to swap, or with chunks that have no
+		// misplaced elements on one side of the partition point.
+		auto odd = [](int x) { return x % 2 != 0; };
+		auto check = [&](std::vector<int> v) {
+			auto w = v;
+			auto split = stl2::partition(stl2::ext::par, w, odd) - w.begin();
+			CHECK(split == std::count_if(v.begin(), v.end(), odd));
+			CHECK(std::is_partitioned(w.begin(), w.end(), odd));
+			CHECK(std::is_permutation(v.begin(), v.end(), w.begin()));
+		};
+		check(std::vector<int>(n, 1));
+		check(std::vector<int>(n, 0));
+		std::vector<int> v(n, 0);
+		std::fill(v.begin(), v.begin() + n / 3, 1);
+		check(v);
+		// Falses at both ends around a block of trues: the chunks inside
+		// the block are all true, left of the partition point.
+		std::fill(v.begin(), v.end(), 0);
+		std::fill(v.begin() + n / 8, v.begin() + 7 * n / 8, 1);
+		check(v);
+		// Alternating.
+		for (int i = 0; i < n; ++i) {
+			v[i] = i % 2;
+		}
+		check(v);
+	}
+
+	void test_exceptions()
+	{
+		std::vector<int> v(1 << 18, 1);
+		v[v.size() / 2] = 0;
+		bool caught = false;
+		try {
+			stl2::for_each(stl2::ext::par, v, [](int x) {
+				if (x == 0) throw std::runtime_error{"zero"};
+			});
+		} catch (const std::runtime_error&) {
+			caught = true;
+		}
+		CHECK(caught);
+
+		caught = false;
+		try {
+			stl2::sort(stl2::ext::par, v, [](int x, int y) {
+				if (x == 0 || y == 0) throw std::runtime_error{"zero"};
+				return x < y;
+			});
+		} catch (const std::runtime_error&) {
+			caught = true;
+		}
+		CHECK(caught);
+	}
+}
+
+int main()
+{
+	static_assert(stl2::models::ExecutionPolicy<const stl2::ext::parallel_policy&>);
+	static_assert(stl2::models::ExecutionPolicy<stl2::ext::parallel_unsequenced_policy>);
+	static_assert(!stl2::models::ExecutionPolicy<int>);
+
+	for (int n : {0, 1, 1000, 100000, 1 << 20}) {
+		test_elementwise(n);
+		test_search(n);
+		test_sort(n);
+		test_merge(n);
+		test_partition(n);
+	}
+	test_exceptions();
+
+	return ::test_result();
+}
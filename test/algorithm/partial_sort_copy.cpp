@@ -113,6 +113,30 @@ struct U
     }
 };
 
+void
+test_top_k(int N, int K)
+{
+    // Trending down: every element passes the threshold.
+    std::vector<int> input(N);
+    for (int i = 0; i < N; ++i)
+        input[i] = (N - i) / 3;
+    std::vector<int> expected(std::min(N, K));
+    std::partial_sort_copy(input.begin(), input.end(), expected.begin(), expected.end());
+    std::vector<int> output(K);
+    using I = input_iterator<const int*>;
+    int* r = stl2::ext::top_k(I(input.data()), I(input.data() + N),
+        output.data(), output.data() + K);
+    CHECK(r == output.data() + std::min(N, K));
+    CHECK(std::equal(expected.begin(), expected.end(), output.data()));
+
+    std::shuffle(input.begin(), input.end(), gen);
+    std::partial_sort_copy(input.begin(), input.end(), expected.begin(), expected.end(),
+        std::greater<int>());
+    auto r2 = stl2::ext::top_k(input, output, std::greater<int>());
+    CHECK(r2 == output.begin() + std::min(N, K));
+    CHECK(std::equal(expected.begin(), expected.end(), output.begin()));
+}
+
 int main()
 {
     int i = 0;
@@ -125,6 +149,12 @@ int main()
     test<random_access_iterator<const int*> >();
     test<const int*>();
 
+    test_top_k(0, 10);
+    test_top_k(5, 10);
+    test_top_k(1000, 1);
+    test_top_k(1000, 7);
+    test_top_k(100000, 1000);
+
     // Check projections
     {
         constexpr int N = 256;
@@ -23,8 +23,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/partition.hpp>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -177,6 +180,38 @@ struct S
 	int i;
 };
 
+// Ranges spanning several partition blocks
+void
+test_large(int N)
+{
+	std::mt19937 gen;
+	std::vector<int> v(N);
+	for (int i = 0; i < N; ++i)
+		v[i] = i;
+	for (int k : {0, 1, 3, N / 3, N / 2, N - 1, N}) {
+		auto pred = [k](int i) { return i < k; };
+		std::shuffle(v.begin(), v.end(), gen);
+		int* r = stl2::partition(v.data(), v.data() + N, pred);
+		CHECK(r == v.data() + k);
+		CHECK(std::all_of(v.data(), r, pred));
+		CHECK(std::none_of(r, v.data() + N, pred));
+		// Sorted and reverse-sorted input
+		std::sort(v.begin(), v.end(), std::greater<int>{});
+		r = stl2::partition(v.data(), v.data() + N, pred);
+		CHECK(r == v.data() + k);
+		CHECK(std::all_of(v.data(), r, pred));
+		CHECK(std::none_of(r, v.data() + N, pred));
+	}
+	std::vector<double> d(N);
+	for (int i = 0; i < N; ++i)
+		d[i] = (i % 7) * 0.5;
+	auto is_small = [](double x) { return x < 1.25; };
+	double* r = stl2::partition(d.data(), d.data() + N, is_small);
+	CHECK(std::all_of(d.data(), r, is_small));
+	CHECK(std::none_of(r, d.data() + N, is_small));
+	CHECK(std::count_if(d.begin(), d.end(), is_small) == r - d.data());
+}
+
 int main()
 {
 	test_iter<forward_iterator<int*> >();
@@ -213,5 +248,11 @@ int main()
 	for (S* i = r2.get_unsafe(); i < ia+sa; ++i)
 		CHECK(!is_odd()(i->i));
 
+	test_large(63);
+	test_large(64);
+	test_large(129);
+	test_large(1000);
+	test_large(4099);
+
 	return ::test_result();
 }
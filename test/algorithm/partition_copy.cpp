@@ -25,6 +25,8 @@
 #include <stl2/detail/algorithm/partition_copy.hpp>
 #include <stl2/iterator.hpp>
 #include <tuple>
+#include <vector>
+#include <stl2/detail/algorithm/equal.hpp>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -141,5 +143,22 @@ int main()
 	test_proj();
 	test_rvalue();
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto const ia) {
+		using T = typename decltype(ia)::value_type;
+		auto const x = static_cast<T>(1);
+		auto const n = ia.size();
+		std::vector<T> r1(n + 1, T(42)), r2(n + 1, T(42));
+		std::vector<T> e1(n + 1, T(42)), e2(n + 1, T(42));
+		auto p = stl2::partition_copy(ia, r1.begin(), r2.begin(), stl2::ext::less_than<T>{x});
+		auto q = stl2::partition_copy(ia, e1.begin(), e2.begin(), [x](T v) { return v < x; });
+		CHECK(std::get<0>(p) == ia.end());
+		auto const m1 = std::get<1>(q) - e1.begin();
+		auto const m2 = std::get<2>(q) - e2.begin();
+		CHECK(std::get<1>(p) == r1.begin() + m1);
+		CHECK(std::get<2>(p) == r2.begin() + m2);
+		CHECK(r1 == e1);
+		CHECK(r2 == e2);
+	});
+
 	return ::test_result();
 }
@@ -23,6 +23,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/pop_heap.hpp>
+#include <stl2/detail/algorithm/is_heap.hpp>
+#include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/push_heap.hpp>
 #include <memory>
 #include <random>
 #include <algorithm>
@@ -248,6 +251,59 @@ void test_10(int N)
 	delete [] ib;
 }
 
+template <int D>
+void test_dary(int N)
+{
+	std::unique_ptr<int[]> ia{new int[N]};
+	for (int i = 0; i < N; ++i)
+		ia[i] = i / 2;
+	std::shuffle(ia.get(), ia.get()+N, gen);
+	CHECK(stl2::ext::make_heap<D>(ia.get(), ia.get()+N) == ia.get()+N);
+	CHECK(stl2::ext::is_heap<D>(ia.get(), ia.get()+N));
+	for (int i = N; i > 0; --i)
+	{
+		CHECK(stl2::ext::pop_heap<D>(ia.get(), ia.get()+i) == ia.get()+i);
+		CHECK(ia[i-1] == (i-1) / 2);
+		CHECK(stl2::ext::is_heap<D>(ia.get(), ia.get()+i-1));
+	}
+
+	// push one at a time, then pop with a projection
+	std::unique_ptr<S[]> ib{new S[N]};
+	for (int i = 0; i < N; ++i)
+		ib[i].i = N - 1 - i;
+	std::shuffle(ib.get(), ib.get()+N, gen);
+	for (int i = 1; i <= N; ++i)
+	{
+		CHECK(stl2::ext::push_heap<D>(ib.get(), ib.get()+i, std::greater<int>(), &S::i) == ib.get()+i);
+		CHECK(stl2::ext::is_heap<D>(ib.get(), ib.get()+i, std::greater<int>(), &S::i));
+	}
+	for (int i = N; i > 0; --i)
+	{
+		CHECK(stl2::ext::pop_heap<D>(::as_lvalue(stl2::ext::make_range(ib.get(), ib.get()+i)),
+			std::greater<int>(), &S::i) == ib.get()+i);
+		CHECK(ib[i-1].i == N - i);
+	}
+}
+
+void test_comparisons(int N)
+{
+	// Bottom-up sifting: about log2(N) comparisons per pop, not 2 log2(N).
+	std::unique_ptr<int[]> ia{new int[N]};
+	for (int i = 0; i < N; ++i)
+		ia[i] = i;
+	std::shuffle(ia.get(), ia.get()+N, gen);
+	std::make_heap(ia.get(), ia.get()+N);
+	long comparisons = 0;
+	auto const comp = [&](int x, int y) { ++comparisons; return x < y; };
+	for (int i = N; i > 0; --i)
+		stl2::pop_heap(ia.get(), ia.get()+i, comp);
+	CHECK(std::is_sorted(ia.get(), ia.get()+N));
+	int log2 = 0;
+	while ((1 << log2) < N)
+		++log2;
+	CHECK(comparisons < long(N) * (log2 + 2));
+}
+
 int main()
 {
 	test_1(1000);
@@ -260,6 +316,11 @@ int main()
 	test_8(1000);
 	test_9(1000);
 	test_10(1000);
+	test_dary<2>(1000);
+	test_dary<3>(1000);
+	test_dary<4>(1000);
+	test_dary<8>(1001);
+	test_comparisons(1 << 14);
 
 	return test_result();
 }
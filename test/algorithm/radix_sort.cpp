@@ -0,0 +1,213 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct rec {
+		long key;
+		int seq;
+	};
+
+	struct frec {
+		double key;
+		int seq;
+	};
+
+#ifdef __cpp_lib_byte
+	struct brec {
+		std::vector<std::byte> key;
+		int seq;
+	};
+#endif
+
+	template <class T>
+	void test_integral(int n)
+	{
+		std::uniform_int_distribution<long long> dist(
+			std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(dist(gen));
+		if (n > 2) {
+			v[0] = std::numeric_limits<T>::max();
+			v[1] = std::numeric_limits<T>::min();
+		}
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		auto w = v;
+		CHECK(stl2::ext::radix_sort(w.data(), w.data() + n) == w.data() + n);
+		CHECK(w == expected);
+
+		std::sort(expected.begin(), expected.end(), std::greater<>{});
+		w = v;
+		stl2::ext::radix_sort(w, stl2::greater<>{});
+		CHECK(w == expected);
+	}
+
+	void test_records(int n, int distinct)
+	{
+		std::vector<rec> v(n);
+		for (int i = 0; i < n; ++i)
+			v[i] = {static_cast<long>(gen() % distinct) - distinct / 2, i};
+		auto expected = v;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const rec& x, const rec& y) { return x.key < y.key; });
+		auto check = [&](const std::vector<rec>& w) {
+			CHECK(std::equal(w.begin(), w.end(), expected.begin(),
+				[](const rec& x, const rec& y) { return x.key == y.key && x.seq == y.seq; }));
+		};
+
+		auto w = v;
+		stl2::ext::radix_sort(w.data(), w.data() + n, stl2::less<>{}, &rec::key);
+		check(w);
+		w = v;
+		stl2::stable_sort(w, stl2::less<>{}, &rec::key);
+		check(w);
+		w = v;
+		stl2::sort(w, stl2::less<>{}, &rec::key);
+		CHECK(std::is_sorted(w.begin(), w.end(),
+			[](const rec& x, const rec& y) { return x.key < y.key; }));
+	}
+
+	void test_floating(int n)
+	{
+		std::normal_distribution<double> dist(0.0, 1e6);
+		std::vector<frec> v(n);
+		for (int i = 0; i < n; ++i) {
+			double d = dist(gen);
+			switch (i % 10) {
+			case 0: d = 0.0; break;
+			case 1: d = -0.0; break;
+			case 2: d = std::numeric_limits<double>::infinity(); break;
+			case 3: d = -std::numeric_limits<double>::infinity(); break;
+			case 4: d = std::numeric_limits<double>::denorm_min(); break;
+			case 5: d = -std::numeric_limits<double>::denorm_min(); break;
+			}
+			v[i] = {d, i};
+		}
+		// Equivalent keys, including zeros of either sign, keep their order.
+		auto expected = v;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const frec& x, const frec& y) { return x.key < y.key; });
+		auto w = v;
+		stl2::ext::radix_sort(w, stl2::less<>{}, &frec::key);
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(),
+			[](const frec& x, const frec& y) {
+				return x.seq == y.seq && std::signbit(x.key) == std::signbit(y.key);
+			}));
+
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const frec& x, const frec& y) { return x.key > y.key; });
+		w = v;
+		stl2::stable_sort(w, std::greater<>{}, &frec::key);
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(),
+			[](const frec& x, const frec& y) { return x.seq == y.seq; }));
+
+		std::vector<float> f(n);
+		for (auto& x : f) x = static_cast<float>(dist(gen));
+		auto ef = f;
+		std::sort(ef.begin(), ef.end());
+		stl2::ext::radix_sort(f);
+		CHECK(f == ef);
+	}
+
+#ifdef __cpp_lib_byte
+	void test_bytes(int n)
+	{
+		std::vector<brec> v(n);
+		for (int i = 0; i < n; ++i) {
+			// Short keys over a small alphabet: many shared prefixes,
+			// prefixes of one another, and duplicates.
+			v[i].key.resize(gen() % 6);
+			for (auto& b : v[i].key) b = std::byte(gen() % 3);
+			v[i].seq = i;
+		}
+		auto expected = v;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const brec& x, const brec& y) { return x.key < y.key; });
+		auto w = v;
+		stl2::ext::radix_sort(w, stl2::less<>{}, &brec::key);
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(),
+			[](const brec& x, const brec& y) { return x.seq == y.seq; }));
+		w = v;
+		stl2::stable_sort(w, stl2::less<>{}, &brec::key);
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(),
+			[](const brec& x, const brec& y) { return x.seq == y.seq; }));
+	}
+#endif
+}
+
+int main()
+{
+	static_assert(stl2::ext::RadixSortable<int*, stl2::less<>, stl2::identity>);
+	static_assert(stl2::ext::RadixSortable<rec*, stl2::greater<>, long rec::*>);
+	static_assert(!stl2::ext::RadixSortable<int*, std::less<long>, stl2::identity>);
+#ifdef __cpp_lib_byte
+	static_assert(stl2::ext::RadixSortable<std::byte*, stl2::less<>, stl2::identity>);
+	static_assert(stl2::ext::RadixSortable<brec*, stl2::less<>, std::vector<std::byte> brec::*>);
+	static_assert(!stl2::ext::RadixSortable<brec*, stl2::greater<>, std::vector<std::byte> brec::*>);
+#endif
+
+	for (int n : {0, 1, 2, 3, 100, 1000, 5000}) {
+		test_integral<int>(n);
+		test_integral<unsigned>(n);
+		test_integral<signed char>(n);
+		test_integral<std::int64_t>(n);
+		test_integral<std::uint16_t>(n);
+		test_records(n, 7);
+		test_records(n, 1 << 20);
+		test_floating(n);
+#ifdef __cpp_lib_byte
+		test_bytes(n);
+#endif
+	}
+
+	{
+		bool b[] = {true, false, true, false, false};
+		stl2::ext::radix_sort(b);
+		CHECK(std::is_sorted(b, b + 5));
+		CHECK(!b[2]);
+		CHECK(b[3]);
+	}
+
+#ifdef __cpp_lib_byte
+	{
+		std::byte y[] = {std::byte{200}, std::byte{3}, std::byte{128}, std::byte{0}};
+		stl2::ext::radix_sort(y);
+		CHECK(std::is_sorted(y, y + 4));
+	}
+#endif
+
+	{
+		// Move-only elements
+		std::vector<std::unique_ptr<int>> v;
+		for (int i = 0; i < 2000; ++i)
+			v.push_back(std::make_unique<int>(static_cast<int>(gen() % 100)));
+		stl2::ext::radix_sort(v, stl2::less<>{}, [](const std::unique_ptr<int>& p) { return *p; });
+		CHECK(std::is_sorted(v.begin(), v.end(),
+			[](const auto& x, const auto& y) { return *x < *y; }));
+	}
+
+	return ::test_result();
+}
@@ -23,8 +23,12 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/remove.hpp>
+#include <stl2/detail/algorithm/remove_if.hpp>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <stl2/detail/algorithm/equal.hpp>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -171,5 +175,44 @@ int main()
 	CHECK(ia2[4].i == 3);
 	CHECK(ia2[5].i == 4);
 
+	test_vectorized<int, unsigned, long long>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		auto b = a;
+		auto r = stl2::remove(a, T(3));
+		auto s = stl2::remove_if(b, [](T e) { return e == T(3); });
+		auto const m = s - b.begin();
+		CHECK(r == a.begin() + m);
+		CHECK(stl2::equal(a.begin(), r, b.begin(), s));
+		// A value that isn't representable removes nothing.
+		r = stl2::remove(a, 3ll << 40);
+		CHECK(r == a.end());
+	});
+
+	// Values compare as == does, not as they convert to the elements:
+	// -1ll is no unsigned, 1ll << 40 would truncate to 0, and (1ll << 32) - 1
+	// is ~0u. (A std::uint64_t against a signed value would trip
+	// -Wsign-compare in equal_to<> itself.)
+	test_vectorized<unsigned>([](auto a) {
+		auto b = a;
+		CHECK(stl2::remove(a, -1ll) == a.end());
+		CHECK(stl2::remove(a, 1ll << 40) == a.end());
+		auto r = stl2::remove(a, (1ll << 32) - 1);
+		auto s = stl2::remove(b, ~0u);
+		auto const m = s - b.begin();
+		CHECK(r == a.begin() + m);
+		CHECK(stl2::equal(a.begin(), r, b.begin(), s));
+	});
+	// Both sides promote to int.
+	test_vectorized<std::uint16_t>([](auto a) {
+		auto b = a;
+		CHECK(stl2::remove(a, -1) == a.end());
+		CHECK(stl2::remove(a, 1 << 20) == a.end());
+		auto r = stl2::remove(a, 0xffff);
+		auto s = stl2::remove_if(b, [](std::uint16_t e) { return e == 0xffff; });
+		auto const m = s - b.begin();
+		CHECK(r == a.begin() + m);
+		CHECK(stl2::equal(a.begin(), r, b.begin(), s));
+	});
+
 	return ::test_result();
 }
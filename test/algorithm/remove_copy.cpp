@@ -23,8 +23,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/remove_copy.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -168,5 +171,34 @@ int main()
 		CHECK(ib[5].i == 4);
 	}
 
+	// Values compare as == does, not as they convert to the elements:
+	// -1ll is no unsigned, 1ll << 40 would truncate to 0, and (1ll << 32) - 1
+	// is ~0u.
+	test_vectorized<unsigned>([](auto const a) {
+		std::vector<unsigned> out(a.size()), expected(a.size());
+		CHECK(stl2::remove_copy(a, out.begin(), -1ll).out() == out.end());
+		CHECK(out == a);
+		CHECK(stl2::remove_copy(a, out.begin(), 1ll << 40).out() == out.end());
+		CHECK(out == a);
+		auto r = stl2::remove_copy(a, out.begin(), (1ll << 32) - 1);
+		auto e = std::remove_copy(a.begin(), a.end(), expected.begin(), ~0u);
+		auto const m = e - expected.begin();
+		CHECK(r.out() == out.begin() + m);
+		CHECK(std::equal(out.begin(), r.out(), expected.begin()));
+	});
+	// Both sides promote to int.
+	test_vectorized<std::uint16_t>([](auto const a) {
+		std::vector<std::uint16_t> out(a.size()), expected(a.size());
+		CHECK(stl2::remove_copy(a, out.begin(), -1).out() == out.end());
+		CHECK(out == a);
+		CHECK(stl2::remove_copy(a, out.begin(), 1 << 20).out() == out.end());
+		CHECK(out == a);
+		auto r = stl2::remove_copy(a, out.begin(), 0xffff);
+		auto e = std::remove_copy(a.begin(), a.end(), expected.begin(), std::uint16_t{0xffff});
+		auto const m = e - expected.begin();
+		CHECK(r.out() == out.begin() + m);
+		CHECK(std::equal(out.begin(), r.out(), expected.begin()));
+	});
+
 	return ::test_result();
 }
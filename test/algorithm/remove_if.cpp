@@ -27,6 +27,8 @@
 #include <memory>
 #include <utility>
 #include <functional>
+#include <vector>
+#include <stl2/detail/algorithm/equal.hpp>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -191,5 +193,22 @@ int main()
 		CHECK(ia[5].i == 4);
 	}
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		auto b = a;
+		auto const x = static_cast<T>(2);
+		auto r = stl2::remove_if(a, stl2::ext::less_than<T>{x});
+		auto s = stl2::remove_if(b, [x](T e) { return e < x; });
+		auto const m = s - b.begin();
+		CHECK(r == a.begin() + m);
+		CHECK(stl2::equal(a.begin(), r, b.begin(), s));
+
+		a = b = std::vector<T>(a.size(), x);
+		r = stl2::remove_if(a, stl2::ext::not_equal_to_value<T>{x});
+		CHECK(r == a.end());
+		r = stl2::remove_if(a, stl2::ext::equal_to_value<T>{x});
+		CHECK(r == a.begin());
+	});
+
 	return ::test_result();
 }
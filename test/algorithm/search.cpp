@@ -23,7 +23,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/search.hpp>
+#include <algorithm>
 #include <initializer_list>
+#include <vector>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include "../simple_test.hpp"
@@ -150,6 +152,88 @@ test()
 	test_range<Iter1, Iter2>();
 }
 
+// The searchers and the byte kernel against std::search, for texts over
+// small alphabets where patterns overlap themselves a lot.
+template <class V>
+void test_searchers()
+{
+	unsigned seed = 1;
+	auto random = [&seed](unsigned n) {
+		seed = seed * 1103515245u + 12345u;
+		return (seed >> 16) % n;
+	};
+	for (unsigned alphabet = 1; alphabet <= 4; ++alphabet) {
+		for (int round = 0; round < 40; ++round) {
+			std::vector<V> text(random(200));
+			for (auto& v : text) {
+				v = static_cast<V>('a' + random(alphabet));
+			}
+			for (std::size_t m = 0; m <= 24; ++m) {
+				std::vector<V> pattern(m);
+				if (m <= text.size() && random(2)) {
+					auto const pos = random(unsigned(text.size() - m + 1));
+					std::copy(text.begin() + pos, text.begin() + pos + m, pattern.begin());
+				} else {
+					for (auto& v : pattern) {
+						v = static_cast<V>('a' + random(alphabet));
+					}
+				}
+				auto const expected = std::search(text.begin(), text.end(),
+					pattern.begin(), pattern.end());
+
+				CHECK(stl2::search(text, pattern) == expected);
+				auto bm = stl2::ext::make_boyer_moore_searcher(pattern);
+				CHECK(stl2::search(text, bm) == expected);
+				auto bmh = stl2::ext::make_boyer_moore_horspool_searcher(pattern);
+				CHECK(stl2::search(text, bmh) == expected);
+				auto tw = stl2::ext::make_two_way_searcher(pattern);
+				CHECK(stl2::search(text, tw) == expected);
+
+				auto match = bm(text.begin(), text.end());
+				CHECK(match.begin() == expected);
+				if (expected != text.end() || m == 0) {
+					CHECK(match.end() == expected + m);
+				} else {
+					CHECK(match.end() == text.end());
+				}
+			}
+		}
+	}
+}
+
+void test_searcher_iterators()
+{
+	char const text[] = "here is a simple example";
+	char const pattern[] = "example";
+	auto const tw = stl2::ext::two_way_searcher<const char*>{pattern, pattern + 7};
+	CHECK(stl2::search(text, text + 24, tw) == text + 17);
+	auto const bmh = stl2::ext::boyer_moore_horspool_searcher<const char*>{
+		pattern, pattern + 3};
+	CHECK(stl2::search(text, text + 24, bmh) == text + 17);
+	CHECK(stl2::search(text, text + 16, bmh) == text + 16);
+
+	// A predicate other than equal_to<> hashes through the map table.
+	auto const upper = [](char c) { return c >= 'a' && c <= 'z' ? char(c - 32) : c; };
+	auto hash = [upper](char c) { return std::hash<char>{}(upper(c)); };
+	auto pred = [upper](char a, char b) { return upper(a) == upper(b); };
+	char const shout[] = "SIMPLE";
+	auto const bm = stl2::ext::boyer_moore_searcher<const char*,
+		decltype(hash), decltype(pred)>{shout, shout + 6, hash, pred};
+	CHECK(stl2::search(text, text + 24, bm) == text + 10);
+
+	CHECK(stl2::models::Searcher<decltype(bm), const char*, const char*>);
+	CHECK(!stl2::models::Searcher<decltype(bm), const int*, const int*>);
+
+	// Const searchers call comparisons that are not const.
+	struct counting_less {
+		int calls = 0;
+		bool operator()(char a, char b) { ++calls; return a < b; }
+	};
+	auto const ctw = stl2::ext::two_way_searcher<const char*, counting_less>{
+		pattern, pattern + 7};
+	CHECK(stl2::search(text, text + 24, ctw) == text + 17);
+}
+
 struct S
 {
 	int i;
@@ -197,6 +281,10 @@ int main()
 		CHECK(it.count() == 0);
 	}
 
+	test_searchers<char>();
+	test_searchers<int>();
+	test_searcher_iterators();
+
 	// Test rvalue ranges
 	{
 		int ib[] = {0, 1, 2, 0, 1, 2, 3, 0, 1, 2, 3, 4};
@@ -12,6 +12,9 @@
 
 #include "set_symmetric_difference.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 int main()
 {
@@ -59,5 +62,31 @@ int main()
 		CHECK(stl2::lexicographical_compare(ic, std::get<2>(res2), ir, ir+sr, std::less<int>(), &U::k) == 0);
 	}
 
+	// Test galloping on skewed inputs
+	{
+		std::vector<int> big;
+		for (int i = 0; i < 10000; ++i) {
+			big.push_back(3 * i);
+			if (i % 100 == 0) {
+				big.push_back(3 * i);
+			}
+		}
+		std::vector<int> const small = {-1, 5, 6, 300, 301, 9000, 9000, 9000, 29997, 40000};
+		int comparisons = 0;
+		auto const less = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+		for (int pass = 0; pass < 2; ++pass) {
+			auto const& a = pass ? big : small;
+			auto const& b = pass ? small : big;
+			std::vector<int> expected;
+			std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+			std::vector<int> actual(a.size() + b.size());
+			comparisons = 0;
+			auto const end = stl2::set_symmetric_difference(a, b, actual.begin(), less).out();
+			actual.erase(end, actual.end());
+			CHECK(actual == expected);
+			CHECK(comparisons < 1000);
+		}
+	}
+
 	return ::test_result();
 }
@@ -163,6 +163,16 @@ test_larger_sorts(int N, int M)
 	std::swap_ranges(array, array+N/2, array+N/2);
 	CHECK(stl2::sort(array, array+N) == array+N);
 	CHECK(std::is_sorted(array, array+N));
+	// test organ pipe pattern
+	for (int i = 0; i < N; ++i)
+		array[i] = i < N/2 ? i : N - i;
+	CHECK(stl2::sort(array, array+N) == array+N);
+	CHECK(std::is_sorted(array, array+N));
+	// test sorted pattern with a few elements out of place
+	for (int i = 0; i < N; i += 7)
+		std::swap(array[i], array[N - 1 - i]);
+	CHECK(stl2::sort(array, array+N) == array+N);
+	CHECK(std::is_sorted(array, array+N));
 	delete [] array;
 }
 
@@ -251,6 +261,7 @@ int main()
 	test_larger_sorts(997);
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
+	test_larger_sorts(10007);
 
 	// Check move-only types
 	{
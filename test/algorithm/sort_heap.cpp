@@ -23,6 +23,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/sort_heap.hpp>
+#include <stl2/detail/algorithm/make_heap.hpp>
 #include <memory>
 #include <random>
 #include <algorithm>
@@ -189,6 +190,24 @@ void test(int N)
 	test_8(N);
 }
 
+template <int D>
+void test_dary(int N)
+{
+	std::unique_ptr<int[]> ia{new int[N]};
+	for (int i = 0; i < N; ++i)
+		ia[i] = i % 17;
+	std::shuffle(ia.get(), ia.get()+N, gen);
+	stl2::ext::make_heap<D>(ia.get(), ia.get()+N);
+	CHECK(stl2::ext::sort_heap<D>(ia.get(), ia.get()+N) == ia.get()+N);
+	CHECK(std::is_sorted(ia.get(), ia.get()+N));
+
+	std::shuffle(ia.get(), ia.get()+N, gen);
+	auto rng = stl2::ext::make_range(ia.get(), ia.get()+N);
+	stl2::ext::make_heap<D>(rng, std::greater<int>());
+	CHECK(stl2::ext::sort_heap<D>(rng, std::greater<int>()) == ia.get()+N);
+	CHECK(std::is_sorted(ia.get(), ia.get()+N, std::greater<int>()));
+}
+
 int main()
 {
 	test(0);
@@ -199,6 +218,9 @@ int main()
 	test(1000);
 	test_9(1000);
 	test_10(1000);
+	test_dary<4>(1);
+	test_dary<4>(1000);
+	test_dary<8>(1000);
 
 	return test_result();
 }
@@ -165,6 +165,73 @@ struct S
 	int i, j;
 };
 
+// Stability and comparison counts on the patterns natural runs are for.
+void test_runs(int N)
+{
+	int comparisons = 0;
+	auto const less = [&comparisons](const S& x, const S& y) {
+		++comparisons;
+		return x.i < y.i;
+	};
+	auto const check = [N](const std::vector<S>& v) {
+		for (int k = 1; k < N; ++k) {
+			CHECK(v[k - 1].i <= v[k].i);
+			if (v[k - 1].i == v[k].i) {
+				CHECK(v[k - 1].j < v[k].j);
+			}
+		}
+	};
+	auto const number = [](std::vector<S>& v) {
+		for (std::size_t k = 0; k < v.size(); ++k) {
+			v[k].j = static_cast<int>(k);
+		}
+	};
+	std::vector<S> v(N);
+
+	// Already sorted, and strictly descending: one run each.
+	for (int k = 0; k < N; ++k) {
+		v[k].i = k / 3;
+	}
+	number(v);
+	comparisons = 0;
+	stl2::stable_sort(v, less);
+	check(v);
+	CHECK(comparisons < N);
+	for (int k = 0; k < N; ++k) {
+		v[k].i = N - k;
+	}
+	number(v);
+	comparisons = 0;
+	stl2::stable_sort(v, less);
+	check(v);
+	CHECK(comparisons < N);
+
+	// Four sorted blocks, each long enough to be a natural run: linear,
+	// not n log n.
+	for (int k = 0; k < N; ++k) {
+		v[k].i = (k * 4 / N) % 2 ? k % (N / 4) : N - k % (N / 4);
+	}
+	for (int b = 0; b < 4; ++b) {
+		std::sort(v.begin() + b * N / 4, v.begin() + (b + 1) * N / 4,
+			[](const S& x, const S& y) { return x.i < y.i; });
+	}
+	number(v);
+	comparisons = 0;
+	stl2::stable_sort(v, less);
+	check(v);
+	if (N >= 4 * 64) {
+		CHECK(comparisons < 4 * N);
+	}
+
+	// Random with many equal keys
+	for (int k = 0; k < N; ++k) {
+		v[k].i = static_cast<int>(gen() % 50);
+	}
+	number(v);
+	stl2::stable_sort(v, less);
+	check(v);
+}
+
 int main()
 {
 	// test null range
@@ -192,6 +259,10 @@ int main()
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
 
+	test_runs(100);
+	test_runs(1000);
+	test_runs(100000);
+
 	// Check move-only types
 	{
 		std::vector<std::unique_ptr<int> > v(1000);
@@ -11,6 +11,9 @@
 //
 #include <stl2/detail/algorithm/transform.hpp>
 
+#include <sstream>
+#include <string>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -49,5 +52,28 @@ int main() {
 		}
 	}
 
+	{
+		// Characters are gathered into blocks for an ostreambuf_iterator.
+		std::vector<int> v;
+		for (int i = 0; i < 1000; ++i) {
+			v.push_back(i % 10);
+		}
+		std::ostringstream os;
+		auto result = ranges::transform(v, ranges::ostreambuf_iterator<char>{os},
+			[](int i) { return char('0' + i); });
+		CHECK(result.in() == v.end());
+		CHECK(result.out() != ranges::default_sentinel{});
+		CHECK(os.str().size() == 1000u);
+		CHECK(os.str().substr(990) == "0123456789");
+
+		// What was made before an exception is still written.
+		std::ostringstream os2;
+		try {
+			ranges::transform(v, ranges::ostreambuf_iterator<char>{os2},
+				[](int i) { if (i == 9) throw i; return char('0' + i); });
+		} catch (int) {}
+		CHECK(os2.str() == "012345678");
+	}
+
 	return ::test_result();
 }
@@ -26,6 +26,8 @@
 //   http://http://libcxx.llvm.org/
 
 #include <stl2/detail/algorithm/unique.hpp>
+#include <vector>
+#include <stl2/detail/algorithm/equal.hpp>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -156,5 +158,19 @@ int main()
 		CHECK(a[2] == 2);
 	}
 
+	test_vectorized<int, unsigned, long long, float, double>([](auto a) {
+		using T = typename decltype(a)::value_type;
+		// Runs of equal values.
+		for (int i = 0; i < int(a.size()); ++i) {
+			a[i] = static_cast<T>((i * 7919) % 3 + i / 5);
+		}
+		auto b = a;
+		auto r = stl2::unique(a);
+		auto s = stl2::unique(b, [](T x, T y) { return x == y; });
+		auto const m = s - b.begin();
+		CHECK(r == a.begin() + m);
+		CHECK(stl2::equal(a.begin(), r, b.begin(), s));
+	});
+
 	return ::test_result();
 }
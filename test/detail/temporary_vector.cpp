@@ -1,4 +1,8 @@
 #include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <future>
+#include <thread>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -29,9 +33,133 @@ namespace {
 	void test_alignments() {
 		(test_single_alignment<Alignments>(), ...);
 	}
+
+	void test_arena_reuse() {
+		namespace ext = ranges::ext;
+		void* first;
+		{
+			auto buf = temporary_buffer<int>{100};
+			CHECK(buf.size() == 100);
+			first = buf.data();
+			// Nested buffers come from the same arena block.
+			auto inner = temporary_buffer<double>{10};
+			CHECK(inner.size() == 10);
+			CHECK(static_cast<void*>(inner.data()) != first);
+		}
+		auto const& stats = ext::scratch_statistics();
+		ext::scratch_statistics() = {};
+		{
+			auto buf = temporary_buffer<int>{100};
+			CHECK(static_cast<void*>(buf.data()) == first);
+			auto inner = temporary_buffer<double>{10};
+			CHECK(inner.size() == 10);
+		}
+		CHECK(stats.allocations == 2u);
+		CHECK(stats.bytes_requested == 100 * sizeof(int) + 10 * sizeof(double));
+		CHECK(stats.bytes_reused == stats.bytes_requested);
+
+		// Larger than the arena: straight from operator new.
+		ext::scratch_statistics() = {};
+		{
+			auto const n = static_cast<std::ptrdiff_t>(ext::scratch_arena_limit);
+			auto buf = temporary_buffer<char>{n + 1};
+			CHECK(buf.size() == n + 1);
+		}
+		CHECK(stats.bytes_reused == 0u);
+
+		auto moved = temporary_buffer<int>{};
+		CHECK(moved.size() == 0);
+		moved = temporary_buffer<int>{8};
+		CHECK(moved.size() == 8);
+	}
+
+	void test_cross_thread_release() {
+		// Released on another thread, the buffer still goes back to the
+		// arena it came from, which is then free for reuse.
+		void* first;
+		{
+			auto buf = temporary_buffer<int>{100};
+			first = buf.data();
+			std::thread{[b = std::move(buf)]() mutable { b = {}; }}.join();
+		}
+		{
+			auto buf = temporary_buffer<int>{100};
+			CHECK(static_cast<void*>(buf.data()) == first);
+		}
+
+		// And the other way around, while the allocating thread runs on.
+		std::promise<temporary_buffer<long>> handed;
+		std::promise<void> released;
+		std::thread t{[&] {
+			auto buf = temporary_buffer<long>{50};
+			void* const p = buf.data();
+			handed.set_value(std::move(buf));
+			released.get_future().wait();
+			auto again = temporary_buffer<long>{50};
+			CHECK(static_cast<void*>(again.data()) == p);
+		}};
+		handed.get_future().get();
+		released.set_value();
+		t.join();
+	}
+
+	struct counting_resource : ranges::ext::scratch_resource {
+		int allocations = 0;
+		int live = 0;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) noexcept override {
+			++allocations;
+			++live;
+			return ::operator new(bytes, std::align_val_t{alignment}, std::nothrow);
+		}
+		void do_deallocate(void* p, std::size_t, std::size_t alignment) noexcept override {
+			--live;
+			::operator delete(p, std::align_val_t{alignment});
+		}
+	};
+
+	struct refusing_resource : ranges::ext::scratch_resource {
+		void* do_allocate(std::size_t, std::size_t) noexcept override {
+			return nullptr;
+		}
+		void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+	};
+
+	void test_resource_hook() {
+		namespace ext = ranges::ext;
+		counting_resource counting;
+		CHECK(ext::set_scratch_resource(&counting) == ext::default_scratch_resource());
+		CHECK(ext::get_scratch_resource() == &counting);
+		auto const greater = [](int x, int y) { return x > y; };
+		int a[1000];
+		for (int i = 0; i < 1000; ++i) {
+			a[i] = (i * 7919) % 1000;
+		}
+		ranges::stable_sort(a, greater);
+		CHECK(counting.allocations > 0);
+		CHECK(counting.live == 0);
+		CHECK(ranges::is_sorted(a, greater));
+
+		// The algorithms cope with no buffer at all.
+		refusing_resource refusing;
+		ext::set_scratch_resource(&refusing);
+		{
+			auto buf = temporary_buffer<int>{16};
+			CHECK(buf.size() == 0);
+			ranges::stable_sort(a);
+			CHECK(ranges::is_sorted(a));
+			ranges::stable_sort(a, greater);
+			CHECK(ranges::is_sorted(a, greater));
+		}
+		CHECK(ext::set_scratch_resource(nullptr) == &refusing);
+		CHECK(ext::get_scratch_resource() == ext::default_scratch_resource());
+	}
 }
 
 int main() {
 	test_alignments<1, 2, 4, 8, 16, 32, 64, 128>();
+	test_arena_reuse();
+	test_cross_thread_release();
+	test_resource_hook();
 	return ::test_result();
 }
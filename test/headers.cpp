@@ -22,6 +22,7 @@
 #include <stl2/variant.hpp>
 #include <stl2/view/indirect.hpp>
 #include <stl2/view/iota.hpp>
+#include <stl2/view/mapped_file.hpp>
 #include <stl2/view/move.hpp>
 #include <stl2/view/ref.hpp>
 #include <stl2/view/repeat.hpp>
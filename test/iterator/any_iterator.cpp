@@ -56,8 +56,43 @@ void test_big() {
 	}
 }
 
+void test_storage() {
+	int rg[]{0,1,2,3,4,5,6,7,8,9};
+	using CI = stl2::counted_iterator<int*>;
+
+	// One pointer of buffer, and a plain count: the counted_iterator goes
+	// to the heap, shared by copies.
+	using Narrow = stl2::ext::any_iterator_storage<sizeof(void*), false>;
+	using AN = stl2::any_input_iterator<int&, int, int&&, Narrow>;
+	AN first{CI{rg, 10}};
+	AN const last{CI{rg + 10, 0}};
+	auto a1 = first; (void)a1;
+	int i = 0;
+	for (; first != last; ++first, ++i) {
+		CHECK(&*first == &rg[i]);
+	}
+	CHECK(i == 10);
+
+	// A wide buffer holds even the istream_iterator in place.
+	using Wide = stl2::ext::any_iterator_storage<64>;
+	using AW = stl2::any_input_iterator<std::string const &,
+		std::string, std::string const &&, Wide>;
+	static_assert(sizeof(AW) >= 64);
+	std::stringstream sin{"now is the time"};
+	using I = std::istream_iterator<std::string>;
+	AW f{I{sin}};
+	AW const l{I{}};
+	CHECK(*f == "now");
+	auto f2 = std::move(f);
+	CHECK(*f2 == "now");
+	f = stl2::next(f2, 3);
+	CHECK(*f == "time");
+	CHECK(++f == l);
+}
+
 int main() {
 	test_small();
 	test_big();
+	test_storage();
 	return ::test_result();
 }
@@ -12,7 +12,13 @@
 #include <stl2/detail/iterator/istreambuf_iterator.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/type_traits.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
 #include <sstream>
+#include <streambuf>
+#include <string>
 #include "../simple_test.hpp"
 
 using namespace __stl2;
@@ -82,6 +88,103 @@ namespace {
 	void validate() {
 		(validate_one<Cs>(), ...);
 	}
+
+	// Shows its string through a get area of at most three characters.
+	struct small_buf : std::streambuf {
+		std::string s_;
+		std::size_t pos_ = 0;
+
+		explicit small_buf(std::string s) : s_(std::move(s)) {}
+
+		int_type underflow() override {
+			if (pos_ == s_.size()) {
+				return traits_type::eof();
+			}
+			auto const n = std::min<std::size_t>(3, s_.size() - pos_);
+			char* const p = &s_[pos_];
+			setg(p, p, p + n);
+			pos_ += n;
+			return traits_type::to_int_type(*p);
+		}
+	};
+
+	// Has no get area at all.
+	struct unbuffered_buf : std::streambuf {
+		std::string s_;
+		std::size_t pos_ = 0;
+
+		explicit unbuffered_buf(std::string s) : s_(std::move(s)) {}
+
+		int_type underflow() override {
+			return pos_ == s_.size() ? traits_type::eof() :
+				traits_type::to_int_type(s_[pos_]);
+		}
+		int_type uflow() override {
+			return pos_ == s_.size() ? traits_type::eof() :
+				traits_type::to_int_type(s_[pos_++]);
+		}
+	};
+
+	template <class Buf>
+	void test_blocks() {
+		using I = istreambuf_iterator<char>;
+		static const std::string text = "The quick brown fox jumps over the lazy dog";
+		{
+			Buf buf{text};
+			std::string out;
+			auto r = __stl2::copy(I{&buf}, default_sentinel{}, back_inserter(out));
+			CHECK(r.in() == default_sentinel{});
+			CHECK(out == text);
+		}
+		{
+			Buf buf{text};
+			std::string out;
+			auto r = __stl2::copy(I{&buf}, I{}, back_inserter(out));
+			CHECK(r.in() == I{});
+			CHECK(out == text);
+		}
+		{
+			Buf buf{text};
+			auto i = __stl2::find(I{&buf}, default_sentinel{}, 'f');
+			CHECK(i != default_sentinel{});
+			CHECK(*i == 'f');
+			++i;
+			CHECK(*i == 'o');
+			i = __stl2::find(i, default_sentinel{}, 'z');
+			CHECK(*i++ == 'z');
+			CHECK(*i == 'y');
+			CHECK(__stl2::find(i, default_sentinel{}, '!') == default_sentinel{});
+		}
+		{
+			Buf buf{text};
+			auto i = __stl2::find(I{&buf}, default_sentinel{}, 'Q',
+				[](char c) { return char(c & ~0x20); });
+			CHECK(*i == 'q');
+		}
+		{
+			Buf buf{text};
+			CHECK(__stl2::count(I{&buf}, default_sentinel{}, 'o') == 4);
+			Buf buf2{text};
+			CHECK(__stl2::count(I{&buf2}, I{}, 'O',
+				[](char c) { return char(c & ~0x20); }) == 4);
+		}
+		{
+			Buf buf{text};
+			std::string out;
+			auto r = __stl2::for_each(I{&buf}, default_sentinel{},
+				[&out](char c) { out += c; });
+			CHECK(r.in() == default_sentinel{});
+			CHECK(out == text);
+		}
+		{
+			// An empty range is empty, wherever its iterators point.
+			Buf buf{text};
+			std::string out;
+			__stl2::copy(I{&buf}, I{&buf}, back_inserter(out));
+			CHECK(out.empty());
+			CHECK(__stl2::count(I{}, default_sentinel{}, 'o') == 0);
+		}
+	}
 }
 
 int main() {
@@ -116,5 +219,9 @@ int main() {
 		CHECK(*i.operator->().operator->() == '2');
 	}
 
+	test_blocks<std::stringbuf>();
+	test_blocks<small_buf>();
+	test_blocks<unbuffered_buf>();
+
 	return ::test_result();
 }
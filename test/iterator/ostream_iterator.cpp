@@ -10,6 +10,7 @@
 // Project home: https://github.com/caseycarter/cmcstl2
 //
 #include <stl2/detail/iterator/ostream_iterator.hpp>
+#include <stl2/detail/iterator/fast_ostream_iterator.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <sstream>
@@ -74,5 +75,36 @@ int main() {
 
 	ostream_iterator<std::string>{std::cout} = "Hello, World!\n";
 
+#ifdef __cpp_lib_to_chars
+	{
+		using F = ext::fast_ostream_iterator<int>;
+		static_assert(models::OutputIterator<F, const int&>);
+		static_assert(models::Same<F::ostream_type, std::ostream>);
+		std::ostringstream os;
+		::copy(__stl2::begin(some_ints), __stl2::end(some_ints), F{os, ", "});
+		CHECK(os.str() == "0, 7, 1, 6, 2, 5, 3, 4, ");
+
+		std::ostringstream bad;
+		bad.setstate(std::ios_base::badbit);
+		F{bad} = 42;
+		CHECK(bad.str().empty());
+		CHECK(bad.fail());
+	}
+	{
+		std::ostringstream os;
+		auto f = ext::fast_ostream_iterator<double>{os, ";"};
+		*f++ = 0.5;
+		*f++ = -1e300;
+		*f++ = 0.1;
+		CHECK(os.str() == "0.5;-1e+300;0.1;");
+	}
+	{
+		std::wostringstream os;
+		auto f = ext::fast_ostream_iterator<long long, wchar_t>{os};
+		*f = -1234567890123LL;
+		CHECK(os.str() == L"-1234567890123");
+	}
+#endif
+
 	return ::test_result();
 }
@@ -93,6 +93,9 @@ int main()
 	uninitialized_fill_test(0);
 	uninitialized_fill_test(0.0);
 	uninitialized_fill_test('a');
+	uninitialized_fill_test(-1LL);
+	uninitialized_fill_test(0x01020304);
+	uninitialized_fill_test(1.5);
 	uninitialized_fill_test(std::vector<int>{});
 	uninitialized_fill_test(std::vector<int>(1 << 10, 0));
 	uninitialized_fill_test(Book{});
@@ -0,0 +1,150 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/memory/uninitialized_relocate.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/view/repeat.hpp>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+#include "common.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	// Trivially relocatable by declaration, not by the type traits.
+	struct handle {
+		static int live;
+		int* p;
+
+		explicit handle(int i) : p{new int{i}} { ++live; }
+		handle(handle&& that) noexcept : p{ranges::exchange(that.p, nullptr)} { ++live; }
+		~handle() { delete p; --live; }
+	};
+	int handle::live;
+}
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template <>
+		constexpr bool enable_trivially_relocatable<handle> = true;
+	}
+} STL2_CLOSE_NAMESPACE
+
+namespace {
+	static_assert(ranges::ext::TriviallyRelocatable<int>);
+	static_assert(ranges::ext::TriviallyRelocatable<handle>);
+	static_assert(!ranges::ext::TriviallyRelocatable<std::string>);
+
+	void test_trivial()
+	{
+		int const control[] = {0, 1, 2, 3, 4, 5, 6, 7};
+		int a[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+		auto b = make_buffer<int>(8);
+		auto r = ranges::ext::uninitialized_relocate(a, b.begin());
+		CHECK(r.in() == a + 8);
+		CHECK(r.out() == b.end());
+		CHECK(ranges::equal(control, b));
+
+		auto c = make_buffer<int>(8);
+		auto s = ranges::ext::uninitialized_relocate_n(b.begin(), 5, c.cbegin());
+		CHECK(s.in() == b.begin() + 5);
+		CHECK(s.out() == c.cbegin() + 5);
+		CHECK(ranges::equal(control, control + 5, c.begin(), c.begin() + 5));
+
+		auto t = ranges::ext::uninitialized_relocate(a, a, c.begin());
+		CHECK(t.in() == a);
+		CHECK(t.out() == c.begin());
+	}
+
+	void test_declared()
+	{
+		{
+			auto a = make_buffer<handle>(4);
+			for (int i = 0; i < 4; ++i) {
+				::new (static_cast<void*>(a.data() + i)) handle{i};
+			}
+			auto b = make_buffer<handle>(4);
+			ranges::ext::uninitialized_relocate(a, b.begin());
+			// No moves or destructions: just the bytes.
+			CHECK(handle::live == 4);
+			for (int i = 0; i < 4; ++i) {
+				CHECK(*b.data()[i].p == i);
+			}
+			ranges::destroy(b);
+		}
+		CHECK(handle::live == 0);
+	}
+
+	void test_generic()
+	{
+		std::vector<std::string> v = {"a", "bb", std::string(100, 'c')};
+		auto const control = v;
+		auto b = make_buffer<std::string>(3);
+		auto r = ranges::ext::uninitialized_relocate(
+			forward_iterator<std::string*>(v.data()),
+			sentinel<std::string*>(v.data() + 3), b.begin());
+		CHECK(r.in() == forward_iterator<std::string*>(v.data() + 3));
+		CHECK(r.out() == b.end());
+		CHECK(ranges::equal(control, b));
+		// The sources were destroyed; give the vector objects to destroy.
+		ranges::ext::uninitialized_relocate(b, v.data());
+		CHECK(ranges::equal(control, v));
+	}
+
+	struct S {
+		static constexpr int throw_after = 5;
+		static int count;
+		static int live;
+
+		S() { ++live; }
+		S(S&&) {
+			if (++count >= throw_after) {
+				throw exception{};
+			}
+			++live;
+		}
+		~S() { --live; }
+
+		struct exception {};
+	};
+	constexpr int S::throw_after;
+	int S::count;
+	int S::live;
+
+	void throw_test()
+	{
+		constexpr int n = 2 * S::throw_after;
+		auto a = make_buffer<S>(n);
+		for (int i = 0; i < n; ++i) {
+			::new (static_cast<void*>(a.data() + i)) S;
+		}
+		auto b = make_buffer<S>(n);
+		try {
+			ranges::ext::uninitialized_relocate(a, b.begin());
+			CHECK(false);
+		} catch (S::exception&) {
+			CHECK(S::count == S::throw_after);
+		}
+		// Both ranges are gone.
+		CHECK(S::live == 0);
+	}
+}
+
+int main()
+{
+	test_trivial();
+	test_declared();
+	test_generic();
+	throw_test();
+
+	return ::test_result();
+}
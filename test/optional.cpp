@@ -119,6 +119,68 @@ void test_cross_type_swap() {
 	CHECK(X::count == 2);
 }
 
+enum class level : unsigned char { low, high, unset = 0xff };
+
+template <>
+struct ranges::ext::niche_traits<level>
+: ranges::ext::reserved_niche_traits<level, level::unset> {};
+
+void test_niche() {
+	using ranges::ext::niche_bool;
+	using ranges::ext::niche_ptr;
+	static_assert(sizeof(ranges::optional<niche_ptr<unsigned>>) == sizeof(unsigned*));
+	static_assert(sizeof(ranges::optional<const niche_ptr<char>>) == sizeof(char*));
+	static_assert(sizeof(ranges::optional<ranges::detail::raw_ptr<int>>) == sizeof(int*));
+	static_assert(sizeof(ranges::optional<niche_bool>) == sizeof(bool));
+	static_assert(sizeof(ranges::optional<level>) == sizeof(level));
+	static_assert(sizeof(ranges::optional<int>) > sizeof(int));
+	static_assert(sizeof(ranges::optional<int*>) > sizeof(int*));
+
+	// Plain pointers and bools keep their engaged flag, and stay usable in
+	// constant expressions.
+	{
+		constexpr ranges::optional<int*> o;
+		static_assert(!o.has_value());
+		constexpr ranges::optional<bool> b = ranges::nullopt;
+		static_assert(!b.has_value());
+		constexpr ranges::optional<bool> t{false};
+		static_assert(t.has_value() && !*t);
+	}
+
+	unsigned i = 42;
+	ranges::optional<niche_ptr<unsigned>> o;
+	CHECK(!o);
+	o = &i;
+	CHECK(o.has_value());
+	CHECK(**o == 42u);
+	o = nullptr;
+	CHECK(o.has_value());
+	CHECK(*o == static_cast<unsigned*>(nullptr));
+	auto p = o;
+	CHECK(p.has_value());
+	o.reset();
+	CHECK(!o);
+	CHECK(p != o);
+	ranges::swap(o, p);
+	CHECK(o.has_value());
+	CHECK(!p);
+
+	ranges::optional<niche_bool> b{false};
+	CHECK(b.has_value());
+	CHECK(!*b);
+	b = ranges::nullopt;
+	CHECK(!b);
+	b = true;
+	CHECK(*b);
+
+	ranges::optional<level> l{level::low};
+	CHECK(l.has_value());
+	CHECK(*l == level::low);
+	l.reset();
+	CHECK(!l);
+	CHECK(l.value_or(level::high) == level::high);
+}
+
 int main() {
 	{
 		// Ensure that {} cannot convert to nullopt_t
@@ -275,6 +337,7 @@ int main() {
 	}
 
 	test_cross_type_swap();
+	test_niche();
 
 	return test_result();
 }
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <initializer_list>
+#include <vector>
 #include "./test_iterators.hpp"
 #include "./simple_test.hpp"
 
@@ -115,4 +116,29 @@ test_range_algo_2<Algo, RvalueOK1, RvalueOK2> make_testable_2(Algo algo)
 	return test_range_algo_2<Algo, RvalueOK1, RvalueOK2>{algo};
 }
 
+// Lengths for testing the vectorized algorithms: empty, shorter than a
+// vector, whole vectors, and whole vectors with a tail.
+constexpr int vector_test_sizes[] = {0, 1, 7, 8, 9, 31, 64, 100, 1001};
+
+// n values in [-6, 6], scattered, as Ts.
+template <typename T>
+std::vector<T> scattered_values(int n)
+{
+	std::vector<T> v(n);
+	for (int i = 0; i < n; ++i) {
+		v[i] = static_cast<T>((i * 7919) % 13 - 6);
+	}
+	return v;
+}
+
+// Calls check(scattered_values<T>(n)) for each of the vector_test_sizes
+// and each T in Ts.
+template <typename... Ts, typename Check>
+void test_vectorized(Check check)
+{
+	for (int n : vector_test_sizes) {
+		(void)std::initializer_list<int>{(check(scattered_values<Ts>(n)), 0)...};
+	}
+}
+
 #endif
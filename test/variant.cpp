@@ -926,6 +926,85 @@ void test_visit() {
 	}
 }
 
+template <std::size_t... Is>
+variant<meta::size_t<Is>...> make_indexed(std::index_sequence<Is...>);
+template <std::size_t N>
+using indexed_variant = decltype(make_indexed(std::make_index_sequence<N>{}));
+
+template <std::size_t N, std::size_t... Is>
+void test_visit_dispatch(std::index_sequence<Is...>) {
+	using V = indexed_variant<N>;
+	auto value = [](auto x) { return std::size_t{x}; };
+	auto index = [](auto i, auto) { return std::size_t{i}; };
+	auto sum = [](auto x, auto y) { return std::size_t{x} + y; };
+	((CHECK(visit(value, V{__stl2::in_place_index<Is>}) == Is),
+		CHECK(visit_with_index(index, V{__stl2::in_place_index<Is>}) == Is),
+		CHECK(visit<1>(value, V{__stl2::in_place_index<Is>}) == Is),
+		CHECK(visit<N * N + 1>(value, V{__stl2::in_place_index<Is>}) == Is),
+		CHECK(visit<1>(sum, V{__stl2::in_place_index<Is>},
+			V{__stl2::in_place_index<N - 1 - Is>}) == N - 1),
+		CHECK(visit<N * N + 1>(sum, V{__stl2::in_place_index<Is>},
+			V{__stl2::in_place_index<N - 1 - Is>}) == N - 1)), ...);
+}
+
+void test_visit_dispatch() {
+	// switch
+	test_visit_dispatch<12>(std::make_index_sequence<12>{});
+	test_visit_dispatch<32>(std::make_index_sequence<32>{});
+	// comparisons or table
+	test_visit_dispatch<33>(std::make_index_sequence<33>{});
+	{
+		using V = variant<void, int, void, double, void>;
+		auto f = [](auto i, auto x) { return i() + static_cast<int>(x); };
+		CHECK(visit_with_index(f, V{42}) == 43);
+		CHECK(visit_with_index(f, V{1.5}) == 4);
+		static_assert(visit_with_index(f, V{42}) == 43);
+		static_assert(visit([](auto x) { return std::size_t{x}; },
+			indexed_variant<12>{__stl2::in_place_index<7>}) == 7u);
+	}
+}
+
+void test_niche() {
+	using ext::niche_bool;
+	using ext::niche_ptr;
+	using V = variant<niche_ptr<unsigned>, monostate>;
+	static_assert(sizeof(V) == sizeof(unsigned*));
+	static_assert(std::is_trivially_copyable<V>());
+	static_assert(sizeof(variant<monostate, niche_bool, void, monostate>) == sizeof(bool));
+	static_assert(sizeof(variant<niche_ptr<int>, niche_ptr<int>>) > sizeof(int*));
+	static_assert(sizeof(variant<int*, monostate>) > sizeof(int*));
+
+	// Plain pointers and bools keep a separate index, and stay usable in
+	// constant expressions.
+	{
+		constexpr variant<int*, monostate> v;
+		static_assert(v.index() == 0);
+		constexpr variant<int*, monostate> w{monostate{}};
+		static_assert(w.index() == 1);
+		constexpr variant<monostate, bool> b{true};
+		static_assert(b.index() == 1 && get<1>(b));
+	}
+
+	unsigned i = 42;
+	V v;
+	CHECK(v.index() == 0u);
+	CHECK(get<0>(v) == static_cast<unsigned*>(nullptr));
+	v = monostate{};
+	CHECK(v.index() == 1u);
+	v = &i;
+	CHECK(v.index() == 0u);
+	CHECK(*get<0>(v) == 42u);
+	V w = v;
+	CHECK(w == v);
+	w.emplace<monostate>();
+	CHECK(w.index() == 1u);
+	CHECK(w != v);
+	CHECK(v < w);
+	swap(v, w);
+	CHECK(v.index() == 1u);
+	CHECK(get<0>(w) == &i);
+}
+
 void test_tagged() {
 	using V = tagged_variant<tag::in(int), tag::out(double)>;
 	static_assert(std::is_trivially_destructible<V>());
@@ -1606,6 +1685,8 @@ int main() {
 
 	test_void();
 	test_visit();
+	test_visit_dispatch();
+	test_niche();
 	test_tagged();
 	test_pointer_get();
 	test_emplace();
@@ -0,0 +1,118 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/mapped_file.hpp>
+#include <stl2/algorithm.hpp>
+#include <stl2/detail/span.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+#if STL2_HAS_MMAP
+namespace {
+	// A temporary file holding the bytes of [data, data + n).
+	struct temp_file {
+		std::string path_ = "/tmp/stl2_mapped_file_XXXXXX";
+
+		temp_file(const void* data, std::size_t n) {
+			int const fd = ::mkstemp(&path_[0]);
+			CHECK(fd >= 0);
+			CHECK(::write(fd, data, n) == static_cast<ssize_t>(n));
+			::close(fd);
+		}
+		temp_file(const temp_file&) = delete;
+		temp_file& operator=(const temp_file&) = delete;
+		~temp_file() {
+			::unlink(path_.c_str());
+		}
+	};
+}
+
+int main() {
+	using R = stl2::ext::mapped_file_view<const std::int32_t>;
+	using W = stl2::ext::mapped_file_view<std::int32_t>;
+	static_assert(stl2::models::View<R>);
+	static_assert(stl2::models::View<W>);
+	static_assert(stl2::models::SizedRange<R>);
+	static_assert(stl2::models::RandomAccessRange<R>);
+	static_assert(stl2::models::ContiguousView<R>);
+	static_assert(stl2::models::ContiguousView<W>);
+	static_assert(stl2::models::Same<stl2::iterator_t<R>, const std::int32_t*>);
+	static_assert(stl2::models::Same<stl2::iterator_t<W>, std::int32_t*>);
+
+	std::vector<std::int32_t> v(5000);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<std::int32_t>(i * 7 % 5000);
+	}
+	// Two bytes more than the ints, which the views leave out.
+	std::vector<char> bytes(v.size() * sizeof(std::int32_t) + 2, 'x');
+	std::memcpy(bytes.data(), v.data(), v.size() * sizeof(std::int32_t));
+	temp_file file{bytes.data(), bytes.size()};
+
+	{
+		auto r = R{file.path_, stl2::ext::map_advice::sequential};
+		CHECK(r.size() == 5000);
+		CHECK(!r.empty());
+		CHECK(r.data() == r.begin());
+		::check_equal(r, v);
+		CHECK(*stl2::find(r, 35) == 35);
+		CHECK(stl2::count(r, 0) == 1);
+		CHECK(stl2::ext::make_span(r).size() == 5000);
+		CHECK(r.advise(stl2::ext::map_advice::random));
+		r.use_huge_pages();
+
+		// Copies share the mapping.
+		auto r2 = r;
+		r = R{};
+		CHECK(r.empty());
+		CHECK(r2.size() == 5000);
+		CHECK(r2.begin()[4999] == v[4999]);
+	}
+
+	{
+		auto w = W{file.path_};
+		stl2::sort(w);
+		CHECK(stl2::is_sorted(w));
+		w.sync();
+	}
+	{
+		auto const r = R{file.path_};
+		stl2::sort(v);
+		::check_equal(r, v);
+	}
+
+	{
+		temp_file empty{nullptr, 0};
+		auto r = R{empty.path_};
+		CHECK(r.empty());
+		CHECK(r.begin() == r.end());
+	}
+
+	{
+		bool threw = false;
+		try {
+			R{"/nonexistent/stl2_mapped_file"};
+		} catch (const std::system_error& e) {
+			threw = true;
+			CHECK(e.code() == std::errc::no_such_file_or_directory);
+		}
+		CHECK(threw);
+	}
+
+	return ::test_result();
+}
+#else
+int main() {}
+#endif